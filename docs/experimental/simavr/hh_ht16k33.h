@@ -0,0 +1,91 @@
+// HT16K33 model for simavr's TWI bus: the 4-digit alphanumeric backpack at
+// 0x70. It acks its address and every byte, keeps the 16-byte display RAM,
+// the display-on / blink setup and the dimming level, and reports each
+// complete RAM write (one writeDisplay()) as a frame of four 16-bit
+// segment words, digit 0 first.
+#pragma once
+
+#include <simavr/sim_irq.h>
+#include <simavr/avr_twi.h>
+
+#define HT_ADDR 0x70
+
+// Adafruit_AlphaNum4 font for the characters the probes look for
+#define HT_SEG_DASH  0x00C0   // '-'
+#define HT_SEG_BLANK 0x0000   // ' '
+
+typedef struct Ht16k33 Ht16k33;
+typedef void (*HtFrameFn)(Ht16k33* ht, uint64_t cycle, void* param);
+
+struct Ht16k33 {
+  avr_t*     avr;
+  avr_irq_t* irq;
+  uint8_t    selected;
+  uint8_t    first;       // next byte is a command
+  uint8_t    ptr;         // display RAM address
+  uint8_t    wrote_ram;
+  uint8_t    ram[16];
+  uint8_t    on, blink, dim;
+  uint16_t   word[4];     // last frame
+  uint32_t   frames, transfers;
+  HtFrameFn  on_frame;
+  void*      param;
+};
+
+static void ht_ack(Ht16k33* p) {
+  avr_raise_irq(p->irq + TWI_IRQ_INPUT, avr_twi_irq_msg(TWI_COND_ACK, HT_ADDR << 1, 1));
+}
+
+static void ht_byte(Ht16k33* p, uint8_t b) {
+  if (!p->first) { p->ram[p->ptr++ & 15] = b; p->wrote_ram = 1; return; }
+  p->first = 0;
+  if      ((b & 0xF0) == 0x00) p->ptr = b & 0x0F;                      // RAM pointer, data follows
+  else if ((b & 0xF0) == 0x80) { p->on = b & 1; p->blink = (b >> 1) & 3; }
+  else if ((b & 0xF0) == 0xE0) p->dim = b & 0x0F;
+}
+
+static void ht_in(struct avr_irq_t* irq, uint32_t value, void* param) {
+  (void)irq;
+  Ht16k33* p = (Ht16k33*)param;
+  avr_twi_msg_irq_t v;
+  v.u.v = value;
+
+  if (v.u.twi.msg & TWI_COND_STOP) {
+    if (p->selected && p->wrote_ram) {
+      for (int i = 0; i < 4; i++) p->word[i] = (uint16_t)(p->ram[2 * i] | (p->ram[2 * i + 1] << 8));
+      p->frames++;
+      if (p->on_frame) p->on_frame(p, p->avr->cycle, p->param);
+    }
+    p->selected = 0;
+  }
+  if (v.u.twi.msg & TWI_COND_START) {
+    p->selected = 0;
+    p->first = 1;
+    p->wrote_ram = 0;
+  }
+  if (v.u.twi.msg & TWI_COND_ADDR) {
+    p->selected = (v.u.twi.addr >> 1) == HT_ADDR && !(v.u.twi.addr & 1);
+    if (p->selected) { p->transfers++; ht_ack(p); }
+  }
+  if (p->selected && (v.u.twi.msg & TWI_COND_WRITE)) {
+    ht_ack(p);
+    ht_byte(p, v.u.twi.data);
+  }
+}
+
+static void ht_attach(Ht16k33* p, avr_t* avr, HtFrameFn on_frame, void* param) {
+  static const char* names[2] = { "8>ht16k33.in", "8<ht16k33.out" };
+  memset(p, 0, sizeof *p);
+  p->avr = avr;
+  p->on_frame = on_frame;
+  p->param = param;
+  p->irq = avr_alloc_irq(&avr->irq_pool, 0, 2, names);
+  avr_irq_register_notify(p->irq + TWI_IRQ_OUTPUT, ht_in, p);
+  avr_connect_irq(p->irq + TWI_IRQ_INPUT, avr_io_getirq(avr, AVR_IOCTL_TWI_GETIRQ(0), TWI_IRQ_INPUT));
+  avr_connect_irq(avr_io_getirq(avr, AVR_IOCTL_TWI_GETIRQ(0), TWI_IRQ_OUTPUT), p->irq + TWI_IRQ_OUTPUT);
+}
+
+// Frame shows the same segment word on all four digits
+static int ht_all(const Ht16k33* p, uint16_t seg) {
+  return p->word[0] == seg && p->word[1] == seg && p->word[2] == seg && p->word[3] == seg;
+}
@@ -0,0 +1,134 @@
+// Haunted Hearse simavr helpers shared by hh_simbench.c and hh_simlat.c:
+// firmware loading, beam pins, the console UART and the trace format.
+#pragma once
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <simavr/sim_avr.h>
+#include <simavr/sim_elf.h>
+#include <simavr/sim_io.h>
+#include <simavr/avr_ioport.h>
+#include <simavr/avr_uart.h>
+
+#define CPU_HZ      16000000UL
+#define CYC_PER_MS  (CPU_HZ / 1000)
+
+// Beam 0..6 -> port and bit, from pins.hpp via the Mega pin map
+static const struct { char port; uint8_t bit; } SIM_BEAM_PIN[7] = {
+  { 'E', 4 },   // B0 D2
+  { 'E', 5 },   // B1 D3
+  { 'G', 5 },   // B2 D4
+  { 'E', 3 },   // B3 D5
+  { 'H', 4 },   // B4 D7
+  { 'H', 6 },   // B5 D9
+  { 'C', 7 },   // B6 D30 reed
+};
+
+static avr_irq_t* g_sim_beam[7];
+static int        g_sim_echo = 0;   // console output to stderr
+
+static void sim_uart_out(struct avr_irq_t* irq, uint32_t value, void* param) {
+  (void)irq; (void)param;
+  if (g_sim_echo) fputc((int)value, stderr);
+}
+
+// Load the ELF into an atmega2560 at 16 MHz with beams clear and the reed open
+static avr_t* sim_open(const char* elf) {
+  elf_firmware_t fw;
+  memset(&fw, 0, sizeof fw);
+  if (elf_read_firmware(elf, &fw)) { fprintf(stderr, "cannot read %s\n", elf); exit(1); }
+  avr_t* avr = avr_make_mcu_by_name("atmega2560");
+  if (!avr) { fprintf(stderr, "simavr has no atmega2560 core\n"); exit(1); }
+  avr_init(avr);
+  avr->frequency = CPU_HZ;
+  avr_load_firmware(avr, &fw);
+
+  uint32_t flags = 0;                  // console output to --echo, not simavr's stdout
+  avr_ioctl(avr, AVR_IOCTL_UART_GET_FLAGS('0'), &flags);
+  flags &= ~AVR_UART_FLAG_STDIO;
+  avr_ioctl(avr, AVR_IOCTL_UART_SET_FLAGS('0'), &flags);
+  avr_irq_register_notify(avr_io_getirq(avr, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_OUTPUT), sim_uart_out, NULL);
+
+  for (int b = 0; b < 7; b++) {
+    g_sim_beam[b] = avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ(SIM_BEAM_PIN[b].port), SIM_BEAM_PIN[b].bit);
+    avr_raise_irq(g_sim_beam[b], 1);   // pull-ups: clear / open
+  }
+  return avr;
+}
+
+// Beam level as read, 0 = broken / reed closed
+static void sim_beam(uint8_t beam, uint8_t level) {
+  if (beam < 7) avr_raise_irq(g_sim_beam[beam], level);
+}
+
+// One console line into UART0
+static void sim_send_line(avr_t* avr, const char* s) {
+  avr_irq_t* in = avr_io_getirq(avr, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_INPUT);
+  for (; *s; s++) avr_raise_irq(in, (uint8_t)*s);
+  avr_raise_irq(in, '\n');
+}
+
+// ---------- Trace ----------
+// One line per event, the hh_replay.py edge format plus console lines:
+//   t_ms,beam,level      beam 0..6, level as read (0 = broken / reed closed)
+//   t_ms,>,TEXT          console line sent on UART0 (e.g. 1500,>,STATE 16)
+// Lines starting with # are ignored.
+typedef struct {
+  uint32_t t_ms;
+  int8_t   beam;     // -1 = console line
+  uint8_t  level;
+  char     text[97];
+} SimEvent;
+
+typedef struct {
+  SimEvent* ev;
+  size_t    n, cap, next;
+} SimTrace;
+
+static void sim_trace_add(SimTrace* t, const SimEvent* e) {
+  if (t->n == t->cap) {
+    t->cap = t->cap ? t->cap * 2 : 256;
+    t->ev = realloc(t->ev, t->cap * sizeof(SimEvent));
+    if (!t->ev) { perror("realloc"); exit(1); }
+  }
+  t->ev[t->n++] = *e;
+}
+
+static void sim_trace_load(SimTrace* t, const char* path) {
+  FILE* f = fopen(path, "r");
+  if (!f) { perror(path); exit(1); }
+  char line[160];
+  while (fgets(line, sizeof line, f)) {
+    if (line[0] == '#' || line[0] == '\n') continue;
+    SimEvent e;
+    memset(&e, 0, sizeof e);
+    char* p = strchr(line, ',');
+    if (!p) continue;
+    e.t_ms = (uint32_t)strtoul(line, NULL, 10);
+    if (p[1] == '>') {
+      e.beam = -1;
+      snprintf(e.text, sizeof e.text, "%s", p + 2 + (p[2] == ','));
+      e.text[strcspn(e.text, "\r\n")] = '\0';
+    } else {
+      e.beam = (int8_t)atoi(p + 1);
+      char* q = strchr(p + 1, ',');
+      e.level = q ? (uint8_t)atoi(q + 1) : 1;
+      if (e.beam < 0 || e.beam > 6) continue;
+    }
+    sim_trace_add(t, &e);
+  }
+  fclose(f);
+}
+
+// Apply the events that are due at the current simulated time
+static void sim_trace_step(avr_t* avr, SimTrace* t) {
+  const uint32_t now_ms = (uint32_t)(avr->cycle / CYC_PER_MS);
+  while (t->next < t->n && t->ev[t->next].t_ms <= now_ms) {
+    const SimEvent* e = &t->ev[t->next++];
+    if (e->beam < 0) sim_send_line(avr, e->text);
+    else             sim_beam((uint8_t)e->beam, e->level);
+  }
+}
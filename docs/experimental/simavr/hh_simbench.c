@@ -0,0 +1,136 @@
+// Haunted Hearse cycle benchmark
+// Runs the real mega2560 firmware image in simavr, drives the beam pins from
+// a trace and times every loop() pass and stage in AVR cycles, from the
+// GPIOR0 markers a -DHH_PROF_MARKERS build writes (include/prof.hpp).
+// The report is JSON, one object, for diffing between firmware revisions.
+//
+// Build (simavr and libelf installed):
+//   cc -O2 -o hh_simbench docs/experimental/simavr/hh_simbench.c -lsimavr -lelf
+// Run:
+//   PLATFORMIO_BUILD_FLAGS=-DHH_PROF_MARKERS pio run
+//   ./hh_simbench .pio/build/mega2560/firmware.elf trace.csv --ms 20000 > bench.json
+//
+// Trace: the hh_replay.py edge format plus console lines, see hh_sim.h.
+//
+// UNVERIFIED: written without simavr at hand. Neither this harness nor the
+// marker image has been compiled or run, so check the first report by hand
+// (marker count per pass, stage totals against the pass total) before trusting it.
+
+#include "hh_sim.h"
+#include "hh_ht16k33.h"
+
+#define GPIOR0_ADDR 0x3E          // data-space address (I/O 0x1E)
+
+// LoopStage, recovery.hpp
+static const char* STAGES[] = { "-", "CONSOLE", "INPUTS", "PILINK", "SCENE", "SETTINGS",
+                                "BOOT", "TEL", "OUT", "IDLE" };
+#define N_STAGES   10
+#define ST_CONSOLE 1
+#define ST_IDLE    9
+
+// ProfRegion, prof.hpp
+static const char* REGIONS[] = { "-", "I2C", "FLUSH", "SVM" };
+#define N_REGIONS 4
+
+// ---------- Samples ----------
+typedef struct {
+  uint32_t* v;
+  size_t n, cap;
+} Series;
+
+static void push(Series* s, uint32_t v) {
+  if (s->n == s->cap) {
+    s->cap = s->cap ? s->cap * 2 : 1024;
+    s->v = realloc(s->v, s->cap * sizeof(uint32_t));
+    if (!s->v) { perror("realloc"); exit(1); }
+  }
+  s->v[s->n++] = v;
+}
+
+static int cmp_u32(const void* a, const void* b) {
+  const uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+  return x < y ? -1 : x > y;
+}
+
+static void print_series(const char* name, Series* s, int last) {
+  uint64_t sum = 0;
+  for (size_t i = 0; i < s->n; i++) sum += s->v[i];
+  qsort(s->v, s->n, sizeof(uint32_t), cmp_u32);
+  const uint32_t p50 = s->n ? s->v[s->n / 2] : 0;
+  const uint32_t p99 = s->n ? s->v[(s->n * 99) / 100] : 0;
+  printf("    \"%s\": {\"n\": %zu, \"min\": %u, \"avg\": %llu, \"p50\": %u, \"p99\": %u, \"max\": %u}%s\n",
+         name, s->n, s->n ? s->v[0] : 0, s->n ? (unsigned long long)(sum / s->n) : 0ULL,
+         p50, p99, s->n ? s->v[s->n - 1] : 0, last ? "" : ",");
+}
+
+// ---------- Marker clock ----------
+static Series   g_pass, g_stage[N_STAGES], g_region[N_REGIONS];
+static uint8_t  g_cur = 0;             // stage being timed
+static uint64_t g_t_stage = 0, g_t_pass = 0;
+static uint64_t g_t_region[N_REGIONS];
+static uint64_t g_markers = 0;
+
+static void on_marker(struct avr_t* avr, avr_io_addr_t addr, uint8_t v, void* param) {
+  (void)param;
+  avr->data[addr] = v;
+  const uint64_t now = avr->cycle;
+  g_markers++;
+
+  if (v & 0x40) {                      // region begin / end
+    const uint8_t r = v & 0x3F;
+    if (r >= N_REGIONS) return;
+    if (!(v & 0x80)) g_t_region[r] = now;
+    else if (g_t_region[r]) { push(&g_region[r], (uint32_t)(now - g_t_region[r])); g_t_region[r] = 0; }
+    return;
+  }
+  if (v >= N_STAGES) return;
+  if (g_cur && g_t_stage && g_cur != ST_IDLE) push(&g_stage[g_cur], (uint32_t)(now - g_t_stage));
+  if (v == ST_CONSOLE) g_t_pass = now;
+  if (v == ST_IDLE && g_t_pass) { push(&g_pass, (uint32_t)(now - g_t_pass)); g_t_pass = 0; }
+  g_cur = v;
+  g_t_stage = now;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    fprintf(stderr, "usage: %s firmware.elf trace.csv [--ms N] [--echo]\n", argv[0]);
+    return 2;
+  }
+  uint32_t run_ms = 0;
+  for (int i = 3; i < argc; i++) {
+    if (!strcmp(argv[i], "--ms") && i + 1 < argc) run_ms = (uint32_t)strtoul(argv[++i], NULL, 10);
+    else if (!strcmp(argv[i], "--echo")) g_sim_echo = 1;
+  }
+  SimTrace trace;
+  memset(&trace, 0, sizeof trace);
+  sim_trace_load(&trace, argv[2]);
+  if (!run_ms) run_ms = (trace.n ? trace.ev[trace.n - 1].t_ms : 0) + 5000;
+
+  avr_t* avr = sim_open(argv[1]);
+  avr_register_io_write(avr, GPIOR0_ADDR, on_marker, NULL);
+  static Ht16k33 ht;                   // acks the display so I2C timing is the real transfer
+  ht_attach(&ht, avr, NULL, NULL);
+
+  const uint64_t end = (uint64_t)run_ms * CYC_PER_MS;
+  int state = cpu_Running;
+  while (avr->cycle < end && state != cpu_Done && state != cpu_Crashed) {
+    sim_trace_step(avr, &trace);
+    state = avr_run(avr);
+  }
+
+  printf("{\n  \"firmware\": \"%s\",\n  \"trace\": \"%s\",\n", argv[1], argv[2]);
+  printf("  \"cpu_hz\": %lu,\n  \"sim_ms\": %llu,\n  \"markers\": %llu,\n  \"state\": \"%s\",\n",
+         CPU_HZ, (unsigned long long)(avr->cycle / CYC_PER_MS), (unsigned long long)g_markers,
+         state == cpu_Crashed ? "crashed" : "ok");
+  printf("  \"display_frames\": %u,\n", ht.frames);
+  printf("  \"unit\": \"cycles\",\n  \"pass\": {\n");
+  print_series("loop", &g_pass, 1);
+  printf("  },\n  \"stages\": {\n");
+  for (int i = 1; i < ST_IDLE; i++) print_series(STAGES[i], &g_stage[i], i == ST_IDLE - 1);
+  printf("  },\n  \"regions\": {\n");
+  for (int i = 1; i < N_REGIONS; i++) print_series(REGIONS[i], &g_region[i], i == N_REGIONS - 1);
+  printf("  }\n}\n");
+
+  if (!g_markers) fprintf(stderr, "no markers seen: build with -DHH_PROF_MARKERS (PLATFORMIO_BUILD_FLAGS=-DHH_PROF_MARKERS pio run)\n");
+  return state == cpu_Crashed ? 1 : 0;
+}
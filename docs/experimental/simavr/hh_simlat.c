@@ -0,0 +1,174 @@
+// Haunted Hearse end-to-end latency check
+// Runs the real mega2560 firmware image in simavr with an HT16K33 model on
+// the TWI bus, breaks beams on schedule and times, in CPU cycles, from the
+// beam edge on the pin to what the guests and the Pi see:
+//   display   B0 (D2) edge -> first "----" frame at the backpack
+//   magnet    B0 (D2) edge -> D6 HIGH
+//   pi_show   B1 (D3) edge -> D27 rising (SHOW opto line, fired by the intro beam)
+// Each is checked against a budget; the exit code is the number of probes
+// over budget or never seen, so a blocking delay or an extra I2C transfer
+// before the first frame fails the run.
+//
+// The debounce settings are sent over the console before the first beam,
+// and each budget is the time a break takes to settle under them plus a
+// fixed slack. Settle time is the SDEB ceiling (the adaptive window never
+// exceeds it), or the SPULSE minimum pulse with --instant. The settings
+// assumed are printed with the results.
+//
+// UNVERIFIED: written without simavr at hand; it has not been built or run.
+//
+// Build (simavr and libelf installed):
+//   cc -O2 -o hh_simlat docs/experimental/simavr/hh_simlat.c -lsimavr -lelf
+// Run:
+//   pio run
+//   ./hh_simlat .pio/build/mega2560/firmware.elf [--debounce 30] [--debounce-min 3]
+//               [--instant] [--pulse 1000] [--budget display=40] [--json] [--echo]
+
+#include "hh_sim.h"
+#include "hh_ht16k33.h"
+
+#define SET_MS     1000    // settings sent on the console, one line per 100 ms
+#define BOOT_MS    3000    // deferred boot (display, Pi link) done well before this
+#define HOLD_MS    300     // beam broken this long, past the debounce window
+#define GAP_MS     12000   // between probe groups
+
+enum { K_DISPLAY, K_PIN };
+
+typedef struct {
+  const char* name;
+  uint8_t     beam;
+  uint8_t     kind;
+  char        port;        // K_PIN
+  uint8_t     bit;
+  uint32_t    slack_us;    // beyond the settle time: a loop pass or two, plus the frame for the display
+  uint32_t    budget_us;   // settle + slack, unless set with --budget
+  // run state
+  uint64_t    t_edge;      // cycle of the beam edge, 0 = not yet
+  uint64_t    t_seen;      // cycle of the first match, 0 = not yet
+} Probe;
+
+static Probe g_probe[] = {
+  { "display", 0, K_DISPLAY, 0,   0, 10000, 0, 0, 0 },
+  { "magnet",  0, K_PIN,     'H', 3,  5000, 0, 0, 0 },   // D6
+  { "pi_show", 1, K_PIN,     'A', 5,  5000, 0, 0, 0 },   // D27
+};
+#define N_PROBES (sizeof g_probe / sizeof g_probe[0])
+
+static void on_frame(Ht16k33* ht, uint64_t cycle, void* param) {
+  (void)param;
+  for (size_t i = 0; i < N_PROBES; i++) {
+    Probe* p = &g_probe[i];
+    if (p->kind == K_DISPLAY && p->t_edge && !p->t_seen && ht_all(ht, HT_SEG_DASH)) p->t_seen = cycle;
+  }
+}
+
+static avr_t* g_avr;
+
+static void on_pin(struct avr_irq_t* irq, uint32_t value, void* param) {
+  (void)irq;
+  Probe* p = (Probe*)param;
+  if (value && p->t_edge && !p->t_seen) p->t_seen = g_avr->cycle;
+}
+
+static void break_beam(uint8_t beam) {
+  sim_beam(beam, 0);
+  for (size_t i = 0; i < N_PROBES; i++)
+    if (g_probe[i].beam == beam && !g_probe[i].t_edge) g_probe[i].t_edge = g_avr->cycle;
+}
+
+static int set_budget(const char* arg) {
+  const char* eq = strchr(arg, '=');
+  if (!eq) return 0;
+  for (size_t i = 0; i < N_PROBES; i++) {
+    if (strlen(g_probe[i].name) == (size_t)(eq - arg) && !strncmp(g_probe[i].name, arg, (size_t)(eq - arg))) {
+      g_probe[i].budget_us = (uint32_t)(strtod(eq + 1, NULL) * 1000.0);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s firmware.elf [--debounce ms] [--debounce-min ms] [--instant] [--pulse us]\n"
+                    "       [--budget name=ms]... [--json] [--echo]\n", argv[0]);
+    return 2;
+  }
+  int json = 0, instant = 0;
+  unsigned deb_ms = 30, deb_min_ms = 3, pulse_us = 1000;   // firmware defaults
+  for (int i = 2; i < argc; i++) {
+    if (!strcmp(argv[i], "--budget") && i + 1 < argc) {
+      if (!set_budget(argv[++i])) { fprintf(stderr, "unknown budget %s\n", argv[i]); return 2; }
+    }
+    else if (!strcmp(argv[i], "--debounce") && i + 1 < argc)     deb_ms = (unsigned)atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--debounce-min") && i + 1 < argc) deb_min_ms = (unsigned)atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--pulse") && i + 1 < argc)        pulse_us = (unsigned)atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--instant")) instant = 1;
+    else if (!strcmp(argv[i], "--json")) json = 1;
+    else if (!strcmp(argv[i], "--echo")) g_sim_echo = 1;
+  }
+
+  // Sent before the first beam, so the run does not depend on what the EEPROM held
+  char settings[4][32];
+  snprintf(settings[0], sizeof settings[0], "SDEB %u", deb_ms);
+  snprintf(settings[1], sizeof settings[1], "SDEBMIN %u", deb_min_ms);
+  snprintf(settings[2], sizeof settings[2], "SPULSE %u", pulse_us);
+  snprintf(settings[3], sizeof settings[3], "BINSTANT ALL %s", instant ? "ON" : "OFF");
+  const uint32_t settle_us = instant ? pulse_us : deb_ms * 1000UL;
+  for (size_t i = 0; i < N_PROBES; i++)
+    if (!g_probe[i].budget_us) g_probe[i].budget_us = settle_us + g_probe[i].slack_us;
+
+  g_avr = sim_open(argv[1]);
+  static Ht16k33 ht;
+  ht_attach(&ht, g_avr, on_frame, NULL);
+  for (size_t i = 0; i < N_PROBES; i++) {
+    if (g_probe[i].kind != K_PIN) continue;
+    avr_irq_register_notify(avr_io_getirq(g_avr, AVR_IOCTL_IOPORT_GETIRQ(g_probe[i].port), g_probe[i].bit),
+                            on_pin, &g_probe[i]);
+  }
+
+  // B0 (FrankenPhone) first, then B1 (intro) once its scene and the magnet are long done
+  const uint32_t b0_ms = BOOT_MS, b1_ms = BOOT_MS + GAP_MS;
+  const uint64_t end = (uint64_t)(b1_ms + 1000) * CYC_PER_MS;
+  uint8_t step = 0, sent = 0;
+  int state = cpu_Running;
+  while (g_avr->cycle < end && state != cpu_Done && state != cpu_Crashed) {
+    const uint32_t now_ms = (uint32_t)(g_avr->cycle / CYC_PER_MS);
+    if (sent < 4 && now_ms >= SET_MS + sent * 100u) sim_send_line(g_avr, settings[sent++]);
+    if      (step == 0 && now_ms >= b0_ms)           { break_beam(0); step++; }
+    else if (step == 1 && now_ms >= b0_ms + HOLD_MS) { sim_beam(0, 1); step++; }
+    else if (step == 2 && now_ms >= b1_ms)           { break_beam(1); step++; }
+    else if (step == 3 && now_ms >= b1_ms + HOLD_MS) { sim_beam(1, 1); step++; }
+    state = avr_run(g_avr);
+  }
+
+  int fails = 0;
+  if (json) printf("{\n  \"firmware\": \"%s\",\n  \"unit\": \"us\",\n  \"settings\": {\"debounce_ms\": %u, "
+                  "\"debounce_min_ms\": %u, \"instant\": %s, \"pulse_us\": %u, \"settle_us\": %u},\n  \"probes\": {\n",
+                  argv[1], deb_ms, deb_min_ms, instant ? "true" : "false", pulse_us, settle_us);
+  else      printf("settings: SDEB %u ms, SDEBMIN %u ms, BINSTANT %s, SPULSE %u us -> settle %.2f ms, budget = settle + slack\n",
+                  deb_ms, deb_min_ms, instant ? "on" : "off", pulse_us, settle_us / 1000.0);
+  for (size_t i = 0; i < N_PROBES; i++) {
+    const Probe* p = &g_probe[i];
+    const int seen = p->t_edge && p->t_seen;
+    const uint32_t us = seen ? (uint32_t)((p->t_seen - p->t_edge) / (CPU_HZ / 1000000UL)) : 0;
+    const int ok = seen && us <= p->budget_us;
+    if (!ok) fails++;
+    if (json) {
+      char lat[16] = "null";
+      if (seen) snprintf(lat, sizeof lat, "%u", us);
+      printf("    \"%s\": {\"latency\": %s, \"budget\": %u, \"pass\": %s}%s\n", p->name, lat,
+             p->budget_us, ok ? "true" : "false", i + 1 == N_PROBES ? "" : ",");
+    }
+    else if (seen)
+      printf("%s %-8s B%u  %6.2f ms  (budget %.2f ms)\n", ok ? "PASS" : "FAIL", p->name, p->beam,
+             us / 1000.0, p->budget_us / 1000.0);
+    else
+      printf("FAIL %-8s B%u  never seen  (budget %.2f ms)\n", p->name, p->beam, p->budget_us / 1000.0);
+  }
+  if (json) printf("  },\n  \"frames\": %u,\n  \"transfers\": %u\n}\n", ht.frames, ht.transfers);
+  else      printf("display: %u frames in %u transfers\n", ht.frames, ht.transfers);
+
+  if (state == cpu_Crashed) { fprintf(stderr, "firmware crashed at %llu cycles\n", (unsigned long long)g_avr->cycle); return 1 + fails; }
+  return fails;
+}
@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+# Haunted Hearse event log statistics
+# Decodes a LOG DUMP (src/eventlog.cpp, framing in include/eventlog.hpp) and
+# prints per-night throughput and latency numbers.
+# Requires: pip install pyserial (only when reading from a port)
+#
+# Usage:
+#   python3 hh_log_stats.py /dev/ttyUSB0            send LOG DUMP and decode the reply
+#   python3 hh_log_stats.py /dev/ttyUSB0 --ee       decode the last EEPROM checkpoint
+#   python3 hh_log_stats.py night.bin               decode a saved capture
+#   python3 hh_log_stats.py /dev/ttyUSB0 --save night.bin
+
+import sys, os, time, struct, argparse
+
+EV_TIME, EV_BOOT, EV_TRIP, EV_TRIP_LOCKED, EV_REED, EV_SCENE, EV_PI_ACK, EV_PI_FAIL, EV_MARK, EV_DISPLAY, EV_OUTPUT = range(11)
+EVP_IDLE, EVP_START, EVP_COOLDOWN, EVP_END = range(4)
+
+BEAM_NAMES = ["B0 Franken", "B1 Intro", "B2 Blood", "B3 Graveyard", "B4 Mirror", "B5 Exit"]
+SCENE_NAMES = {1: "FrankenLab", 12: "BloodRoom"}
+PI_TYPES = {1: "PING", 2: "CUE", 3: "START", 4: "STOP"}
+GROUP_BEAM = 1   # B1 starts the show, one trip per group
+
+
+def crc16_modbus(data):
+    c = 0xFFFF
+    for d in data:
+        c ^= d
+        for _ in range(8):
+            c = (c >> 1) ^ 0xA001 if c & 1 else c >> 1
+    return c
+
+
+def parse(blob):
+    """Return (t0_ms, [(t_ms, type, id, arg), ...]) from the first valid HHLOG frame."""
+    at = blob.find(b"HHLOG")
+    if at < 0:
+        raise ValueError("no HHLOG frame found")
+    body = blob[at + 5:]
+    if len(body) < 7:
+        raise ValueError("truncated header")
+    ver, n, t0 = struct.unpack_from("<BHI", body, 0)
+    if ver != 1:
+        raise ValueError(f"unknown log version {ver}")
+    end = 7 + n * 8
+    if len(body) < end + 2:
+        raise ValueError("truncated records")
+    (crc,) = struct.unpack_from("<H", body, end)
+    if crc != crc16_modbus(body[:end]):
+        raise ValueError("CRC mismatch")
+
+    events = []
+    t = t0
+    for k in range(n):
+        dt, typ, eid, arg = struct.unpack_from("<HBBI", body, 7 + k * 8)
+        if typ == EV_TIME:
+            t = arg
+        elif k:
+            t += dt
+        events.append((t, typ, eid, arg))
+    return t0, events
+
+
+def capture(port, baud, ee):
+    try:
+        import serial
+    except ImportError:
+        print("pyserial is required. Install with: pip install pyserial")
+        sys.exit(1)
+    ser = serial.Serial(port, baud, timeout=0.2)
+    time.sleep(2.0)                     # opening the port resets the Mega
+    ser.reset_input_buffer()
+    ser.write(b"LOG DUMP EE\n" if ee else b"LOG DUMP\n")
+    data = bytearray()
+    deadline = time.monotonic() + 5.0
+    while time.monotonic() < deadline:
+        data += ser.read(ser.in_waiting or 1)
+        if b"OK LOG DUMP" in data or b"ERR LOG" in data:
+            break
+    ser.close()
+    if b"ERR LOG" in data:
+        raise ValueError("device has no valid checkpoint")
+    return bytes(data)
+
+
+def fmt_ms(ms):
+    s = ms / 1000.0
+    return f"{s / 60:.1f} min" if s >= 120 else f"{s:.1f} s"
+
+
+def stats(vals):
+    if not vals:
+        return "-"
+    return f"n {len(vals)}  min {min(vals)}  avg {sum(vals) / len(vals):.1f}  max {max(vals)}"
+
+
+def report(t0, events):
+    if not events:
+        print("Log is empty")
+        return
+    t_end = events[-1][0]
+    span_h = max(t_end - t0, 1) / 3600000.0
+    print(f"Window {fmt_ms(t_end - t0)} ({len(events)} records, t0 = {t0} ms)")
+
+    boots = [e for e in events if e[1] == EV_BOOT]
+    for t, _, stage, arg in boots:
+        kind = "warm" if arg & 1 else "cold"
+        print(f"  boot at {t} ms, {kind}, MCUSR 0x{(arg >> 8) & 0xFF:02X}" + (f", stalled in stage {stage}" if stage else ""))
+    marks = [e for e in events if e[1] == EV_MARK]
+    for t, _, mid, _ in marks:
+        print(f"  mark {mid} at {t} ms")
+
+    print("\nBeams            trips  per hour  locked  edge->fire ms (min/avg/max)")
+    for b, name in enumerate(BEAM_NAMES):
+        trips = [e for e in events if e[1] == EV_TRIP and e[2] == b]
+        locked = sum(1 for e in events if e[1] == EV_TRIP_LOCKED and e[2] == b)
+        lat = [e[3] for e in trips]
+        lat_s = f"{min(lat)}/{sum(lat) / len(lat):.1f}/{max(lat)}" if lat else "-"
+        print(f"  {name:<14} {len(trips):5d}  {len(trips) / span_h:8.1f}  {locked:6d}  {lat_s}")
+
+    groups = [e[0] for e in events if e[1] == EV_TRIP and e[2] == GROUP_BEAM]
+    print(f"\nGroups (B1 trips) {len(groups)}, {len(groups) / span_h:.1f} per hour")
+    if len(groups) > 1:
+        gaps = [b - a for a, b in zip(groups, groups[1:])]
+        print(f"  spacing {fmt_ms(min(gaps))} min, {fmt_ms(sum(gaps) / len(gaps))} avg, {fmt_ms(max(gaps))} max")
+
+    print("\nScenes")
+    open_at = {}
+    durations = {}
+    for t, typ, sid, phase in events:
+        if typ != EV_SCENE:
+            continue
+        if phase == EVP_START:
+            open_at[sid] = t
+        elif phase in (EVP_IDLE, EVP_END) and sid in open_at:
+            durations.setdefault(sid, []).append(t - open_at.pop(sid))
+    for sid, d in sorted(durations.items()):
+        print(f"  {SCENE_NAMES.get(sid, str(sid)):<12} runs {len(d)}  ms {stats(d)}")
+    if not durations:
+        print("  none completed")
+
+    print("\nPi link (round trip us)")
+    for typ, name in PI_TYPES.items():
+        rtt = [e[3] for e in events if e[1] == EV_PI_ACK and e[2] == typ]
+        fails = sum(1 for e in events if e[1] == EV_PI_FAIL and e[2] == typ)
+        if rtt or fails:
+            print(f"  {name:<6} {stats(rtt)}  fail {fails}")
+
+    reed = [e for e in events if e[1] == EV_REED]
+    if reed:
+        closes = sum(1 for e in reed if e[3])
+        print(f"\nReed B6: {closes} closes, {len(reed) - closes} opens")
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Per-night statistics from a Haunted Hearse LOG DUMP")
+    ap.add_argument("source", help="serial port or a saved binary capture")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--ee", action="store_true", help="dump the last EEPROM checkpoint instead of RAM")
+    ap.add_argument("--save", help="also write the raw capture to this file")
+    args = ap.parse_args()
+
+    if os.path.isfile(args.source):
+        with open(args.source, "rb") as f:
+            blob = f.read()
+    else:
+        blob = capture(args.source, args.baud, args.ee)
+    if args.save:
+        with open(args.save, "wb") as f:
+            f.write(blob)
+
+    try:
+        t0, events = parse(blob)
+    except ValueError as e:
+        print(f"[ERR] {e}")
+        sys.exit(1)
+    report(t0, events)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+# Haunted Hearse SRAM report
+# Per-module .data/.bss from the PlatformIO object files, then the largest
+# RAM symbols from the linked ELF. Constant tables should be in PROGMEM and
+# show up under flash, not here.
+# Requires: avr-size and avr-nm on PATH (PlatformIO ships them in
+# ~/.platformio/packages/toolchain-atmelavr/bin)
+#
+# Usage:
+#   python3 hh_ram_report.py                      default env mega2560
+#   python3 hh_ram_report.py --build .pio/build/mega2560 --top 30
+#   python3 hh_ram_report.py --all                include framework and library objects
+
+import os, sys, argparse, subprocess
+
+SRAM_BYTES = 8192   # ATmega2560
+RAM_TYPES = "bBdD"  # nm symbol types that live in .bss / .data
+
+
+def tool(name, prefix):
+    return os.path.join(prefix, name) if prefix else name
+
+
+def size_of(obj, prefix):
+    """(text, data, bss) for one object, Berkeley format."""
+    out = subprocess.run([tool("avr-size", prefix), "-B", obj],
+                         capture_output=True, text=True, check=True).stdout
+    text, data, bss = out.splitlines()[1].split()[:3]
+    return int(text), int(data), int(bss)
+
+
+def objects(build, include_all):
+    for root, _, files in os.walk(build):
+        rel = os.path.relpath(root, build)
+        if not include_all and not rel.startswith("src"):
+            continue
+        for f in files:
+            if f.endswith(".o"):
+                yield os.path.join(root, f)
+
+
+def top_symbols(elf, prefix, n):
+    out = subprocess.run([tool("avr-nm", prefix), "-C", "-S", "--size-sort", "-r", elf],
+                         capture_output=True, text=True, check=True).stdout
+    rows = []
+    for line in out.splitlines():
+        parts = line.split(None, 3)
+        if len(parts) == 4 and parts[2] in RAM_TYPES:
+            rows.append((int(parts[1], 16), parts[2], parts[3]))
+    return rows[:n]
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Per-module SRAM use for the Mega build")
+    ap.add_argument("--build", default=".pio/build/mega2560")
+    ap.add_argument("--top", type=int, default=20, help="largest RAM symbols to list")
+    ap.add_argument("--all", action="store_true", help="include framework and libraries")
+    ap.add_argument("--toolchain", default="", help="directory holding avr-size / avr-nm")
+    a = ap.parse_args()
+
+    if not os.path.isdir(a.build):
+        sys.exit(f"{a.build}: not found, run 'pio run' first")
+
+    rows = []
+    for o in objects(a.build, a.all):
+        _, data, bss = size_of(o, a.toolchain)
+        rows.append((data + bss, data, bss, os.path.relpath(o, a.build)))
+    rows.sort(reverse=True)
+
+    print(f"{'module':40s} {'.data':>6s} {'.bss':>6s} {'total':>6s}")
+    td = tb = 0
+    for total, data, bss, name in rows:
+        if total:
+            print(f"{name:40s} {data:6d} {bss:6d} {total:6d}")
+        td += data
+        tb += bss
+    print(f"{'sum':40s} {td:6d} {tb:6d} {td + tb:6d}")
+
+    elf = os.path.join(a.build, "firmware.elf")
+    if os.path.isfile(elf):
+        _, data, bss = size_of(elf, a.toolchain)
+        print(f"\nlinked: .data {data}  .bss {bss}  static RAM {data + bss} of {SRAM_BYTES}"
+              f"  ({SRAM_BYTES - data - bss} left for heap and stack)")
+        print(f"\nlargest RAM symbols:")
+        for sz, t, name in top_symbols(elf, a.toolchain, a.top):
+            print(f"  {sz:5d}  {'data' if t in 'dD' else 'bss '}  {name}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+# Haunted Hearse trace replay
+# Runs a recorded beam/reed trace through the firmware built for the host
+# ([env:native], lib/arduino_shim): the unmodified inputs, scenes, display
+# and output modules on a virtual clock. A whole night replays in seconds and
+# the same trace always gives the same timeline, so two firmware revisions
+# can be compared event for event.
+#
+# Trace formats:
+#   CSV, one edge per line: t_ms,beam,level   (level as read: 0 = broken / reed closed)
+#   console lines in the same file:  t_ms,>,TEXT
+#   --from-log night.bin   edges rebuilt from a LOG DUMP capture (hh_log_stats.py --save)
+#
+# Usage:
+#   pio run -e native
+#   python3 hh_replay.py trace.csv --out rev_a.txt
+#   python3 hh_replay.py --from-log night.bin --compress-gaps 40 --out rev_b.txt --compare rev_a.txt
+
+import os, re, sys, argparse, difflib, subprocess, tempfile
+
+from hh_log_stats import parse, EV_TRIP, EV_TRIP_LOCKED, EV_REED
+
+PROGRAM = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", ".pio", "build", "native", "program")
+DEBOUNCE_MS = 30      # default SDEB, used to place rebuilt edges before the logged trip
+LINE = re.compile(r"^\s*(\d+)\.(\d{3})  (\S+)\s+(.*)$")
+
+
+# ---------------- Trace input ----------------
+
+def load_csv(path):
+    """Edges (t, beam, level) and console lines (t, '>', text)."""
+    edges = []
+    with open(path) as f:
+        for line in f:
+            line = line.split("#")[0].strip()
+            if not line:
+                continue
+            t, what, rest = line.split(",", 2)
+            if what.strip() == ">":
+                edges.append((int(t), ">", rest))
+            else:
+                edges.append((int(t), int(what), 1 if int(rest) else 0))
+    return sorted(edges, key=lambda e: e[0])
+
+
+def edges_from_log(path, beam_hold_ms):
+    """Rebuild pin edges from a logged night: each trip becomes a break of beam_hold_ms."""
+    with open(path, "rb") as f:
+        _, events = parse(f.read())
+    edges = []
+    for t, typ, eid, arg in events:
+        if typ == EV_TRIP:
+            start = t - arg
+        elif typ == EV_TRIP_LOCKED:
+            start = t - DEBOUNCE_MS
+        elif typ == EV_REED:
+            edges.append((t - DEBOUNCE_MS, 6, 0 if arg else 1))
+            continue
+        else:
+            continue
+        edges.append((start, eid, 0))
+        edges.append((start + beam_hold_ms, eid, 1))
+    return sorted(edges, key=lambda e: e[0])
+
+
+def compress(edges, max_gap_ms):
+    """Shrink idle gaps. Keep max_gap above the re-arm time or lockouts change."""
+    out, shift, prev = [], 0, None
+    for t, what, val in edges:
+        if prev is not None and t - prev > max_gap_ms:
+            shift += (t - prev) - max_gap_ms
+        prev = t
+        out.append((t - shift, what, val))
+    return out
+
+
+def normalize(edges, lead_ms=3000):
+    """Start the trace lead_ms after power-on, once the deferred boot is done."""
+    t0 = edges[0][0] if edges else 0
+    return [(t - t0 + lead_ms, w, v) for t, w, v in edges]
+
+
+# ---------------- Native run ----------------
+
+def run(program, edges, tail_s, extra):
+    with tempfile.NamedTemporaryFile("w", suffix=".csv", delete=False) as f:
+        for t, what, val in edges:
+            f.write(f"{t},{what},{val}\n")
+        path = f.name
+    try:
+        out = subprocess.run([program, path, "--tail", str(tail_s)] + extra,
+                             check=True, stdout=subprocess.PIPE, universal_newlines=True).stdout
+    finally:
+        os.unlink(path)
+    return out.splitlines()
+
+
+def events(lines):
+    """(t_us, kind, detail) for every timeline line; '#' lines are headers."""
+    out = []
+    for line in lines:
+        m = LINE.match(line)
+        if m:
+            out.append((int(m.group(1)) * 1000 + int(m.group(2)), m.group(3), m.group(4)))
+    return out
+
+
+def compare(a, b, tol_ms):
+    """Match events by kind and detail; report missing/extra ones and moved ones."""
+    sm = difflib.SequenceMatcher(a=[e[1:] for e in a], b=[e[1:] for e in b], autojunk=False)
+    shifts, diffs = [], 0
+    for op, i1, i2, j1, j2 in sm.get_opcodes():
+        if op == "equal":
+            shifts += [(b[j1 + k][0] - a[i1 + k][0], b[j1 + k]) for k in range(i2 - i1)]
+            continue
+        diffs += 1
+        for e in a[i1:i2]:
+            print(f"  - {e[0] / 1000:12.3f}  {e[1]:<4} {e[2]}")
+        for e in b[j1:j2]:
+            print(f"  + {e[0] / 1000:12.3f}  {e[1]:<4} {e[2]}")
+    moved = [(d, e) for d, e in shifts if abs(d) > tol_ms * 1000]
+    for d, e in moved[:20]:
+        print(f"  ~ {e[0] / 1000:12.3f}  {e[1]:<4} {e[2]}  moved {d / 1000:+.3f} ms")
+    print(f"Compare: {len(shifts)} matched, {diffs} differing blocks, "
+          f"{len(moved)} matched events moved more than {tol_ms} ms")
+    return diffs == 0 and not moved
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Replay a beam trace through the firmware's native build")
+    ap.add_argument("trace", nargs="?", help="CSV trace t_ms,beam,level (and t_ms,>,TEXT)")
+    ap.add_argument("--from-log", help="rebuild the trace from a LOG DUMP capture")
+    ap.add_argument("--beam-hold-ms", type=int, default=400, help="break length for rebuilt trips")
+    ap.add_argument("--compress-gaps", type=float, default=0, help="shrink idle gaps to this many seconds")
+    ap.add_argument("--tail", type=float, default=25, help="seconds to run after the last edge")
+    ap.add_argument("--program", default=PROGRAM, help="native build (pio run -e native)")
+    ap.add_argument("--console", action="store_true", help="include console output in the timeline")
+    ap.add_argument("--out", help="save the timeline")
+    ap.add_argument("--compare", help="timeline saved from another revision")
+    ap.add_argument("--tol-ms", type=float, default=0, help="allowed move of a matched event")
+    ap.add_argument("--quiet", action="store_true", help="do not print the timeline")
+    args = ap.parse_args()
+
+    if args.from_log:
+        edges = normalize(edges_from_log(args.from_log, args.beam_hold_ms))
+    elif args.trace:
+        edges = load_csv(args.trace)
+    else:
+        ap.error("give a CSV trace or --from-log")
+    if args.compress_gaps:
+        edges = compress(edges, int(args.compress_gaps * 1000))
+    if not os.path.exists(args.program):
+        sys.exit(f"{args.program} not found, build it with: pio run -e native")
+    print(f"[OK] {len(edges)} trace lines, {edges[-1][0] / 1000 if edges else 0:.1f} s of trace")
+
+    lines = run(args.program, edges, args.tail, ["--console"] if args.console else [])
+    if not args.quiet:
+        print("\n".join(lines))
+    if args.out:
+        with open(args.out, "w") as f:
+            f.write("\n".join(lines) + "\n")
+    if args.compare:
+        with open(args.compare) as f:
+            ref = events(f.read().splitlines())
+        sys.exit(0 if compare(ref, events(lines), args.tol_ms) else 2)
+
+
+if __name__ == "__main__":
+    main()
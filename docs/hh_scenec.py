@@ -0,0 +1,363 @@
+#!/usr/bin/env python3
+# Haunted Hearse scene compiler
+# Turns a text scene description into the bytecode image run by the Mega's
+# scene VM (include/scenevm.hpp) and loads it over the console, so a room
+# can be changed between groups without a reflash.
+# Requires: pip install pyserial (only for uploading)
+#
+# Scene file:
+#   # comment
+#   scene GRAV beam 3          name up to 4 chars, beam 0..5 replaces that beam's built-in scene
+#     disp "RIP"
+#     rgb 0 40 20
+#     trig GRAVE               Pi opto trigger, optional ms (default 100)
+#     pi cue 2 | pi start "grave_loop"
+#     fade 0 0 0 2s            RGB ramp, runs on while the scene continues
+#     pulse MAGNET 250         output channel by name as listed by OUT (or its live number)
+#     hold BLOOD 5000 | out REC on|off
+#     repeat 3
+#       wait 400ms
+#       pulse FUR 100
+#     end
+#     waitbeam 4 5 timeout 10s  flag set if beam 4 or 5 broke, clear on timeout
+#     if clear goto done        also: if trip goto <label>
+#     log 7
+#   done:
+#     end
+#
+# Times are ms unless suffixed s. Every scene ends with END if it does not already.
+#
+# Usage:
+#   python3 hh_scenec.py rooms.hhs --list
+#   python3 hh_scenec.py rooms.hhs --port /dev/ttyUSB0 --run GRAV
+#   python3 hh_scenec.py rooms.hhs --header include/svm_image.h   (build with -DHH_SVM_FLASH)
+
+import sys, time, shlex, struct, argparse
+
+# Opcodes, scenevm.hpp
+END, WAIT, OUT, PULSE, HOLD, RGB, FADE, DISP, PICUE, PISTART, TRIG, WAITBEAM, JMP, JT, JF, REPEAT, DJNZ, LOG = range(18)
+NAMES = ["END", "WAIT", "OUT", "PULSE", "HOLD", "RGB", "FADE", "DISP", "PICUE", "PISTART",
+         "TRIG", "WAITBEAM", "JMP", "JT", "JF", "REPEAT", "DJNZ", "LOG"]
+JUMPS = {JMP, JT, JF, DJNZ}
+
+# Output channels go into the image by name; the firmware looks them up in its
+# OUT table when it opens the image and rejects one naming a channel it lacks
+CHAN_NAME = 8       # bytes per channel name, space padded
+TRIGGERS = ["SHOW", "BLOOD", "GRAVE", "FUR", "FRANKEN"]
+
+IMAGE_VER = 2
+IMAGE_MAX = 1024    # EE_SVM_BYTES
+MAX_CHANS = 10      # OUTPUTS_MAX
+MAX_PROGS = 8
+CHUNK = 32          # bytes per SVM W
+
+
+class CompileError(Exception):
+    pass
+
+
+def crc16_modbus(data):
+    c = 0xFFFF
+    for b in data:
+        c ^= b
+        for _ in range(8):
+            c = (c >> 1) ^ 0xA001 if c & 1 else c >> 1
+    return c
+
+
+def ms(tok):
+    t = tok.lower()
+    if t.endswith("ms"):
+        v = float(t[:-2])
+    elif t.endswith("s"):
+        v = float(t[:-1]) * 1000
+    else:
+        v = float(t)
+    if v < 0:
+        raise ValueError
+    return int(round(v))
+
+
+def byte(tok, hi=255):
+    v = int(tok, 0)
+    if not 0 <= v <= hi:
+        raise ValueError
+    return v
+
+
+def channel(tok, table, no):
+    """Index of an output channel in the image's name table, adding it on first use."""
+    up = tok.upper()
+    if not 1 <= len(up) <= CHAN_NAME or not up.isascii() or " " in up:
+        raise CompileError(f"line {no}: output channel name must be 1..{CHAN_NAME} characters")
+    if up not in table:
+        if len(table) == MAX_CHANS:
+            raise CompileError(f"line {no}: more than {MAX_CHANS} output channels")
+        table.append(up)
+    return table.index(up)
+
+
+def lookup(tok, table):
+    up = tok.upper()
+    if up in table:
+        return table.index(up)
+    return byte(tok, len(table) - 1)
+
+
+class Scene:
+    def __init__(self, name, beam, line):
+        self.name, self.beam, self.line = name, beam, line
+        self.ops = []         # (opcode, operand bytes, label or None, source line)
+        self.labels = {}
+        self.repeat = None    # (label, line) of the open repeat block
+
+
+def parse(text):
+    """Scenes and the output channel names they use."""
+    scenes, channels, cur = [], [], None
+    for no, raw in enumerate(text.splitlines(), 1):
+        line = raw.split("#", 1)[0].strip()
+        if not line:
+            continue
+        try:
+            tok = shlex.split(line)
+        except ValueError as e:
+            raise CompileError(f"line {no}: {e}")
+        op = tok[0].lower()
+        try:
+            if op == "scene":
+                if cur and cur.repeat:
+                    raise CompileError(f"line {cur.repeat[1]}: repeat without end")
+                name = tok[1]
+                if not 1 <= len(name) <= 4 or not name.isascii():
+                    raise CompileError(f"line {no}: scene name must be 1..4 characters")
+                beam = 0xFF
+                if len(tok) == 4 and tok[2].lower() == "beam":
+                    beam = byte(tok[3], 5)
+                elif len(tok) != 2:
+                    raise ValueError
+                cur = Scene(name.upper(), beam, no)
+                scenes.append(cur)
+                continue
+            if cur is None:
+                raise CompileError(f"line {no}: '{op}' outside a scene")
+            emit = lambda code, data=b"", label=None: cur.ops.append((code, data, label, no))
+
+            if op.endswith(":") and len(tok) == 1:
+                label = op[:-1]
+                if label in cur.labels:
+                    raise CompileError(f"line {no}: label '{label}' defined twice")
+                cur.labels[label] = len(cur.ops)
+            elif op == "wait":
+                left = ms(tok[1])
+                while True:                       # WAIT takes 16 bits, longer waits chain
+                    step = min(left, 0xFFFF)
+                    emit(WAIT, struct.pack("<H", step))
+                    left -= step
+                    if left == 0:
+                        break
+            elif op == "out":
+                if tok[2].lower() not in ("on", "off"):
+                    raise ValueError
+                emit(OUT, bytes([channel(tok[1], channels, no), tok[2].lower() == "on"]))
+            elif op in ("pulse", "hold"):
+                emit(PULSE if op == "pulse" else HOLD, struct.pack("<BH", channel(tok[1], channels, no), ms16(tok[2], no)))
+            elif op == "rgb":
+                emit(RGB, bytes(byte(t) for t in tok[1:4]))
+            elif op == "fade":
+                emit(FADE, bytes(byte(t) for t in tok[1:4]) + struct.pack("<H", ms16(tok[4], no)))
+            elif op == "disp":
+                text4 = tok[1].upper()
+                if len(text4) > 4 or not text4.isascii():
+                    raise CompileError(f"line {no}: disp takes up to 4 characters")
+                emit(DISP, text4.ljust(4).encode())
+            elif op == "pi" and tok[1].lower() == "cue":
+                emit(PICUE, bytes([lookup(tok[2], TRIGGERS) if tok[2].upper() in TRIGGERS else byte(tok[2])]))
+            elif op == "pi" and tok[1].lower() == "start":
+                name = tok[2].encode()
+                if not 1 <= len(name) <= 16:
+                    raise CompileError(f"line {no}: pi start name must be 1..16 bytes")
+                emit(PISTART, bytes([len(name)]) + name)
+            elif op == "trig":
+                emit(TRIG, struct.pack("<BH", lookup(tok[1], TRIGGERS), ms16(tok[2], no) if len(tok) > 2 else 100))
+            elif op == "waitbeam":
+                args, timeout = tok[1:], 0
+                if len(args) >= 2 and args[-2].lower() == "timeout":
+                    timeout, args = ms16(args[-1], no), args[:-2]
+                mask = 0
+                for a in args:
+                    mask |= 1 << byte(a.upper().lstrip("B"), 5)
+                if not mask:
+                    raise ValueError
+                emit(WAITBEAM, struct.pack("<BH", mask, timeout))
+            elif op == "goto":
+                emit(JMP, b"", tok[1].lower())
+            elif op == "if" and len(tok) == 4 and tok[2].lower() == "goto":
+                if tok[1].lower() not in ("trip", "clear"):
+                    raise ValueError
+                emit(JT if tok[1].lower() == "trip" else JF, b"", tok[3].lower())
+            elif op == "repeat":
+                if cur.repeat:
+                    raise CompileError(f"line {no}: repeat blocks do not nest (one loop counter)")
+                n = byte(tok[1])
+                if n == 0:
+                    raise ValueError
+                emit(REPEAT, bytes([n]))
+                top = f".repeat{no}"
+                cur.labels[top] = len(cur.ops)
+                cur.repeat = (top, no)
+            elif op == "end" and cur.repeat:
+                emit(DJNZ, b"", cur.repeat[0])
+                cur.repeat = None
+            elif op == "end":
+                emit(END)
+            elif op == "log":
+                emit(LOG, bytes([byte(tok[1])]))
+            else:
+                raise CompileError(f"line {no}: unknown statement '{op}'")
+        except (IndexError, ValueError):
+            raise CompileError(f"line {no}: bad arguments: {raw.strip()}")
+    if cur and cur.repeat:
+        raise CompileError(f"line {cur.repeat[1]}: repeat without end")
+    if not scenes:
+        raise CompileError("no scenes")
+    if len(scenes) > MAX_PROGS:
+        raise CompileError(f"{len(scenes)} scenes, the VM holds {MAX_PROGS}")
+    return scenes, channels
+
+
+def ms16(tok, no):
+    v = ms(tok)
+    if v > 0xFFFF:
+        raise CompileError(f"line {no}: {v} ms is over 65535 (use wait for long gaps)")
+    return v
+
+
+def assemble(scenes, channels):
+    """Lay out all scenes, resolve labels, return (image, listing)."""
+    for s in scenes:
+        if not s.ops or s.ops[-1][0] not in (END, JMP) or len(s.ops) in s.labels.values():
+            s.ops.append((END, b"", None, s.line))
+    # Pass 1: addresses
+    addr, entry, where = 0, [], []
+    for s in scenes:
+        entry.append(addr)
+        at = []
+        for code, data, label, _ in s.ops:
+            at.append(addr)
+            addr += 1 + (2 if code in JUMPS else len(data))
+        at.append(addr)
+        where.append(at)
+    # Pass 2: bytes
+    code_bytes, listing = bytearray(), []
+    for s, at in zip(scenes, where):
+        listing.append(f"scene {s.name}" + (f"  beam {s.beam}" if s.beam != 0xFF else ""))
+        for i, (code, data, label, no) in enumerate(s.ops):
+            if code in JUMPS:
+                if label not in s.labels:
+                    raise CompileError(f"line {no}: unknown label '{label}'")
+                data = struct.pack("<H", at[s.labels[label]])
+            code_bytes += bytes([code]) + data
+            listing.append(f"  {at[i]:4d}  {NAMES[code]:<9} {data.hex(' ')}")
+
+    directory = bytearray()
+    for s, e in zip(scenes, entry):
+        directory += s.name.ljust(4).encode() + bytes([s.beam, 0]) + struct.pack("<H", e)
+    table = bytes([len(channels)]) + b"".join(c.ljust(CHAN_NAME).encode() for c in channels)
+    if channels:
+        listing.append("channels " + " ".join(f"{i}={c}" for i, c in enumerate(channels)))
+    body = bytes(directory + table + code_bytes)
+    image = b"SV" + bytes([IMAGE_VER, len(scenes)]) + struct.pack("<HH", len(code_bytes), crc16_modbus(body)) + body
+    if len(image) > IMAGE_MAX:
+        raise CompileError(f"image is {len(image)} bytes, the EEPROM area holds {IMAGE_MAX}")
+    return image, listing
+
+
+def header(image, src):
+    rows = ",\n".join("  " + ", ".join(f"0x{b:02X}" for b in image[i:i + 16]) for i in range(0, len(image), 16))
+    return (f"// Generated by docs/hh_scenec.py from {src}, do not edit\n"
+            "#pragma once\n#include <Arduino.h>\n\n"
+            f"static const uint8_t SVM_IMAGE[{len(image)}] PROGMEM = {{\n{rows}\n}};\n")
+
+
+class Link:
+    def __init__(self, port, baud):
+        import serial
+        self.ser = serial.Serial(port, baud, timeout=0.05)
+        time.sleep(2.5)                 # opening the port resets the Mega
+        self.ser.reset_input_buffer()
+        self.buf = bytearray()
+
+    def cmd(self, line, markers, timeout=3.0):
+        """Send a line, return the first reply line containing one of the markers."""
+        self.ser.write((line + "\n").encode())
+        deadline = time.monotonic() + timeout
+        while time.monotonic() < deadline:
+            self.buf += self.ser.read(self.ser.in_waiting or 1)
+            while b"\n" in self.buf:
+                end = self.buf.index(b"\n")
+                text = bytes(self.buf[:end]).decode(errors="replace").strip()
+                del self.buf[:end + 1]
+                if any(m in text for m in markers) and not text.startswith(">"):
+                    return text
+        raise TimeoutError(f"no reply to '{line}'")
+
+
+def upload(link, image):
+    r = link.cmd(f"SVM LOAD {len(image)}", ["OK SVM LOAD", "ERR SVM"])
+    if not r.startswith("OK"):
+        raise RuntimeError(r)
+    t0 = time.monotonic()
+    for off in range(0, len(image), CHUNK):
+        line = f"SVM W {off} {image[off:off + CHUNK].hex().upper()}"
+        while True:
+            r = link.cmd(line, ["OK SVM W", "ERR SVM"])
+            if r.startswith("OK"):
+                break
+            if "busy" not in r:
+                raise RuntimeError(r)
+            time.sleep(0.03)            # previous chunk still going into EEPROM
+        sys.stdout.write(f"\r  {off + CHUNK if off + CHUNK < len(image) else len(image)}/{len(image)} bytes")
+        sys.stdout.flush()
+    r = link.cmd("SVM COMMIT", ["OK SVM COMMIT", "ERR SVM"], timeout=5.0)
+    print(f"  {time.monotonic() - t0:.1f} s")
+    if not r.startswith("OK"):
+        raise RuntimeError(r)
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Compile Haunted Hearse scenes to scene VM bytecode")
+    ap.add_argument("source", help="scene description (.hhs)")
+    ap.add_argument("--list", action="store_true", help="print the assembled bytecode")
+    ap.add_argument("--out", help="write the raw image")
+    ap.add_argument("--header", help="write a PROGMEM header for -DHH_SVM_FLASH builds")
+    ap.add_argument("--port", help="upload to the Mega's EEPROM over this serial port")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--run", help="start this scene after uploading")
+    args = ap.parse_args()
+
+    try:
+        with open(args.source) as f:
+            image, listing = assemble(*parse(f.read()))
+    except CompileError as e:
+        sys.exit(f"{args.source}: {e}")
+
+    print(f"{args.source}: {len(image)} bytes")
+    if args.list:
+        print("\n".join(listing))
+    if args.out:
+        with open(args.out, "wb") as f:
+            f.write(image)
+    if args.header:
+        with open(args.header, "w") as f:
+            f.write(header(image, args.source))
+    if args.port:
+        link = Link(args.port, args.baud)
+        upload(link, image)
+        print(link.cmd("SVM", ["OK SVM"]))
+        if args.run:
+            print(link.cmd(f"SVM RUN {args.run.upper()}", ["OK SVM RUN", "ERR SVM RUN"]))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+# Haunted Hearse soak / stress run
+# Generates a seeded storm (all six beams chattering, reed toggling, console
+# flooded at a fraction of line rate with junk and over-long lines, plus
+# probe commands) and runs it through the firmware's native build
+# ([env:native], see hh_replay.py). Minutes of storm take seconds.
+#
+# Checks, all against what the firmware itself reports:
+#   deterministic   a second run of the same storm prints the same timeline
+#   console         every probe (SEED) answered, every over-long line
+#                   rejected, unless the RX ring overflowed
+#   trips           per beam, REARM accepted + suppressed is at least the
+#                   number of clean breaks (held past the debounce ceiling,
+#                   no chatter around them) and at most the number of breaks;
+#                   accepted trips are no closer than the re-arm time
+# and reports LOOP, DISP, BEAMSTAT, RX drops and time spent blocked on TX.
+# RAM is not checked: lib/arduino_shim has no stack or heap model, so the
+# firmware's free RAM figures read 0 on the native build and are shown as n/a.
+#
+# Usage:
+#   pio run -e native
+#   python3 hh_stress.py --minutes 10
+#   python3 hh_stress.py --minutes 60 --seed 7 --rate 2.0 --flood 0.8
+
+import re, sys, random, argparse
+
+from hh_replay import PROGRAM, run, events
+
+N_BEAMS = 6
+CONSOLE_MAX = 96      # INBUF_MAX in console.cpp
+PREAMBLE_MS = 500     # settings sent before the storm starts
+STORM_T0 = 3000       # after the deferred boot
+
+
+def storm(rng, seconds, rate, chatter_ms, hold_ms):
+    """Per beam: breaks at `rate` per minute, each with a burst of contact chatter."""
+    edges = []
+    span = int(seconds * 1000)
+    for beam in range(N_BEAMS):
+        t = rng.randint(500, 3000)
+        while t < span:
+            # chatter: short flickers before the beam settles broken
+            for _ in range(rng.randint(0, 4)):
+                w = rng.randint(1, chatter_ms)
+                edges += [(t, beam, 0), (t + w, beam, 1)]
+                t += w + rng.randint(1, chatter_ms)
+            hold = rng.randint(hold_ms // 4, hold_ms)
+            edges += [(t, beam, 0), (t + hold, beam, 1)]
+            t += hold + int(rng.expovariate(rate / 60000.0)) + 1
+    t = 2000
+    while t < span:
+        edges.append((t, 6, rng.choice((0, 1))))
+        t += rng.randint(200, 20000)
+    return sorted((t + STORM_T0, b, l) for t, b, l in edges if t < span)
+
+
+def junk_line(rng):
+    """No command starts with Z, so junk can never run one."""
+    if rng.random() < 0.25:
+        return "Z" * rng.randint(CONSOLE_MAX + 1, 300)
+    return "Z" + "".join(rng.choice("ABCDEFGHIJKLMNOPQRSTUVWXYZ 0123456789") for _ in range(rng.randint(0, 59)))
+
+
+def console_storm(rng, seconds, flood, baud, probe_s):
+    """Junk at `flood` of line rate, a SEED probe every probe_s seconds."""
+    lines, t, span = [], float(STORM_T0), STORM_T0 + seconds * 1000
+    bytes_per_ms = baud / 10000.0 * flood
+    next_probe = STORM_T0 + probe_s * 1000
+    while flood > 0 and t < span:
+        line = junk_line(rng)
+        lines.append((int(t), ">", line))
+        t += (len(line) + 1) / bytes_per_ms
+        if t >= next_probe:
+            lines.append((int(t), ">", "SEED"))
+            next_probe += probe_s * 1000
+    if flood <= 0:
+        lines += [(int(STORM_T0 + k * probe_s * 1000), ">", "SEED") for k in range(1, int(seconds / probe_s) + 1)]
+    return lines
+
+
+def trace_facts(edges, ceiling_ms):
+    """Per beam: all breaks, and clean ones that any debounce up to the ceiling must settle."""
+    out = {}
+    for beam in range(N_BEAMS):
+        ev = [(t, l) for t, b, l in edges if b == beam]
+        breaks = clean = 0
+        for k, (t, l) in enumerate(ev):
+            if l != 0 or (k and ev[k - 1][1] == 0):
+                continue
+            breaks += 1
+            quiet_before = k == 0 or t - ev[k - 1][0] > ceiling_ms
+            held = ev[k + 1][0] - t if k + 1 < len(ev) else 10 ** 9
+            if quiet_before and held > ceiling_ms + 5:
+                clean += 1
+        out[beam] = (breaks, clean)
+    return out
+
+
+def replies(timeline, start_t_us):
+    """Console output after the given time, as text lines."""
+    return [d for t, k, d in timeline if k == "CON" and t >= start_t_us]
+
+
+def block(lines, cmd):
+    """Output of one command from the epilogue: from its echo to its OK line."""
+    out, inside = [], False
+    for d in lines:
+        if d == "> " + cmd:
+            inside, out = True, []
+        elif inside:
+            out.append(d)
+            if d.startswith("OK " + cmd):
+                return out
+    return out
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Randomized storm through the firmware's native build")
+    ap.add_argument("--minutes", type=float, default=5)
+    ap.add_argument("--seed", type=int, default=1)
+    ap.add_argument("--rate", type=float, default=3.0, help="breaks per beam per minute")
+    ap.add_argument("--chatter-ms", type=int, default=15)
+    ap.add_argument("--hold-ms", type=int, default=600)
+    ap.add_argument("--flood", type=float, default=0.5, help="fraction of line rate spent on junk lines")
+    ap.add_argument("--probe-s", type=float, default=5, help="seconds between SEED probes")
+    ap.add_argument("--debounce", type=int, default=30, help="SDEB ceiling for the run")
+    ap.add_argument("--rearm", type=int, default=20000, help="SREARM for the run")
+    ap.add_argument("--baud", type=int, default=115200, help="HH_CONSOLE_BAUD of the build")
+    ap.add_argument("--program", default=PROGRAM, help="native build (pio run -e native)")
+    args = ap.parse_args()
+    if not 0 <= args.flood <= 1:
+        ap.error("--flood is a fraction of line rate, 0..1")
+
+    rng = random.Random(args.seed)
+    seconds = args.minutes * 60
+    edges = storm(rng, seconds, args.rate, args.chatter_ms, args.hold_ms)
+    flood = console_storm(rng, seconds, args.flood, args.baud, args.probe_s)
+    end_ms = STORM_T0 + int(seconds * 1000) + 2000
+    setup = [(PREAMBLE_MS + 10 * k, ">", c) for k, c in enumerate(
+        (f"SDEB {args.debounce}", f"SREARM {args.rearm}", "BEAMSTAT RESET", "LOOP RESET"))]
+    tail = [(end_ms + 200 * k, ">", c) for k, c in enumerate(("LOOP", "DISP", "BEAMSTAT", "REARM"))]
+    trace = sorted(setup + edges + flood + tail, key=lambda e: e[0])
+
+    n_probes = sum(1 for e in flood if e[2] == "SEED")
+    n_long = sum(1 for e in flood if e[2] != "SEED" and len(e[2]) > CONSOLE_MAX)
+    print(f"[OK] seed {args.seed}: {len(edges)} edges, {len(flood)} console lines over {seconds:.0f} s")
+
+    lines = run(args.program, trace, 2, ["--console"])
+    again = run(args.program, trace, 2, ["--console"])
+    timeline = events(lines)
+    summary = next((l for l in lines if l.startswith("# end")), "")
+    rx_dropped = int(re.search(r"rx dropped (\d+)", summary).group(1))
+    tx_blocked = float(re.search(r"tx blocked ([\d.]+)", summary).group(1))
+    con = replies(timeline, STORM_T0 * 1000)
+
+    fails = []
+    if timeline != events(again) or summary not in again:
+        fails.append("second run printed a different timeline")
+
+    got_probes = sum(1 for d in con if d.startswith("OK SEED"))
+    got_long = sum(1 for d in con if d == "ERR line too long")
+    print(f"Console: {n_probes} probes, {got_probes} answered; {n_long} over-long lines, {got_long} rejected; "
+          f"RX dropped {rx_dropped} B, TX blocked {tx_blocked:.1f} ms")
+    if rx_dropped == 0 and (got_probes != n_probes or got_long != n_long):
+        fails.append("console lost lines without an RX overflow")
+
+    rearm = {}
+    for d in block(con, "REARM"):
+        m = re.match(r"\s*B(\d)\s.*\t(\d+)\t(\d+)\t", d)
+        if m:
+            rearm[int(m.group(1))] = (int(m.group(2)), int(m.group(3)))
+    facts = trace_facts(edges, args.debounce)
+    max_accepted = int(seconds * 1000 // args.rearm) + 1
+    print("\nBeam  breaks  clean   accepted  suppressed")
+    for b in range(N_BEAMS):
+        breaks, clean = facts[b]
+        acc, sup = rearm.get(b, (0, 0))
+        print(f"  B{b}  {breaks:6d}  {clean:5d}   {acc:8d}  {sup:10d}")
+        if acc + sup < clean:
+            fails.append(f"B{b}: {clean} clean breaks, only {acc + sup} settled")
+        if acc + sup > breaks:
+            fails.append(f"B{b}: {acc + sup} settled from {breaks} breaks")
+        if acc > max_accepted:
+            fails.append(f"B{b}: {acc} accepted, re-arm allows {max_accepted}")
+    if not rearm:
+        fails.append("no REARM table in the console output")
+
+    for cmd in ("LOOP", "DISP", "BEAMSTAT"):
+        print("\n".join("RAM: n/a on native build" if d.startswith("free RAM") else d for d in block(con, cmd)))
+    print("\n" + ("PASS" if not fails else "FAIL\n  " + "\n  ".join(fails)))
+    sys.exit(1 if fails else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+# Haunted Hearse PiLink stand-in daemon
+# Emulates the Pi side of the Mega -> Pi framed command link (src/pilink.cpp)
+# so the Mega can be tested on the bench without FPP.
+# Requires: pip install pyserial
+#
+# Usage:
+#   python3 pi_link_daemon.py /dev/ttyUSB0
+#   python3 pi_link_daemon.py /dev/ttyUSB0 --drop 0.2 --delay-ms 3
+#
+# --drop       probability of silently ignoring a frame (exercises Mega retries)
+# --delay-ms   fixed delay before each ack (emulates a busy Pi)
+# --fail-cues  comma separated cue numbers to answer with a non-zero status
+
+import sys, time, random, argparse
+
+try:
+    import serial
+except:
+    print("pyserial is required. Install with: pip install pyserial")
+    sys.exit(1)
+
+SOF = 0x7E
+MAX_PAYLOAD = 16
+
+PING, CUE, START, STOP = 0x01, 0x02, 0x03, 0x04
+ACK, NAK = 0x80, 0x81
+
+TYPE_NAMES = {PING: "PING", CUE: "CUE", START: "START", STOP: "STOP"}
+CUE_NAMES = ["SHOW", "BLOOD", "GRAVE", "FUR", "FRANKEN"]
+
+
+def crc8(data):
+    c = 0
+    for d in data:
+        c ^= d
+        for _ in range(8):
+            c = ((c << 1) ^ 0x07) & 0xFF if c & 0x80 else (c << 1) & 0xFF
+    return c
+
+
+def frame(seq, typ, payload=b""):
+    body = bytes([seq, typ, len(payload)]) + payload
+    return bytes([SOF]) + body + bytes([crc8(body)])
+
+
+class Parser:
+    """Byte-at-a-time parser mirroring rx_byte() in pilink.cpp."""
+
+    def __init__(self):
+        self.reset()
+        self.bad = 0
+
+    def reset(self):
+        self.state = "SOF"
+        self.body = bytearray()
+        self.need = 0
+
+    def feed(self, b):
+        if self.state == "SOF":
+            if b == SOF:
+                self.body = bytearray()
+                self.state = "HDR"
+            return None
+        if self.state == "HDR":
+            self.body.append(b)
+            if len(self.body) == 3:
+                if self.body[2] > MAX_PAYLOAD:
+                    self.bad += 1
+                    self.reset()
+                    return None
+                self.need = self.body[2]
+                self.state = "PAY" if self.need else "CRC"
+            return None
+        if self.state == "PAY":
+            self.body.append(b)
+            self.need -= 1
+            if self.need == 0:
+                self.state = "CRC"
+            return None
+        # CRC
+        body = bytes(self.body)
+        self.reset()
+        if crc8(body) != b:
+            self.bad += 1
+            return None
+        return body[0], body[1], body[3:]
+
+
+def describe(typ, payload):
+    name = TYPE_NAMES.get(typ, f"0x{typ:02X}")
+    if typ == CUE and payload:
+        cue = payload[0]
+        label = CUE_NAMES[cue] if cue < len(CUE_NAMES) else "custom"
+        return f"{name} {cue} ({label})"
+    if typ == START:
+        return f"{name} '{payload.decode(errors='replace')}'"
+    return name
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Emulate the Pi end of the Haunted Hearse PiLink")
+    ap.add_argument("port")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--drop", type=float, default=0.0)
+    ap.add_argument("--delay-ms", type=float, default=0.0)
+    ap.add_argument("--fail-cues", default="")
+    args = ap.parse_args()
+
+    fail_cues = {int(x) for x in args.fail_cues.split(",") if x.strip()}
+    ser = serial.Serial(args.port, args.baud, timeout=0.01)
+    parser = Parser()
+    seen = {}
+    t0 = time.monotonic()
+    print(f"[OK] PiLink daemon on {args.port} @ {args.baud}")
+
+    while True:
+        data = ser.read(ser.in_waiting or 1)
+        for b in data:
+            got = parser.feed(b)
+            if not got:
+                continue
+            seq, typ, payload = got
+            ts = time.monotonic() - t0
+            if random.random() < args.drop:
+                print(f"{ts:9.3f}  seq {seq:3d}  {describe(typ, payload)}  [dropped]")
+                continue
+
+            # A retry of a frame we already acted on is acked again but not replayed
+            retry = seen.get(seq) == (typ, payload)
+            seen[seq] = (typ, payload)
+
+            if typ not in TYPE_NAMES:
+                reply = frame(seq, NAK)
+            elif typ == CUE and payload and payload[0] in fail_cues:
+                reply = frame(seq, ACK, bytes([1]))
+            else:
+                reply = frame(seq, ACK, bytes([0]))
+
+            if args.delay_ms:
+                time.sleep(args.delay_ms / 1000.0)
+            ser.write(reply)
+            tag = "  [retry]" if retry else ""
+            print(f"{ts:9.3f}  seq {seq:3d}  {describe(typ, payload)}{tag}")
+
+
+if __name__ == "__main__":
+    try:
+        main()
+    except KeyboardInterrupt:
+        pass
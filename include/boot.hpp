@@ -0,0 +1,28 @@
+#pragma once
+#include <Arduino.h>
+
+// Boot timeline: micros() stamps for each setup stage, printed by the BOOT command.
+// Fast-arm order: beams and safe actuator states first, then stored tuning;
+// banners, display and the Pi link come up from loop() one step per pass.
+enum BootStage : uint8_t {
+  BOOT_SETUP = 0,    // setup() entered
+  BOOT_SAFE,         // magnet, buzzer and status LEDs off
+  BOOT_ARMED,        // techlight and Pi trigger lines off, beams sampled
+  BOOT_SETTINGS,     // stored tuning applied
+  BOOT_RECOVERY,     // warm-restart snapshot restored (if valid), watchdog armed
+  BOOT_LIVE,         // setup() returned, loop() polling beams
+  BOOT_BANNER,       // deferred: console banners printed
+  BOOT_DISPLAY,      // deferred: I2C display up
+  BOOT_PILINK,       // deferred: Pi link UART open
+  BOOT_DONE,         // all deferred steps finished
+  BOOT_N_STAGES
+};
+
+// Stamp a stage with micros(). Later stamps of the same stage are ignored.
+void boot_mark(BootStage stage);
+
+// Run the next deferred init step. Returns false once everything is up.
+bool boot_deferred_step();
+
+// Print the timeline as "stage  t_us  +delta_us"
+void boot_print(Stream& s);
@@ -38,16 +38,6 @@ void console_attach(
   void (*printStatus)()
 );
 
-// NEW: attach recorder/gopro hooks (call in main.cpp)
-void console_attach_devices(
-  void (*gopro_on)(),
-  void (*gopro_off)(),
-  void (*gopro_ms)(uint32_t),
-  void (*audio_on)(),
-  void (*audio_off)(),
-  void (*audio_ms)(uint32_t)
-);
-
 // Call every loop() to process serial input
 void console_update();
 
@@ -57,4 +47,9 @@ bool console_should_log();
 // Print a tagged log message if logging is enabled
 void console_log(const String& msg);
 
+// Flash-resident variants: the literal stays out of SRAM (use F("...")).
+// The second form appends a RAM string, e.g. a beam or command name.
+void console_log(const __FlashStringHelper* msg);
+void console_log(const __FlashStringHelper* msg, const char* detail);
+
 #endif
\ No newline at end of file
@@ -5,6 +5,7 @@
 void display_begin(uint8_t i2c_addr = 0x70, uint8_t brightness = 8);
 
 // Ownership and arbitration
+// owner: a PROGMEM tag (e.g. static const char OWNER[] PROGMEM = "FRANK"), up to 7 chars.
 // priority: 0..255, higher can preempt lower. Equal priority cannot preempt.
 // hold_ms: 0 means no auto-expire. If >0, ownership auto-releases after that window unless renewed.
 bool display_acquire(const char* owner, uint8_t priority, uint32_t hold_ms = 0);
@@ -17,8 +18,60 @@ bool display_is_free();
 void display_print4_owned(const char* owner, const char* s4);
 bool display_set_brightness_owned(const char* owner, uint8_t level); // 0..15
 
+// Raw segments. A digit is one 16-bit word in the backpack's bit order;
+// text converted once (display_glyphs) or frames kept in PROGMEM draw with
+// a 4-word copy, no font lookup per frame. Custom glyphs and segment
+// animations (drips, wipes, spinners) are just words built from SEG_*.
+//        A
+//    F H J K B      H, K, N, L are the diagonals
+//     G1   G2
+//    E N M L C
+//        D     DP
+enum : uint16_t {
+  SEG_A  = 0x0001, SEG_B  = 0x0002, SEG_C  = 0x0004, SEG_D  = 0x0008,
+  SEG_E  = 0x0010, SEG_F  = 0x0020, SEG_G1 = 0x0040, SEG_G2 = 0x0080,
+  SEG_H  = 0x0100, SEG_J  = 0x0200, SEG_K  = 0x0400, SEG_L  = 0x0800,
+  SEG_M  = 0x1000, SEG_N  = 0x2000, SEG_DP = 0x4000,
+  SEG_G  = SEG_G1 | SEG_G2
+};
+uint16_t display_glyph(char c);                              // font word for one ASCII char
+void display_glyphs(uint16_t* out, const char* s, uint8_t n); // n words, blank past the end of s
+void display_glyphs_P(uint16_t* out, PGM_P s, uint8_t n);
+void display_segments_owned(const char* owner, const uint16_t* w4);
+void display_segments_owned_P(const char* owner, const uint16_t* w4);  // w4 in PROGMEM
+
+// Hardware effects. The HT16K33 blinks the whole display by itself, so a
+// flashing word is one text write plus one blink write, not a write per
+// toggle. Blink and a running ramp belong to the owner that set them and
+// end when the display changes hands; a new owner starts steady.
+enum DisplayBlink : uint8_t {
+  DISP_BLINK_OFF    = 0,   // HT16K33 blink codes
+  DISP_BLINK_2HZ    = 1,
+  DISP_BLINK_1HZ    = 2,
+  DISP_BLINK_HALFHZ = 3
+};
+bool display_blink_owned(const char* owner, DisplayBlink rate);
+// Step brightness to 'level' over ms, one write per level, paced by display_update()
+bool display_ramp_owned(const char* owner, uint8_t level, uint32_t ms);
+bool display_ramping();
+
+// Idle blink, the free-display counterpart of the base brightness: applies
+// while nobody owns the display and comes back when the owner lets go.
+void display_set_blink(DisplayBlink rate);
+
+// Advance a brightness ramp; call every loop pass
+void display_update();
+
+// Base brightness (settings BRIGHT). Applied now if the display is free,
+// otherwise when the current owner releases or expires.
+void display_set_brightness(uint8_t level); // 0..15
+
 // Convenience: write idle text only if the display is free
 void display_idle(const char* s4);
+void display_idle_P(PGM_P s4);   // same, text in flash
 
 // Optional direct print without ownership check (used internally)
-void display_print4_unchecked(const char* s4);
\ No newline at end of file
+void display_print4_unchecked(const char* s4);
+
+// Owner, text, brightness, blink, I2C writes and arbitration counters (DISP command)
+void display_print_stats(Stream& s);
@@ -0,0 +1,14 @@
+#pragma once
+
+// ================= EEPROM map (Mega 2560, 4096 bytes) =================
+// Settings journal: wear-leveled TLV records, see settings.cpp
+#define EE_SETTINGS_BASE   0
+#define EE_SETTINGS_BYTES  2048
+
+// Event journal checkpoint: two alternating snapshots of the RAM ring, see eventlog.cpp
+#define EE_EVLOG_BASE      2048
+#define EE_EVLOG_BYTES     1024
+
+// Scene VM image: directory + bytecode, see scenevm.hpp
+#define EE_SVM_BASE        3072
+#define EE_SVM_BYTES       1024
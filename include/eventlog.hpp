@@ -0,0 +1,53 @@
+#pragma once
+#include <Arduino.h>
+
+// Binary event journal: fixed RAM ring of 8-byte records, O(1) append,
+// no formatting on the hot path. LOG DUMP streams it to the host where
+// docs/hh_log_stats.py turns it into per-night statistics.
+//
+// Record (little endian): [dt_ms u16][type u8][id u8][arg u32]
+//   dt_ms is the time since the previous record. A gap longer than
+//   65535 ms is bridged by an EV_TIME record whose arg is absolute millis().
+//
+// Dump framing, after the text line "LOG DUMP <n>":
+//   "HHLOG" [ver u8 = 1][n u16][t0_ms u32 = absolute time of record 0]
+//   [n records][crc16 (Modbus) over everything from ver]
+// then the text line "OK LOG DUMP".
+
+#ifndef HH_EVLOG_RECORDS
+#define HH_EVLOG_RECORDS 64   // 512 bytes of SRAM
+#endif
+
+enum EvType : uint8_t {
+  EV_TIME        = 0,   // arg = absolute millis(), bridges long gaps
+  EV_BOOT        = 1,   // id = stalled loop stage, arg bit0 = warm resume, bits 8..15 = MCUSR
+  EV_TRIP        = 2,   // id = beam, arg = ms from raw edge to fire
+  EV_TRIP_LOCKED = 3,   // id = beam, arg = ms since last fire (inside re-arm)
+  EV_REED        = 4,   // id = 6, arg = 1 closed / 0 open
+  EV_SCENE       = 5,   // id = scene code (scenes.hpp), arg = phase
+  EV_PI_ACK      = 6,   // id = PiLink type, arg = round trip us
+  EV_PI_FAIL     = 7,   // id = PiLink type, arg = tries
+  EV_MARK        = 8,   // id/arg free, operator note from LOG MARK
+  EV_DISPLAY     = 9,   // id = owner priority, arg = first 4 chars of owner (0 = released)
+  EV_OUTPUT      = 10   // id = pin, arg = level, or pulse ms for Pi triggers
+};
+
+// Scene phases carried in EV_SCENE arg
+enum EvPhase : uint8_t { EVP_IDLE = 0, EVP_START = 1, EVP_COOLDOWN = 2, EVP_END = 3 };
+
+void evlog_begin();
+
+// Append one record. Safe to call from any loop() path, not from ISRs.
+void evlog_add(uint8_t type, uint8_t id, uint32_t arg = 0);
+
+// Call every loop(): advances a pending EEPROM checkpoint by one byte
+void evlog_update();
+
+// Periodic EEPROM checkpoint, 0 = off (default)
+void evlog_set_checkpoint_minutes(uint16_t minutes);
+
+// Stream the RAM ring (from_eeprom = false) or the newest valid checkpoint
+bool evlog_dump(Stream& s, bool from_eeprom);
+
+void evlog_clear();
+void evlog_print_status(Stream& s);
@@ -0,0 +1,39 @@
+#pragma once
+#include <Arduino.h>
+
+// Hardware-timed actuation windows on Timer5.
+// Timer5 free-runs at F_CPU/64 (4 us ticks at 16 MHz) with an overflow
+// count on top, giving a 32-bit tick clock. Its three output-compare
+// channels (OCR5A/B/C) are one-shot slots: each sets a pin at T and clears
+// it at T + width from the compare interrupt, so the edges land within a
+// few microseconds whatever loop() is doing. The OC5x pins (D44..D46) stay
+// disconnected. Windows up to about 2 hours; longer ones wrap.
+//
+// While a slot holds a pin nothing else may write that pin's PORT bit;
+// outputs.cpp releases it from the output frame for the window.
+
+static const uint8_t HWT_SLOTS = 3;
+
+// Start Timer5. Call once from setup() before any window.
+void hwtimer_begin();
+
+// Tick clock, 4 us per tick
+uint32_t hwtimer_ticks();
+
+// Set pin to its active level delay_us from now and back width_us after that.
+// Returns the slot, or -1 when all three are busy (caller falls back to software).
+int8_t hwtimer_window(uint8_t pin, bool active_high, uint32_t delay_us, uint32_t width_us);
+
+// Move a running window's clear edge to us from now (fires at once if already due).
+// False when the slot is idle.
+bool hwtimer_clear_in(int8_t slot, uint32_t us);
+
+// Stop a window without touching the pin. Returns true if the pin was left
+// active (set edge done, clear edge not).
+bool hwtimer_cancel(int8_t slot);
+
+// Slot still has an edge to fire
+bool hwtimer_busy(int8_t slot);
+
+// Slots, windows, fallbacks and actual-minus-requested edge error
+void hwtimer_print(Stream& s);
@@ -1,9 +1,66 @@
 #pragma once
 #include <Arduino.h>
 
-// Beams and reed initialization and per-loop update
+// Beams and reed initialization and per-loop update.
+// inputs_init() touches no serial or I2C so it can run first at boot.
 void inputs_init();
 void inputs_update();
 
+// Warm restart: ms since a beam last fired (INPUTS_NEVER_FIRED if not
+// since boot), and the inverse so the re-arm lockout survives a reset.
+static const uint32_t INPUTS_NEVER_FIRED = 0xFFFFFFFFUL;
+uint32_t inputs_fire_age(uint8_t beam);
+void inputs_resume_fire_age(uint8_t beam, uint32_t age_ms);
+
+// Debounced levels: bit i set while beam i (0..5) is broken, bit 6 while the reed is closed
+uint8_t inputs_beam_mask();
+
+// Startup banner, printed once the console is up
+void inputs_print_banner();
+
+// Live timing (settings apply callbacks, no reboot needed).
+// Beams 0..5 debounce adaptively between the minimum and the ceiling, by
+// the longest bounce seen lately; the reed always uses the ceiling.
+void inputs_set_debounce(uint16_t ms);       // ceiling (SDEB)
+void inputs_set_debounce_min(uint16_t ms);   // floor for clean beams (SDEBMIN)
+void inputs_set_rearm(uint32_t ms);
+
+// Re-arm policy, one byte per beam 0..5. After a beam fires, its next break
+// is accepted only when the enabled conditions hold (any of them, or all
+// with REARM_ALL); otherwise it is suppressed and logged as TRIP_LOCKED.
+//   TIME   SREARM ms have passed since it fired (the classic lockout)
+//   CLEAR  the beam stayed clear for the clear time before this break,
+//          so stragglers walking through keep it deaf
+//   DOWN   its downstream beam (high nibble, 0..5, 0xF none) broke since
+//          it fired: the group reached the next room. Ignored while there
+//          is no downstream beam, so it can never lock a beam for good
+// No condition bits means every settled break fires.
+enum : uint8_t {
+  REARM_TIME  = 0x01,
+  REARM_CLEAR = 0x02,
+  REARM_DOWN  = 0x04,
+  REARM_ALL   = 0x08,
+  REARM_NONE_NEXT = 0xF0,
+  REARM_DEFAULT   = REARM_NONE_NEXT | REARM_TIME
+};
+#define REARM_NEXT(p) ((uint8_t)(p) >> 4)
+void inputs_set_rearm_policy(const uint8_t* policy);   // 6 bytes
+void inputs_set_rearm_clear(uint16_t ms);
+
+// Policies plus accepted and suppressed trips per beam (REARM command)
+void inputs_print_rearm(Stream& s);
+
+// Leading-edge trigger for beams in mask (bit i = beam i): the scene fires as
+// soon as a break has lasted min_pulse_us (glitch rejection, measured from the
+// edge's micros() stamp) instead of after the debounce window. Debounce and
+// re-arm hold-off then apply to the release and to the next break.
+void inputs_set_instant(uint8_t mask);
+void inputs_set_min_pulse(uint16_t us);
+
+// Per-beam window, trips, bounce histogram, chatter and short-break counts (BEAMSTAT).
+// Reset also clears the REARM accepted/suppressed counters.
+void inputs_print_stats(Stream& s);
+void inputs_stats_reset();
+
 // Print current beam -> scene mapping and pins to Serial
 void inputs_print_map();
\ No newline at end of file
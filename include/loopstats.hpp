@@ -0,0 +1,19 @@
+#pragma once
+#include <Arduino.h>
+#include "recovery.hpp"   // LoopStage
+
+// Loop timing and RAM headroom, for soak and stress runs (LOOP command).
+// main.cpp marks each stage as it starts; the time until the next mark is
+// charged to that stage. A pass is LOOP_CONSOLE up to LOOP_IDLE, so the
+// trailing delay(1) is not counted as work.
+void loopstats_mark(LoopStage s);
+
+// Zero all maxima and counters (LOOP RESET)
+void loopstats_reset();
+
+// Worst pass and pass count since the previous call, then restarts the
+// window (telemetry loop channel; independent of LOOP RESET)
+void loopstats_window(uint32_t& max_us, uint16_t& passes);
+
+// Worst and average pass, per-stage worst, lowest free RAM seen
+void loopstats_print(Stream& s);
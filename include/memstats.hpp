@@ -0,0 +1,19 @@
+#pragma once
+#include <Arduino.h>
+
+// SRAM headroom on the Mega's 8 KB: the stack grows down from RAMEND and the
+// heap (Arduino String) grows up from the end of .bss. RAM between them is
+// painted with a canary before main(), so the deepest the stack has ever
+// reached can be read back later. The MEM command prints all of it.
+
+// Free bytes between the heap break and the stack pointer right now
+uint16_t mem_free_now();
+
+// Smallest gap ever seen between heap and stack (untouched canary bytes)
+uint16_t mem_lowest_gap();
+
+// Repaint the current gap so the next low-water reading starts from now
+void mem_repaint();
+
+// Sections, heap, free list, stack depth and fragmentation
+void mem_print(Stream& s);
@@ -0,0 +1,62 @@
+#pragma once
+#include <Arduino.h>
+#include "pin_traits.hpp"
+
+// Output frame. Modules write pin levels and PWM duties into shadow port
+// images during a loop pass; outframe_flush() at the end of the pass writes
+// each changed PORTx once, all ports inside one interrupt-locked block, so
+// every output set in a pass changes together. A pin written several times
+// in one pass (an LED set by effects and then by the scene) reaches the
+// port once with its last value. outframe_write<PIN>() is a load, a mask
+// and a compare; an unchanged level never reaches a register.
+//
+// Only bits the frame owns are touched, so tone() on the buzzer and the
+// display bus keep their own pins on a shared port.
+
+// Take pin into the frame and drive it to high now (PORT before DDR, no glitch)
+void outframe_claim(uint8_t pin, bool high = false);
+
+// Hand pin back: flushes stop touching it until the next outframe_claim()
+// (a hardware timer drives it meanwhile)
+void outframe_release(uint8_t pin);
+
+// Level for the next flush
+void outframe_write(uint8_t pin, bool high);
+
+// Port number and bit for a runtime pin, looked up once (false if the pin has no port)
+bool outframe_locate(uint8_t pin, uint8_t& port, uint8_t& mask);
+
+// Shadow state, for the inline writers below
+static const uint8_t OUTFRAME_PORTS = 13;         // Arduino port numbers, PA = 1 .. PL = 12
+extern uint8_t  g_outframe_img[OUTFRAME_PORTS];
+extern uint8_t  g_outframe_pwm[OUTFRAME_PORTS];
+extern uint16_t g_outframe_dirty;
+
+// Level by port and bit from outframe_locate() or Pin<>; the pin must be claimed
+inline void outframe_mark(uint8_t port, uint8_t mask, bool high) {
+  const uint8_t img = high ? (g_outframe_img[port] | mask) : (g_outframe_img[port] & ~mask);
+  if (img != g_outframe_img[port]) { g_outframe_img[port] = img; g_outframe_dirty |= (uint16_t)1 << port; }
+}
+
+// outframe_write<PIN>(level): port and bit are constants, no table lookup.
+// A pin whose timer output is running takes the slow path to disconnect it.
+template <uint8_t N>
+inline void outframe_write(bool high) {
+  typedef Pin<N> P;
+  if (pin_traits::pwm_capable(N) && (g_outframe_pwm[P::port] & P::mask)) { outframe_write(N, high); return; }
+  outframe_mark(P::port, P::mask, high);
+}
+
+// PWM duty for the next flush. 0 and 255 are plain levels and go out as
+// port bits; analogWrite() runs only when a timer output has to connect
+// or disconnect. A pin without a timer gets duty >= 128 as HIGH.
+void outframe_pwm(uint8_t pin, uint8_t duty);
+
+// Level last written for pin (what the port shows after the last flush)
+bool outframe_level(uint8_t pin);
+
+// Write the changed ports. Called once per loop pass.
+void outframe_flush();
+
+// Flushes with a change, port and PWM register writes
+void outframe_print(Stream& s);
@@ -0,0 +1,47 @@
+#pragma once
+#include <Arduino.h>
+
+// Timed digital outputs: Pi trigger optos, the lab magnet, camera and
+// recorder relays. Each channel is one pin with at most one pending edge.
+// Pending edges sit in a min-heap ordered by deadline, so outputs_update()
+// is one compare against the heap top when nothing is due. Deadlines are
+// millis() compared as signed differences and stay correct across the
+// 49-day wrap as long as no single timing exceeds 24 days.
+//
+// Every edge is logged as EV_OUTPUT: a pulse once with its length, levels
+// (1 / 0) for on, off and hold.
+
+static const uint8_t OUTPUTS_MAX = 10;
+
+// Claim a channel for pin and drive it idle. name is a flash string (PSTR)
+// used by the OUT command. With hw_timed, pulses and holds are handed to a
+// free Timer5 slot (hwtimer.hpp) so both edges are exact to a few us; the
+// software deadline then only keeps the books. Returns the channel, or -1
+// when the table is full.
+int8_t outputs_add(uint8_t pin, PGM_P name, bool active_high = true, bool hw_timed = false);
+
+// Registers the GOPRO and REC relay channels
+void outputs_begin();
+
+void outputs_on(uint8_t ch);                   // on until outputs_off, drops any pending edge
+void outputs_off(uint8_t ch);                  // off now, drops any pending edge
+void outputs_pulse(uint8_t ch, uint32_t ms);   // on now, off ms later; restarts a running pulse
+void outputs_hold_for(uint8_t ch, uint32_t ms);// on now, off no sooner than ms from now (never shortens)
+bool outputs_extend(uint8_t ch, uint32_t ms);  // push a pending off edge ms later; false if not timed on
+
+// Pre-roll: off now, on after delay_ms, off ms later. A camera started
+// with outputs_hold_for() and a cue scheduled this way gives the camera
+// delay_ms of footage before the scare.
+void outputs_pulse_after(uint8_t ch, uint32_t delay_ms, uint32_t ms);
+
+bool     outputs_is_on(uint8_t ch);
+uint32_t outputs_remaining(uint8_t ch);        // ms to the pending edge, 0 if none
+
+// Channel by uppercase name or number, -1 if unknown
+int8_t outputs_find(const char* up);
+
+// Call every loop(): fires edges that are due
+void outputs_update();
+
+// Channel table and service counters (OUT command)
+void outputs_print(Stream& s);
@@ -0,0 +1,40 @@
+#pragma once
+#include <Arduino.h>
+
+// Mega -> Pi framed command link on a spare UART (default Serial1, D18 TX / D19 RX).
+// Runs alongside the opto GPIO lines in triggers.cpp. Every frame carries a
+// sequence number and is acknowledged by the Pi; unacked frames are resent.
+//
+// Frame: [0x7E][seq][type][len][payload 0..PILINK_MAX_PAYLOAD][crc8]
+//   crc8 (poly 0x07) covers seq, type, len and payload.
+//   The Pi answers with type PILINK_ACK (payload[0] = status, 0 = started)
+//   or PILINK_NAK, echoing the sequence number of the frame it answers.
+
+static const uint8_t PILINK_MAX_PAYLOAD = 16;
+
+enum PiLinkType : uint8_t {
+  PILINK_PING  = 0x01,   // no payload, round-trip check
+  PILINK_CUE   = 0x02,   // payload[0] = cue number (0..4 match SHOW..FRANKEN)
+  PILINK_START = 0x03,   // payload = ASCII sequence/playlist name
+  PILINK_STOP  = 0x04,   // no payload, stop current sequence
+  PILINK_ACK   = 0x80,
+  PILINK_NAK   = 0x81
+};
+
+// Open the UART and reset counters
+void pilink_begin(HardwareSerial& port = Serial1, unsigned long baud = 115200);
+
+// Call every loop(): parses acks and resends timed-out frames
+void pilink_update();
+
+// Queue a frame. Returns false when all in-flight slots are busy or len is too long.
+bool pilink_send(uint8_t type, const uint8_t* payload = nullptr, uint8_t len = 0);
+
+// Convenience wrappers
+bool pilink_ping();
+bool pilink_cue(uint8_t cue);
+bool pilink_start(const char* name);
+bool pilink_stop();
+
+// Print counters and per-command round-trip times
+void pilink_print_stats(Stream& s);
@@ -0,0 +1,107 @@
+#pragma once
+#include <Arduino.h>
+
+// Compile-time pin descriptors for the Mega 2560.
+// Pin<N> resolves Arduino pin N to its port, bit mask and PINx / DDRx / PORTx
+// addresses as constants. On ports A..G, read() is a single in (or sbis/sbic
+// when it feeds a branch) and high() / low() are one sbi / cbi. Ports H, J,
+// K and L sit above the I/O space: a read there is lds (2 cycles) plus a bit
+// test, and writes are lds/ori/sts, made atomic.
+// A pin number the board does not have fails to compile.
+//
+// Port numbers match the Arduino core's (PA = 1 .. PL = 12, no PI), so they
+// index the same tables as digitalPinToPort().
+
+namespace pin_traits {
+
+// (port << 3) | bit for digital pins 0..69, from the core's mega variant
+constexpr uint8_t MEGA_MAP[70] = {
+  5<<3|0,  5<<3|1,  5<<3|4,  5<<3|5,  7<<3|5,  5<<3|3,  8<<3|3,  8<<3|4,   //  0..7   PE PE PE PE PG PE PH PH
+  8<<3|5,  8<<3|6,  2<<3|4,  2<<3|5,  2<<3|6,  2<<3|7,  10<<3|1, 10<<3|0,  //  8..15  PH PH PB PB PB PB PJ PJ
+  8<<3|1,  8<<3|0,  4<<3|3,  4<<3|2,  4<<3|1,  4<<3|0,  1<<3|0,  1<<3|1,   // 16..23  PH PH PD PD PD PD PA PA
+  1<<3|2,  1<<3|3,  1<<3|4,  1<<3|5,  1<<3|6,  1<<3|7,  3<<3|7,  3<<3|6,   // 24..31  PA ... PC
+  3<<3|5,  3<<3|4,  3<<3|3,  3<<3|2,  3<<3|1,  3<<3|0,  4<<3|7,  7<<3|2,   // 32..39  PC ... PD PG
+  7<<3|1,  7<<3|0,  12<<3|7, 12<<3|6, 12<<3|5, 12<<3|4, 12<<3|3, 12<<3|2,  // 40..47  PG PG PL ...
+  12<<3|1, 12<<3|0, 2<<3|3,  2<<3|2,  2<<3|1,  2<<3|0,  6<<3|0,  6<<3|1,   // 48..55  PL PL PB ... PF (A0)
+  6<<3|2,  6<<3|3,  6<<3|4,  6<<3|5,  6<<3|6,  6<<3|7,  11<<3|0, 11<<3|1,  // 56..63  PF ... PK (A8)
+  11<<3|2, 11<<3|3, 11<<3|4, 11<<3|5, 11<<3|6, 11<<3|7                     // 64..69  PK
+};
+
+// Data-space address of PINx for port 1..12 (DDRx = +1, PORTx = +2); 0 = no such port
+constexpr uint16_t PIN_ADDR[13] = {
+  0, 0x20, 0x23, 0x26, 0x29, 0x2C, 0x2F, 0x32, 0x100, 0, 0x103, 0x106, 0x109
+};
+
+// True when no two entries of pins[0..n) are equal
+constexpr bool distinct(const uint8_t* pins, uint8_t n, uint8_t i = 0, uint8_t j = 1) {
+  return i + 1 >= n ? true
+       : j >= n     ? distinct(pins, n, i + 1, i + 2)
+       : pins[i] != pins[j] && distinct(pins, n, i, j + 1);
+}
+
+// True when none of pins[0..n) is x
+constexpr bool absent(const uint8_t* pins, uint8_t n, uint8_t x) {
+  return n == 0 ? true : pins[n - 1] != x && absent(pins, n - 1, x);
+}
+
+// Every entry of pins[0..n) is a Mega digital pin
+constexpr bool all_valid(const uint8_t* pins, uint8_t n) {
+  return n == 0 ? true : pins[n - 1] < 70 && all_valid(pins, n - 1);
+}
+
+// Pin has a timer output for analogWrite()
+constexpr bool pwm_capable(uint8_t n) { return (n >= 2 && n <= 13) || (n >= 44 && n <= 46); }
+
+} // namespace pin_traits
+
+template <uint8_t N>
+struct Pin {
+  static_assert(N < 70, "not a digital pin on the Mega 2560");
+  static_assert(pin_traits::PIN_ADDR[pin_traits::MEGA_MAP[N] >> 3] != 0, "pin table has no port for this pin");
+
+  static constexpr uint8_t  num       = N;
+  static constexpr uint8_t  port      = pin_traits::MEGA_MAP[N] >> 3;
+  static constexpr uint8_t  mask      = 1 << (pin_traits::MEGA_MAP[N] & 7);
+  static constexpr uint16_t pin_addr  = pin_traits::PIN_ADDR[port];
+  static constexpr uint16_t ddr_addr  = pin_addr + 1;
+  static constexpr uint16_t port_addr = pin_addr + 2;
+  static constexpr bool     sbi_ok    = port_addr < 0x40;   // I/O space 0x00..0x1F
+
+#if defined(__AVR__)
+  static inline volatile uint8_t& PINx()  { return *reinterpret_cast<volatile uint8_t*>(pin_addr); }
+  static inline volatile uint8_t& DDRx()  { return *reinterpret_cast<volatile uint8_t*>(ddr_addr); }
+  static inline volatile uint8_t& PORTx() { return *reinterpret_cast<volatile uint8_t*>(port_addr); }
+
+  static inline void set_bit(volatile uint8_t& r, bool on) {
+    if (sbi_ok) { if (on) r |= mask; else r &= ~mask; return; }
+    const uint8_t sreg = SREG;
+    cli();
+    if (on) r |= mask; else r &= ~mask;
+    SREG = sreg;
+  }
+
+  static inline bool read()          { return PINx() & mask; }
+  static inline void high()          { set_bit(PORTx(), true); }
+  static inline void low()           { set_bit(PORTx(), false); }
+  static inline void toggle()        { PINx() = mask; }       // writing 1 to PINx flips PORTx
+  static inline void output()        { set_bit(DDRx(), true); }
+  static inline void input()         { set_bit(DDRx(), false); set_bit(PORTx(), false); }
+  static inline void input_pullup()  { set_bit(DDRx(), false); set_bit(PORTx(), true); }
+#else
+  // Host builds and simulators without the register file
+  static inline bool read()          { return digitalRead(N); }
+  static inline void high()          { digitalWrite(N, HIGH); }
+  static inline void low()           { digitalWrite(N, LOW); }
+  static inline void toggle()        { digitalWrite(N, !digitalRead(N)); }
+  static inline void output()        { pinMode(N, OUTPUT); }
+  static inline void input()         { pinMode(N, INPUT); }
+  static inline void input_pullup()  { pinMode(N, INPUT_PULLUP); }
+#endif
+
+  static inline void write(bool on)  { if (on) high(); else low(); }
+};
+
+// Time digitalRead/digitalWrite against Pin<> on the spare onboard LED (D13,
+// PORTB), plus a Pin<> read of beam D7 on PORTH, and print cycles per call
+// (PINBENCH command).
+void pin_bench(Stream& s);
@@ -1,5 +1,6 @@
 #pragma once
 #include <Arduino.h>
+#include "pin_traits.hpp"
 
 // ================= Sensors =================
 // Beams 0..5 (active LOW with INPUT_PULLUP)
@@ -18,6 +19,11 @@
 #define PIN_MAGNET_CTRL 6
 #define PIN_BUZZER      8
 
+// Camera and recorder relays (outputs GOPRO / REC). 255 = not wired:
+// the channel exists for OUT and scenes but never touches a pin.
+#define PIN_GOPRO_RELAY    255
+#define PIN_RECORDER_RELAY 255
+
 // Status LEDs
 #define LED_ARMED    10  // green
 #define LED_HOLD     11  // red
@@ -28,6 +34,46 @@
 #define PIN_TECHLIGHT 26
 #define TECHLIGHT_ACTIVE_HIGH 1  // set to 0 if your relay is active LOW
 
+// Mega -> Pi GPIO trigger outputs (optos), active HIGH
+#define PIN_TRIG_SHOW    27
+#define PIN_TRIG_BLOOD   22
+#define PIN_TRIG_GRAVE   23
+#define PIN_TRIG_FUR     24
+#define PIN_TRIG_FRANKEN 25
+
 // I2C pins for Mega 2560 (hardware-defined)
 #define I2C_SDA_PIN 20
-#define I2C_SCL_PIN 21
\ No newline at end of file
+#define I2C_SCL_PIN 21
+
+// ================= Compile-time descriptors =================
+// Hot paths use these (pin_traits.hpp): one instruction per access.
+typedef Pin<PIN_BEAM_0>      BeamPin0;
+typedef Pin<PIN_BEAM_1>      BeamPin1;
+typedef Pin<PIN_BEAM_2>      BeamPin2;
+typedef Pin<PIN_BEAM_3>      BeamPin3;
+typedef Pin<PIN_BEAM_4>      BeamPin4;
+typedef Pin<PIN_BEAM_5>      BeamPin5;
+typedef Pin<PIN_BEAM_6>      ReedPin;
+typedef Pin<PIN_MAGNET_CTRL> MagnetPin;
+typedef Pin<PIN_BUZZER>      BuzzerPin;
+typedef Pin<LED_ARMED>       LedArmedPin;
+typedef Pin<LED_HOLD>        LedHoldPin;
+typedef Pin<LED_COOLDOWN>    LedCooldownPin;
+typedef Pin<PIN_TECHLIGHT>   TechLightPin;
+
+// A pin used twice, or one taken from Serial (0, 1), the Pi link on
+// Serial1 (18, 19) or I2C, is a build error.
+namespace pin_traits {
+constexpr uint8_t USED_PINS[] = {
+  PIN_BEAM_0, PIN_BEAM_1, PIN_BEAM_2, PIN_BEAM_3, PIN_BEAM_4, PIN_BEAM_5, PIN_BEAM_6,
+  PIN_MAGNET_CTRL, PIN_BUZZER, LED_ARMED, LED_HOLD, LED_COOLDOWN, PIN_TECHLIGHT,
+  PIN_TRIG_SHOW, PIN_TRIG_BLOOD, PIN_TRIG_GRAVE, PIN_TRIG_FUR, PIN_TRIG_FRANKEN
+};
+constexpr uint8_t N_USED = sizeof(USED_PINS);
+static_assert(all_valid(USED_PINS, N_USED), "pins.hpp: not a Mega 2560 digital pin");
+static_assert(distinct(USED_PINS, N_USED), "pins.hpp: a pin is assigned twice");
+static_assert(absent(USED_PINS, N_USED, 0) && absent(USED_PINS, N_USED, 1), "pins.hpp: D0/D1 are the USB console");
+static_assert(absent(USED_PINS, N_USED, 18) && absent(USED_PINS, N_USED, 19), "pins.hpp: D18/D19 are the Pi link (Serial1)");
+static_assert(absent(USED_PINS, N_USED, I2C_SDA_PIN) && absent(USED_PINS, N_USED, I2C_SCL_PIN), "pins.hpp: D20/D21 are I2C");
+static_assert(pwm_capable(LED_ARMED) && pwm_capable(LED_HOLD) && pwm_capable(LED_COOLDOWN), "pins.hpp: status LEDs need PWM pins");
+} // namespace pin_traits
@@ -0,0 +1,51 @@
+#pragma once
+#include <Arduino.h>
+
+// Seedable xorshift32 generator with one independent stream per effect.
+// A draw is shifts and xors on a 4-byte state, no multiply; prng_below()
+// maps it onto a range with one 16x16 multiply instead of random()'s
+// 32-bit division. Streams are seeded from one 32-bit seed, so the same
+// seed replays the same flicker, drips and display digits, and one effect
+// drawing more often does not shift another's sequence.
+
+enum PrngStream : uint8_t {
+  PRNG_EFFECTS = 0,   // rand_between() in effects.cpp
+  PRNG_BLOOD,         // blood drip spike spacing
+  PRNG_SPIDER,        // spider crawl blink spacing
+  PRNG_FRANK_LED,     // Frankenphone cooldown LED flicker
+  PRNG_FRANK_TONE,    // modem noise
+  PRNG_FRANK_TEXT,    // card digits, dates and PIN windows on the display
+  PRNG_STREAMS
+};
+
+extern uint32_t g_prng[PRNG_STREAMS];
+
+// Next 32 bits from stream s
+inline uint32_t prng_next(uint8_t s) {
+  uint32_t x = g_prng[s];
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return g_prng[s] = x;
+}
+
+// Uniform in [0, n): high 16 bits scaled by n (bias below n / 65536, no division)
+inline uint16_t prng_below(uint8_t s, uint16_t n) {
+  return (uint16_t)(((uint32_t)(uint16_t)(prng_next(s) >> 16) * n) >> 16);
+}
+
+// Uniform in [lo, hi), as random(lo, hi); the span must fit in 16 bits
+inline int32_t prng_range(uint8_t s, int32_t lo, int32_t hi) {
+  return hi > lo ? lo + prng_below(s, (uint16_t)(hi - lo)) : lo;
+}
+
+// Reseed every stream from seed (0 is allowed)
+void prng_seed(uint32_t seed);
+uint32_t prng_seed_value();
+
+// Boot seed: ADC noise on the floating A0, Timer5 ticks and micros() across
+// the conversions, mixed; better than a single analogRead(A0)
+uint32_t prng_entropy();
+
+// Cycles per call for random() against the streams (PRNGBENCH command)
+void prng_bench(Stream& s);
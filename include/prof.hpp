@@ -0,0 +1,29 @@
+#pragma once
+#include <Arduino.h>
+
+// Profiling markers for the experimental cycle benchmark
+// (docs/experimental/simavr/hh_simbench.c, never run yet).
+// Built with -DHH_PROF_MARKERS a marker is one OUT to
+// GPIOR0, a general purpose I/O register nothing else uses; the simulator
+// timestamps every write in CPU cycles. In the normal build they compile away.
+//
+// Marker values:
+//   1..15        loop stage transition (LoopStage, recovery.hpp)
+//   0x40 | id    region begin
+//   0xC0 | id    region end
+// Regions nest inside a stage and are reported on their own.
+
+enum ProfRegion : uint8_t {
+  PROF_I2C   = 1,   // display transfer to the HT16K33
+  PROF_FLUSH = 2,   // outframe_flush
+  PROF_SVM   = 3    // bytecode scene step
+};
+
+#if defined(HH_PROF_MARKERS) && defined(__AVR__)
+#define PROF_MARK(v) (GPIOR0 = (uint8_t)(v))
+#else
+#define PROF_MARK(v) ((void)0)
+#endif
+
+#define PROF_BEGIN(r) PROF_MARK(0x40 | (r))
+#define PROF_END(r)   PROF_MARK(0xC0 | (r))
@@ -0,0 +1,44 @@
+#pragma once
+#include <Arduino.h>
+
+// Watchdog and warm restart.
+// The AVR watchdog runs with a 1 s window and loop() kicks it every pass.
+// If a pass stalls (for example a Wire hang on the display bus), the
+// watchdog interrupt records which loop stage was running and resets the
+// board. Scene phase, beam re-arm ages and TechLight state are mirrored
+// into a CRC-checked .noinit block every 20 ms, so after any reset other
+// than power-on the show resumes where it was instead of coming back cold.
+
+enum LoopStage : uint8_t {
+  LOOP_NONE = 0,
+  LOOP_CONSOLE,
+  LOOP_INPUTS,
+  LOOP_PILINK,
+  LOOP_SCENE,
+  LOOP_SETTINGS,
+  LOOP_BOOT,
+  LOOP_TELEMETRY,
+  LOOP_OUTPUTS,
+  LOOP_IDLE
+};
+
+// Call from setup() once modules and settings are up. Restores the
+// snapshot when it is valid, then enables the watchdog.
+// Returns true on a warm resume.
+bool recovery_begin();
+
+// Call every loop(): kicks the watchdog and refreshes the snapshot
+void recovery_update();
+
+// Short name for a LoopStage ("-" for LOOP_NONE, "?" if out of range), in flash
+const __FlashStringHelper* loop_stage_name(uint8_t s);
+
+// Mark the loop stage about to run, for stall attribution
+extern volatile uint8_t g_recovery_stage;
+inline void recovery_stage(LoopStage s) { g_recovery_stage = s; }
+
+// Kick the watchdog from console commands that block on purpose
+void recovery_kick();
+
+// Reset cause, counters and last stall for the WDT command
+void recovery_print(Stream& s);
@@ -44,6 +44,7 @@ void scene_mirror();
 void scene_phoneLoading();
 void scene_intro();
 void scene_blood();
+bool scene_blood_active();   // DRIP animation running (telemetry)
 void scene_graveyard();
 void scene_fur();
 void scene_orca();
@@ -0,0 +1,89 @@
+#pragma once
+#include <Arduino.h>
+
+// Bytecode scene VM. Rooms written as text scenes (docs/hh_scenec.py) run
+// here without a reflash: the host compiles them to a small image and
+// loads it into EEPROM over the console (SVM LOAD / W / COMMIT), or bakes
+// it into flash with -DHH_SVM_FLASH (include/svm_image.h from --header).
+// An EEPROM image wins over the flash one.
+//
+// One program runs at a time from svm_update(), at most HH_SVM_BUDGET
+// instructions per loop pass; a program that has not waited by then is
+// resumed on the next pass. Waits are cursor based, so a long chain of
+// WAITs stays locked to the start cue however late the loop runs.
+//
+// Image (little endian), at most EE_SVM_BYTES:
+//   [0x53 'S'][0x56 'V'][ver = 2][nprog 1..8][code len u16][crc16 u16]
+//   nprog x [name 4 chars][beam u8, 0xFF none][0][entry u16]
+//   [nchan 0..OUTPUTS_MAX] nchan x [output name 8 chars, space padded]
+//   [code]
+//   crc16 (Modbus) covers the directory, channel table and code. COMMIT checks
+//   it and walks the code once, so a program that loads cannot jump
+//   mid-instruction or run off its end. Channel names are looked up in the
+//   OUT table when the image is opened, so the image does not depend on the
+//   order channels were registered in; a name the firmware lacks rejects it.
+//
+// Opcodes, operands follow the opcode byte:
+//   00 END                         release display, log the scene end
+//   01 WAIT      ms u16
+//   02 OUT       ch u8, on u8      outputs_on/off (ch indexes the channel table)
+//   03 PULSE     ch u8, ms u16     outputs_pulse
+//   04 HOLD      ch u8, ms u16     outputs_hold_for
+//   05 RGB       r, g, b
+//   06 FADE      r, g, b, ms u16   RGB ramp in the background, the program runs on
+//   07 DISP      4 chars           takes the display as "SVM"
+//   08 PICUE     cue u8            pilink_cue
+//   09 PISTART   len u8, chars     pilink_start
+//   0A TRIG      idx u8, ms u16    opto trigger pulse (SHOW..FRANKEN)
+//   0B WAITBEAM  mask u8, ms u16   until a beam in mask breaks (flag set) or ms
+//                                  pass (flag clear); 0 ms waits forever
+//   0C JMP       addr u16          code offsets
+//   0D JT        addr u16          jump if flag
+//   0E JF        addr u16          jump if not flag
+//   0F REPEAT    n u8              loop counter
+//   10 DJNZ      addr u16          --counter, jump while nonzero
+//   11 LOG       id u8             EV_MARK in the event log
+
+#ifndef HH_SVM_BUDGET
+#define HH_SVM_BUDGET 16   // instructions per loop pass
+#endif
+
+enum SvmOp : uint8_t {
+  SVM_END = 0, SVM_WAIT, SVM_OUT, SVM_PULSE, SVM_HOLD, SVM_RGB, SVM_FADE, SVM_DISP,
+  SVM_PICUE, SVM_PISTART, SVM_TRIG, SVM_WAITBEAM, SVM_JMP, SVM_JT, SVM_JF,
+  SVM_REPEAT, SVM_DJNZ, SVM_LOG,
+  SVM_NOPS
+};
+
+static const uint8_t SVM_MAX_PROGS = 8;
+
+// Pick the EEPROM or flash image. Call once from setup().
+void svm_begin();
+
+// Call every loop(): runs the current program, writes pending image bytes
+void svm_update();
+
+// Start a program by directory index or name (stops the current one)
+bool svm_run(uint8_t prog);
+int8_t svm_find(const char* upname);
+void svm_stop();
+bool svm_running();
+
+// Beam trip hook: starts the program bound to beam, true if there is one
+bool svm_beam(uint8_t beam);
+
+// Loader. LOAD stops the VM and invalidates the EEPROM image, and the flash
+// scenes run until COMMIT; W stages up to 32 bytes at an image offset and is
+// refused while the previous chunk is still being written; COMMIT stops the
+// VM, checks the image and only then writes its magic.
+bool svm_load_begin(uint16_t len);
+bool svm_load_write(uint16_t offset, const uint8_t* data, uint8_t n);
+bool svm_load_busy();
+bool svm_load_commit();
+void svm_erase();
+
+// Output channel name that rejected the last image opened, "" if none
+const char* svm_bad_channel();
+
+// Image source, programs, running state and counters (SVM command)
+void svm_print(Stream& s);
@@ -5,6 +5,7 @@
 typedef void (*ApplyU32)(uint32_t);
 typedef void (*ApplyU16)(uint16_t);
 typedef void (*ApplyU8)(uint8_t);
+typedef void (*ApplyBeams)(const uint8_t*);   // one byte per beam 0..5
 
 // Persistent settings structure (EEPROM-backed)
 struct HHSettings {
@@ -16,6 +17,28 @@ struct HHSettings {
 
   uint8_t  beam_pins[6];  // Arduino digital pins for 6 beams
   uint8_t  beam_scene[6]; // Scene codes for each beam
+  uint16_t debounce_min_ms; // adaptive debounce floor, debounce_ms is the ceiling
+  uint8_t  beam_instant;    // bit i: beam i fires on the leading edge
+  uint16_t min_pulse_us;    // leading-edge glitch rejection
+  uint8_t  beam_rearm[6];   // re-arm policy per beam (inputs.hpp REARM_*)
+  uint16_t rearm_clear_ms;  // REARM_CLEAR quiet time
+};
+
+// Stable EEPROM tags for each field. Never renumber or reuse a tag;
+// a new field gets the next free number and old firmware skips it.
+enum SettingsTag : uint8_t {
+  SET_TAG_HOLD_MS     = 1,
+  SET_TAG_COOLDOWN_MS = 2,
+  SET_TAG_DEBOUNCE_MS = 3,
+  SET_TAG_REARM_MS    = 4,
+  SET_TAG_BRIGHTNESS  = 5,
+  SET_TAG_BEAM_PINS   = 6,
+  SET_TAG_BEAM_SCENE  = 7,
+  SET_TAG_DEBOUNCE_MIN_MS = 8,
+  SET_TAG_BEAM_INSTANT = 9,
+  SET_TAG_MIN_PULSE_US = 10,
+  SET_TAG_BEAM_REARM   = 11,
+  SET_TAG_REARM_CLEAR_MS = 12
 };
 
 // Access the in-RAM copy
@@ -26,12 +49,33 @@ void settings_begin(ApplyU32 applyHold,
                     ApplyU32 applyCooldown,
                     ApplyU16 applyDebounce,
                     ApplyU32 applyRearm,
-                    ApplyU8  applyBrightness);
+                    ApplyU8  applyBrightness,
+                    ApplyU16 applyDebounceMin,
+                    ApplyU8  applyInstant,
+                    ApplyU16 applyMinPulse,
+                    ApplyBeams applyRearmPolicy,
+                    ApplyU16 applyRearmClear);
 
-// Save/load from EEPROM
-void settings_save();
+// Save/load from EEPROM.
+// SAVE appends a record to the wear-leveled journal and returns at once;
+// the bytes are written in the background by settings_update(). False, with
+// nothing written and the last saved record still current, when the tuned
+// fields do not fit a slot.
+bool settings_save();
 bool settings_load();
 
+// Read one stored field straight from EEPROM without loading the rest
+// (the fast-arm beam timing in setup()).
+// A known tag left out of the record (still at its default) reads as the default.
+// Returns bytes copied into out (0 for an unknown tag).
+uint8_t settings_peek(uint8_t tag, void* out, uint8_t size);
+
+// Call every loop(): writes one pending journal byte when the EEPROM is idle
+void settings_update();
+
+// True while a SAVE is still being written
+bool settings_save_pending();
+
 // NEW: factory reset to defaults (and optionally SAVE immediately)
 void settings_reset_defaults(bool save);
 
@@ -43,6 +87,11 @@ void settings_versions(uint16_t &magic, uint8_t &eepromVer, uint8_t &fwVer);
 void settings_set_hold(uint32_t v);
 void settings_set_cool(uint32_t v);
 void settings_set_debounce(uint16_t v);
+void settings_set_debounce_min(uint16_t v);
+void settings_set_beam_instant(uint8_t mask);
+void settings_set_min_pulse(uint16_t us);
+void settings_set_rearm_policy(uint8_t idx, uint8_t policy);
+void settings_set_rearm_clear(uint16_t ms);
 void settings_set_rearm(uint32_t v);
 void settings_set_brightness(uint8_t v);
 
@@ -52,10 +101,3 @@ void settings_set_beam_scene(uint8_t idx, uint8_t scene_code);
 
 // Pretty print
 void settings_print(Stream& s);
-
-#ifndef SETTINGS_HPP
-#define SETTINGS_HPP
-
-void settings_init();
-
-#endif
\ No newline at end of file
@@ -11,4 +11,9 @@ void techlight_scene_intro_kill(uint16_t ms_holdoff = 5000); // default 5 s bloc
 
 // Introspection for console
 bool        techlight_is_on();
-const char* techlight_mode_name(); // "AUTO" | "FORCE_ON" | "FORCE_OFF"
\ No newline at end of file
+const char* techlight_mode_name(); // "AUTO" | "FORCE_ON" | "FORCE_OFF"
+
+// Warm restart: override mode (-1 AUTO, 0 OFF, 1 ON), intro latch and
+// remaining minimum blackout, read before and restored after a reset.
+void techlight_warm_get(int8_t& override_mode, bool& latch, uint32_t& block_left_ms);
+void techlight_warm_resume(int8_t override_mode, bool latch, uint32_t block_left_ms);
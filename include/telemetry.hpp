@@ -5,6 +5,7 @@
 
 #pragma once
 #include <Arduino.h>
+#include "uart.hpp"
 
 namespace HH {
 
@@ -13,25 +14,50 @@ inline void tel_begin(uint32_t baud = 115200) {
   delay(10); // Mega 2560 should not block on Serial
 }
 
-inline void tel_emit(const char* scene,
-                     const char* phase,
-                     uint8_t beam,
-                     uint8_t magnet,
-                     uint8_t buzzer,
-                     uint8_t r,
-                     uint8_t g,
-                     uint8_t b) {
-  Serial.print("/*");
-  Serial.print(millis());  Serial.print(',');
-  Serial.print(scene);     Serial.print(',');
-  Serial.print(phase);     Serial.print(',');
-  Serial.print(beam);      Serial.print(',');
-  Serial.print(magnet);    Serial.print(',');
-  Serial.print(buzzer);    Serial.print(',');
-  Serial.print(r);         Serial.print(',');
-  Serial.print(g);         Serial.print(',');
-  Serial.print(b);
-  Serial.println("*/");
+// Returns the bytes written
+inline size_t tel_emit(const char* scene,
+                       const __FlashStringHelper* phase,
+                       uint8_t beam,
+                       uint8_t magnet,
+                       uint8_t buzzer,
+                       uint8_t r,
+                       uint8_t g,
+                       uint8_t b) {
+  size_t n = Console.print(F("/*"));
+  n += Console.print(millis());  n += Console.print(',');
+  n += Console.print(scene);     n += Console.print(',');
+  n += Console.print(phase);     n += Console.print(',');
+  n += Console.print(beam);      n += Console.print(',');
+  n += Console.print(magnet);    n += Console.print(',');
+  n += Console.print(buzzer);    n += Console.print(',');
+  n += Console.print(r);         n += Console.print(',');
+  n += Console.print(g);         n += Console.print(',');
+  n += Console.print(b);
+  n += Console.println(F("*/"));
+  return n;
 }
 
-} // namespace HH
\ No newline at end of file
+} // namespace HH
+
+// Subscription telemetry for the GUI (TEL command). Each channel samples its
+// part of the live state at its own rate and is sent only when it changed:
+//   ~<chan> <millis> f0,f1,f2     a field equal to the last one sent is empty
+// The first frame after subscribing, and the first change after 5 s, carry
+// every field. Channels and fields:
+//   scene  code (Scene), phase (0 idle, 1 hold/start, 2 cooldown)
+//   beams  mask: bit 0..5 beam broken, bit 6 reed closed
+//   out    magnet, buzzer
+//   rgb    r, g, b
+//   light  on, override (-1 auto, 0 off, 1 on), intro latch
+//   loop   worst pass us and passes since the last frame, free RAM
+//   studio full Serial Studio frame (tel_emit above) on any change
+// Frames are deferred, never blocked on, while the TX buffer is full.
+void telemetry_update();
+
+// "beams:100 rgb:20 loop:1", rates in Hz (max 100), 0 unsubscribes.
+// Channels not named keep their rate. False on an unknown channel or bad rate.
+bool telemetry_subscribe(const String& spec);
+void telemetry_off();
+
+// Rates, frame counts, bytes sent and deferrals
+void telemetry_print(Stream& s);
\ No newline at end of file
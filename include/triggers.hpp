@@ -10,5 +10,10 @@ bool triggers_pulse(uint8_t idx, uint16_t ms = 100);
 // Pulse by uppercase name: SHOW, BLOOD, GRAVE, FUR, FRANKEN
 bool triggers_pulse_by_name(const String& upname);
 
+// Name table lookups (names live in flash). Index -1 if unknown.
+static const uint8_t TRIGGERS_N = 5;
+int triggers_index(const String& upname);
+const __FlashStringHelper* triggers_name(uint8_t idx);
+
 // Print mapping to Serial
 void triggers_print_map();
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+#include <Arduino.h>
+
+// Console and Pi link UARTs.
+// Both keep the core's interrupt-driven 64-byte HardwareSerial rings
+// (SERIAL_TX_BUFFER_SIZE / SERIAL_RX_BUFFER_SIZE apply to every port, so
+// they stay at the default). The console adds a software ring of
+// HH_CONSOLE_TX_RING / HH_CONSOLE_RX_RING bytes in front of Serial's, so CFG,
+// MAP and help queue without blocking and a long loop pass does not lose
+// input, while the Pi link (frames <= 22 B) costs no more than the core's.
+// Console output goes through Console; a print larger than the free TX
+// space blocks loop() until the ISR drains it. Unprompted output on the live path never waits:
+// console_log() (scene, trip, SVM and Pi link lines) goes through
+// uart_log_nb(), which queues a whole line or drops it and counts the bytes,
+// and telemetry skips a frame that does not fit. Command replies still
+// print blocking; they were asked for.
+//
+// The Mega's 16U2 USB bridge runs 500000 and 1000000 baud with no rate
+// error at 16 MHz (115200 is 2.1 % off). Build with -DHH_CONSOLE_BAUD=1000000
+// and pass --baud 1000000 to the docs/ host tools.
+
+#ifndef HH_CONSOLE_BAUD
+#define HH_CONSOLE_BAUD 115200UL
+#endif
+
+#ifndef SERIAL_TX_BUFFER_SIZE
+#define SERIAL_TX_BUFFER_SIZE 64
+#endif
+#ifndef SERIAL_RX_BUFFER_SIZE
+#define SERIAL_RX_BUFFER_SIZE 64
+#endif
+
+#ifndef HH_CONSOLE_TX_RING
+#define HH_CONSOLE_TX_RING 448
+#endif
+#ifndef HH_CONSOLE_RX_RING
+#define HH_CONSOLE_RX_RING 192
+#endif
+
+// Serial behind the console rings. pump() moves bytes between the rings;
+// every call on Console pumps, and console_update() calls it each pass.
+class ConsolePort : public Stream {
+public:
+  int    available() override;
+  int    read() override;
+  int    peek() override;
+  size_t write(uint8_t b) override;
+  using Print::write;
+  int    availableForWrite() override;   // console ring + core ring
+  void   flush() override;
+  void   pump();
+};
+extern ConsolePort Console;
+
+// Copy as much of buf as fits in the TX ring right now; returns bytes taken (may be 0)
+size_t uart_write_nb(HardwareSerial& port, const uint8_t* buf, size_t n);
+size_t uart_print_nb(HardwareSerial& port, const char* s);
+
+// Queue msg (flash, may be null), detail (RAM, may be null) and CRLF as one
+// line if it all fits in the TX ring now; otherwise drop it, counted in UART.
+bool uart_log_nb(Print& port, const __FlashStringHelper* msg, const char* detail);
+
+// Baud, ring sizes and current ring fill (UART command)
+void uart_print(Stream& s);
+
+// Stream a test pattern out of the console for ms (<= 500) and report
+// bytes/s and the share of CPU taken by the TX interrupt and ring copies,
+// measured against an idle spin of the same length.
+void uart_bench(uint16_t ms);
@@ -0,0 +1,2 @@
+// Not used by the alphanumeric backpack; present so the include resolves
+#pragma once
@@ -0,0 +1,34 @@
+// Adafruit_AlphaNum4 over the Wire shim: same commands and RAM layout as the
+// library, so what reaches the HT16K33 model is what the backpack would get
+#pragma once
+#include <Arduino.h>
+
+#define HT16K33_BLINK_CMD       0x80
+#define HT16K33_BLINK_DISPLAYON 0x01
+#define HT16K33_BLINK_OFF       0
+#define HT16K33_BLINK_2HZ       1
+#define HT16K33_BLINK_1HZ       2
+#define HT16K33_BLINK_HALFHZ    3
+#define HT16K33_CMD_BRIGHTNESS  0xE0
+
+class Adafruit_LEDBackpack {
+public:
+  bool begin(uint8_t addr = 0x70);
+  void setBrightness(uint8_t b);
+  void blinkRate(uint8_t b);
+  void writeDisplay();
+  void clear();
+  uint16_t displaybuffer[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+
+protected:
+  void command(uint8_t c);
+  uint8_t addr_ = 0x70;
+};
+
+class Adafruit_AlphaNum4 : public Adafruit_LEDBackpack {
+public:
+  void writeDigitRaw(uint8_t n, uint16_t bitmask);
+  void writeDigitAscii(uint8_t n, uint8_t ascii, bool dot = false);
+};
+
+extern const uint16_t alphafonttable[128];
@@ -0,0 +1,213 @@
+// Arduino core API for the native build ([env:native]).
+// Enough of the AVR core for the firmware to build unmodified on Linux and
+// run on a virtual clock (host.hpp). Pins, Timer5, the UARTs, EEPROM and
+// the I2C display are modelled in arduino_shim.cpp; everything is
+// deterministic, so two runs of the same trace print the same timeline.
+#pragma once
+
+#include <ctype.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <string>
+
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define A0 54
+
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#define max(a, b) ((a) > (b) ? (a) : (b))
+#define constrain(x, lo, hi) ((x) < (lo) ? (lo) : ((x) > (hi) ? (hi) : (x)))
+
+#define noInterrupts() cli()
+#define interrupts()   sei()
+
+typedef uint8_t byte;
+typedef bool    boolean;
+
+// Time runs only when the firmware reads or waits on it (host.hpp)
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int  digitalRead(uint8_t pin);
+int  analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int val);
+void tone(uint8_t pin, unsigned int hz, unsigned long duration_ms = 0);
+void noTone(uint8_t pin);
+
+// avr-libc random(): same sequence as on the board for the same seed
+long random(long howbig);
+long random(long lo, long hi);
+void randomSeed(unsigned long seed);
+long map(long x, long in_lo, long in_hi, long out_lo, long out_hi);
+
+inline bool isDigit(int c) { return c >= '0' && c <= '9'; }
+
+// ---- Mega 2560 pin map (port numbers as in the core, PA = 1 .. PL = 12) ----
+#define NOT_A_PIN    0
+#define NOT_A_PORT   0
+#define NOT_ON_TIMER 0
+
+extern const uint8_t host_pin_port[70];   // (port << 3) | bit
+extern volatile uint8_t host_port_out[13];
+extern volatile uint8_t host_port_ddr[13];
+extern volatile uint8_t host_port_in[13];
+
+#define digitalPinToPort(p)    ((uint8_t)((p) < 70 ? host_pin_port[p] >> 3 : NOT_A_PIN))
+#define digitalPinToBitMask(p) ((uint8_t)((p) < 70 ? 1u << (host_pin_port[p] & 7) : 0))
+#define digitalPinToTimer(p)   ((uint8_t)((((p) >= 2 && (p) <= 13) || ((p) >= 44 && (p) <= 46)) ? 1 : NOT_ON_TIMER))
+#define portOutputRegister(P)  (&host_port_out[(P)])
+#define portModeRegister(P)    (&host_port_ddr[(P)])
+#define portInputRegister(P)   (&host_port_in[(P)])
+
+// ---- Flash strings ----
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(PSTR(s)))
+
+// ---- String (the subset the firmware uses) ----
+class String {
+public:
+  String(const char* c = "") : s_(c ? c : "") {}
+  String(const __FlashStringHelper* f) : s_(reinterpret_cast<const char*>(f)) {}
+  explicit String(char c) : s_(1, c) {}
+  String(int v, unsigned char base = DEC)           { fmt(v < 0, v < 0 ? 0ULL - (unsigned long long)v : (unsigned long long)v, base); }
+  String(unsigned int v, unsigned char base = DEC)  { fmt(false, v, base); }
+  String(long v, unsigned char base = DEC)          { fmt(v < 0, v < 0 ? 0ULL - (unsigned long long)v : (unsigned long long)v, base); }
+  String(unsigned long v, unsigned char base = DEC) { fmt(false, v, base); }
+
+  String& operator+=(const String& o) { s_ += o.s_; return *this; }
+  String& operator+=(const char* c)   { s_ += c; return *this; }
+  String& operator+=(char c)          { s_ += c; return *this; }
+  friend String operator+(String a, const String& b) { a += b; return a; }
+  friend String operator+(String a, const char* b)   { a += b; return a; }
+  friend String operator+(String a, char b)          { a += b; return a; }
+
+  bool operator==(const String& o) const { return s_ == o.s_; }
+  bool operator==(const char* c) const   { return s_ == c; }
+  bool operator!=(const String& o) const { return s_ != o.s_; }
+  bool operator!=(const char* c) const   { return s_ != c; }
+  char operator[](unsigned i) const { return i < s_.size() ? s_[i] : 0; }
+  char& operator[](unsigned i)      { return s_[i]; }
+  char charAt(unsigned i) const     { return (*this)[i]; }
+
+  unsigned length() const    { return (unsigned)s_.size(); }
+  const char* c_str() const  { return s_.c_str(); }
+  bool reserve(unsigned n)   { s_.reserve(n); return true; }
+  bool equals(const String& o) const { return s_ == o.s_; }
+  bool equalsIgnoreCase(const String& o) const { return strcasecmp(s_.c_str(), o.s_.c_str()) == 0; }
+
+  int indexOf(char c, unsigned from = 0) const { return pos(s_.find(c, from)); }
+  int indexOf(const char* c, unsigned from = 0) const { return pos(s_.find(c, from)); }
+  int indexOf(const String& c, unsigned from = 0) const { return pos(s_.find(c.s_, from)); }
+  int lastIndexOf(char c) const { return pos(s_.rfind(c)); }
+  bool startsWith(const String& p) const { return s_.compare(0, p.s_.size(), p.s_) == 0; }
+  bool endsWith(const String& p) const {
+    return s_.size() >= p.s_.size() && s_.compare(s_.size() - p.s_.size(), p.s_.size(), p.s_) == 0;
+  }
+  String substring(unsigned from) const { return substring(from, length()); }
+  String substring(unsigned from, unsigned to) const {
+    if (from > to) { unsigned t = from; from = to; to = t; }
+    if (from >= s_.size()) return String();
+    if (to > s_.size()) to = (unsigned)s_.size();
+    String r; r.s_ = s_.substr(from, to - from); return r;
+  }
+  long toInt() const { return atol(s_.c_str()); }
+  float toFloat() const { return (float)atof(s_.c_str()); }
+  void trim() {
+    const size_t a = s_.find_first_not_of(" \t\r\n\f\v");
+    if (a == std::string::npos) { s_.clear(); return; }
+    s_ = s_.substr(a, s_.find_last_not_of(" \t\r\n\f\v") - a + 1);
+  }
+  void toUpperCase() { for (size_t i = 0; i < s_.size(); i++) s_[i] = (char)toupper((unsigned char)s_[i]); }
+  void toLowerCase() { for (size_t i = 0; i < s_.size(); i++) s_[i] = (char)tolower((unsigned char)s_[i]); }
+  void remove(unsigned at, unsigned n = 0xFFFF) { if (at < s_.size()) s_.erase(at, n); }
+
+private:
+  static int pos(size_t p) { return p == std::string::npos ? -1 : (int)p; }
+  void fmt(bool neg, unsigned long long v, unsigned char base);
+  std::string s_;
+};
+
+// ---- Print / Stream / HardwareSerial ----
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t b) = 0;
+  virtual size_t write(const uint8_t* buf, size_t n);
+  size_t write(const char* s) { return s ? write(reinterpret_cast<const uint8_t*>(s), strlen(s)) : 0; }
+  size_t write(const char* buf, size_t n) { return write(reinterpret_cast<const uint8_t*>(buf), n); }
+  virtual int  availableForWrite() { return 0; }
+  virtual void flush() {}
+
+  size_t print(const __FlashStringHelper* s);
+  size_t print(const String& s);
+  size_t print(const char* s);
+  size_t print(char c);
+  size_t print(unsigned char v, int base = DEC);
+  size_t print(int v, int base = DEC);
+  size_t print(unsigned int v, int base = DEC);
+  size_t print(long v, int base = DEC);
+  size_t print(unsigned long v, int base = DEC);
+  size_t print(long long v, int base = DEC);
+  size_t print(unsigned long long v, int base = DEC);
+  size_t print(double v, int digits = 2);
+
+  size_t println();
+  template <typename T> size_t println(const T& v)          { size_t n = print(v); return n + println(); }
+  template <typename T> size_t println(const T& v, int arg) { size_t n = print(v, arg); return n + println(); }
+
+private:
+  size_t print_number(unsigned long long v, int base);
+  size_t print_float(double v, int digits);
+};
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+};
+
+class HardwareSerial : public Stream {
+public:
+  explicit HardwareSerial(uint8_t n) : n_(n) {}
+  void begin(unsigned long baud, uint8_t config = 0);
+  void end();
+  int available() override;
+  int read() override;
+  int peek() override;
+  size_t write(uint8_t b) override;
+  using Print::write;
+  int  availableForWrite() override;
+  void flush() override;
+  operator bool() { return true; }
+
+private:
+  uint8_t n_;
+};
+
+extern HardwareSerial Serial, Serial1, Serial2, Serial3;
+
+void setup();
+void loop();
@@ -0,0 +1,22 @@
+// EEPROM library over the modelled 4 KB EEPROM (host.hpp can load and save it)
+#pragma once
+#include <Arduino.h>
+
+struct EEPROMClass {
+  uint8_t read(int addr);
+  void    write(int addr, uint8_t v);
+  void    update(int addr, uint8_t v);
+  uint16_t length() { return 4096; }
+
+  template <typename T> T& get(int addr, T& t) {
+    uint8_t* p = reinterpret_cast<uint8_t*>(&t);
+    for (size_t i = 0; i < sizeof(T); i++) p[i] = read(addr + (int)i);
+    return t;
+  }
+  template <typename T> const T& put(int addr, const T& t) {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(&t);
+    for (size_t i = 0; i < sizeof(T); i++) update(addr + (int)i, p[i]);
+    return t;
+  }
+};
+extern EEPROMClass EEPROM;
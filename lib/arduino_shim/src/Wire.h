@@ -0,0 +1,25 @@
+// I2C master. Each transmission takes its bus time on the virtual clock and
+// is delivered to the HT16K33 model at 0x70; other addresses NACK.
+#pragma once
+#include <Arduino.h>
+
+class TwoWire {
+public:
+  void begin();
+  void end();
+  void setClock(uint32_t hz);
+  void setWireTimeout(uint32_t timeout_us = 25000, bool reset_with_timeout = false);
+  void beginTransmission(uint8_t addr);
+  size_t write(uint8_t b);
+  size_t write(const uint8_t* buf, size_t n);
+  uint8_t endTransmission(bool stop = true);
+
+private:
+  uint32_t hz_ = 100000;
+  uint8_t  addr_ = 0;
+  uint8_t  buf_[32];        // BUFFER_LENGTH in the AVR Wire library
+  uint8_t  n_ = 0;
+};
+extern TwoWire Wire;
+
+#define WIRE_HAS_TIMEOUT
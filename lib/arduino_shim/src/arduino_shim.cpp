@@ -0,0 +1,521 @@
+// Arduino core for the native build: virtual clock, Mega 2560 ports,
+// Timer5, UARTs, EEPROM, Wire and the HT16K33 backpack. See host.hpp.
+#include <deque>
+#include <functional>
+#include <map>
+#include <utility>
+
+#include <Arduino.h>
+#include <Adafruit_LEDBackpack.h>
+#include <EEPROM.h>
+#include <Wire.h>
+#include <avr/eeprom.h>
+#include "host.hpp"
+
+#ifndef SERIAL_TX_BUFFER_SIZE
+#define SERIAL_TX_BUFFER_SIZE 64
+#endif
+#ifndef SERIAL_RX_BUFFER_SIZE
+#define SERIAL_RX_BUFFER_SIZE 64
+#endif
+
+static const uint64_t CLOCK_READ_NS  = 1000;      // per millis()/micros() call
+static const uint64_t ADC_NS         = 112000;    // one analogRead() conversion
+static const uint64_t EE_WRITE_NS    = 3400000;   // EEPROM erase + write
+static const uint64_t NEVER          = ~0ULL;
+
+static uint64_t g_ns = 0;
+static bool     g_advancing = false;   // inside an ISR or a stimulus: time stands still
+static bool     g_in_isr = false;
+static HostObserver  g_null_observer;
+static HostObserver* g_obs = &g_null_observer;
+static std::multimap<uint64_t, std::function<void()>> g_stimuli;
+
+static void t5_sync(uint64_t ns);
+static uint64_t t5_next_ns();
+static void t5_dispatch();
+static void scan_ports();
+
+// ================= Clock =================
+uint64_t host_now_ns() { return g_ns; }
+
+void host_advance(uint64_t ns) {
+  if (g_advancing) return;
+  g_advancing = true;
+  scan_ports();
+  const uint64_t end = g_ns + ns;
+  for (;;) {
+    uint64_t t = end;
+    const uint64_t te = t5_next_ns();
+    if (te < t) t = te;
+    if (!g_stimuli.empty() && g_stimuli.begin()->first < t) t = max(g_stimuli.begin()->first, g_ns);
+    g_ns = t;
+    t5_sync(t);
+    while (!g_stimuli.empty() && g_stimuli.begin()->first <= g_ns) {
+      std::function<void()> fn = std::move(g_stimuli.begin()->second);
+      g_stimuli.erase(g_stimuli.begin());
+      fn();
+    }
+    t5_dispatch();
+    if (g_ns >= end) break;
+  }
+  g_advancing = false;
+}
+
+void host_at(uint64_t t_ns, std::function<void()> fn) { g_stimuli.insert(std::make_pair(t_ns, std::move(fn))); }
+void host_observe(HostObserver* o) { g_obs = o ? o : &g_null_observer; }
+
+unsigned long millis() { host_advance(CLOCK_READ_NS); return (uint32_t)(g_ns / 1000000ULL); }
+unsigned long micros() { host_advance(CLOCK_READ_NS); return (uint32_t)(g_ns / 1000ULL); }
+void delay(unsigned long ms) { host_advance((uint64_t)ms * 1000000ULL); }
+void delayMicroseconds(unsigned int us) { host_advance((uint64_t)us * 1000ULL); }
+
+// ================= Interrupts =================
+HostSreg SREG = {0x80};   // init() has enabled interrupts before setup()
+volatile uint8_t MCUSR = 0, WDTCSR = 0;
+
+HostSreg& HostSreg::operator=(uint8_t b) {
+  v = b;
+  if (b & 0x80) t5_dispatch();
+  return *this;
+}
+void cli() { SREG.v &= (uint8_t)~0x80; }
+void sei() { SREG = (uint8_t)(SREG.v | 0x80); }
+
+// ================= Timer5 =================
+volatile uint16_t TCNT5 = 0, OCR5A = 0, OCR5B = 0, OCR5C = 0;
+volatile uint8_t  TCCR5A = 0, TCCR5B = 0, TIMSK5 = 0;
+HostTifr TIFR5 = {0};
+
+static uint16_t g_t5_pre  = 0;   // prescaler the tick count below is in, 0 = stopped
+static uint64_t g_t5_tick = 0;   // ticks already counted into TCNT5
+
+static uint16_t t5_prescaler() {
+  static const uint16_t PRE[8] = {0, 1, 8, 64, 256, 1024, 0, 0};   // external clock not modelled
+  return PRE[TCCR5B & 7];
+}
+static uint64_t cycles(uint64_t ns) { return ns * (F_CPU / 1000000UL) / 1000ULL; }
+
+// Ticks until the counter next equals OCR, 1..0x10000
+static uint32_t t5_until(uint16_t ocr) { const uint16_t d = (uint16_t)(ocr - TCNT5); return d ? d : 0x10000UL; }
+
+static void t5_sync(uint64_t ns) {
+  const uint16_t pre = t5_prescaler();
+  if (pre != g_t5_pre) { g_t5_pre = pre; g_t5_tick = pre ? cycles(ns) / pre : 0; return; }
+  if (!pre) return;
+  const uint64_t now = cycles(ns) / pre;
+  if (now <= g_t5_tick) return;
+  const uint64_t n = now - g_t5_tick;
+  g_t5_tick = now;
+  if (n >= 0x10000UL - TCNT5)   TIFR5.v |= _BV(TOV5);
+  if (n >= t5_until(OCR5A))     TIFR5.v |= _BV(OCF5A);
+  if (n >= t5_until(OCR5B))     TIFR5.v |= _BV(OCF5B);
+  if (n >= t5_until(OCR5C))     TIFR5.v |= _BV(OCF5C);
+  TCNT5 = (uint16_t)(TCNT5 + n);
+}
+
+// When the next enabled Timer5 interrupt comes due
+static uint64_t t5_next_ns() {
+  const uint16_t pre = t5_prescaler();
+  if (!pre || pre != g_t5_pre || !(TIMSK5 & 0x0F)) return NEVER;
+  uint32_t d = 0x20000UL;
+  if (TIMSK5 & _BV(TOIE5))  d = min(d, 0x10000UL - TCNT5);
+  if (TIMSK5 & _BV(OCIE5A)) d = min(d, t5_until(OCR5A));
+  if (TIMSK5 & _BV(OCIE5B)) d = min(d, t5_until(OCR5B));
+  if (TIMSK5 & _BV(OCIE5C)) d = min(d, t5_until(OCR5C));
+  const uint64_t cyc = (g_t5_tick + d) * pre;
+  return (cyc * 1000ULL + F_CPU / 1000000UL - 1) / (F_CPU / 1000000UL);   // first ns at that cycle
+}
+
+// Pending, enabled vectors in priority order (COMPA, COMPB, COMPC, OVF)
+static void t5_dispatch() {
+  while (!g_in_isr && (SREG.v & 0x80)) {
+    const uint8_t due = TIFR5.v & TIMSK5 & 0x0F;
+    if (!due) return;
+    g_in_isr = true;
+    SREG.v &= (uint8_t)~0x80;
+    if      (due & _BV(OCF5A)) { TIFR5.v &= (uint8_t)~_BV(OCF5A); TIMER5_COMPA_vect(); }
+    else if (due & _BV(OCF5B)) { TIFR5.v &= (uint8_t)~_BV(OCF5B); TIMER5_COMPB_vect(); }
+    else if (due & _BV(OCF5C)) { TIFR5.v &= (uint8_t)~_BV(OCF5C); TIMER5_COMPC_vect(); }
+    else                       { TIFR5.v &= (uint8_t)~_BV(TOV5);  TIMER5_OVF_vect(); }
+    SREG.v |= 0x80;
+    g_in_isr = false;
+    scan_ports();
+  }
+}
+
+// ================= Ports =================
+const uint8_t host_pin_port[70] = {
+  5<<3|0,  5<<3|1,  5<<3|4,  5<<3|5,  7<<3|5,  5<<3|3,  8<<3|3,  8<<3|4,
+  8<<3|5,  8<<3|6,  2<<3|4,  2<<3|5,  2<<3|6,  2<<3|7,  10<<3|1, 10<<3|0,
+  8<<3|1,  8<<3|0,  4<<3|3,  4<<3|2,  4<<3|1,  4<<3|0,  1<<3|0,  1<<3|1,
+  1<<3|2,  1<<3|3,  1<<3|4,  1<<3|5,  1<<3|6,  1<<3|7,  3<<3|7,  3<<3|6,
+  3<<3|5,  3<<3|4,  3<<3|3,  3<<3|2,  3<<3|1,  3<<3|0,  4<<3|7,  7<<3|2,
+  7<<3|1,  7<<3|0,  12<<3|7, 12<<3|6, 12<<3|5, 12<<3|4, 12<<3|3, 12<<3|2,
+  12<<3|1, 12<<3|0, 2<<3|3,  2<<3|2,  2<<3|1,  2<<3|0,  6<<3|0,  6<<3|1,
+  6<<3|2,  6<<3|3,  6<<3|4,  6<<3|5,  6<<3|6,  6<<3|7,  11<<3|0, 11<<3|1,
+  11<<3|2, 11<<3|3, 11<<3|4, 11<<3|5, 11<<3|6, 11<<3|7
+};
+volatile uint8_t host_port_out[13];
+volatile uint8_t host_port_ddr[13];
+volatile uint8_t host_port_in[13] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+static uint8_t g_seen_out[13];
+
+// Report driven bits that changed since the last look
+static void scan_ports() {
+  for (uint8_t p = 1; p < 13; p++) {
+    const uint8_t diff = (uint8_t)((host_port_out[p] ^ g_seen_out[p]) & host_port_ddr[p]);
+    if (!diff) continue;
+    g_seen_out[p] = (uint8_t)((g_seen_out[p] & ~diff) | (host_port_out[p] & diff));
+    for (uint8_t pin = 0; pin < 70; pin++) {
+      if ((host_pin_port[pin] >> 3) == p && (diff & digitalPinToBitMask(pin)))
+        g_obs->pin(pin, (host_port_out[p] & digitalPinToBitMask(pin)) ? HIGH : LOW);
+    }
+  }
+}
+
+void host_set_input(uint8_t pin, uint8_t level) {
+  if (pin >= 70) return;
+  const uint8_t p = digitalPinToPort(pin), m = digitalPinToBitMask(pin);
+  if (level) host_port_in[p] |= m; else host_port_in[p] &= (uint8_t)~m;
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  if (pin >= 70) return;
+  const uint8_t p = digitalPinToPort(pin), m = digitalPinToBitMask(pin);
+  if (mode == OUTPUT) { host_port_ddr[p] |= m; g_seen_out[p] = (uint8_t)((g_seen_out[p] & ~m) | (host_port_out[p] & m)); return; }
+  host_port_ddr[p] &= (uint8_t)~m;
+  if (mode == INPUT_PULLUP) host_port_out[p] |= m; else host_port_out[p] &= (uint8_t)~m;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+  if (pin >= 70) return;
+  const uint8_t p = digitalPinToPort(pin), m = digitalPinToBitMask(pin);
+  if (val) host_port_out[p] |= m; else host_port_out[p] &= (uint8_t)~m;
+}
+
+int digitalRead(uint8_t pin) {
+  if (pin >= 70) return LOW;
+  const uint8_t p = digitalPinToPort(pin), m = digitalPinToBitMask(pin);
+  const uint8_t level = (host_port_ddr[p] & m) ? host_port_out[p] : host_port_in[p];
+  return (level & m) ? HIGH : LOW;
+}
+
+// Nothing is wired to the analog inputs; a conversion still takes its time
+int analogRead(uint8_t pin) { (void)pin; host_advance(ADC_NS); return 0; }
+
+void analogWrite(uint8_t pin, int val) {
+  pinMode(pin, OUTPUT);
+  if (val <= 0)   { digitalWrite(pin, LOW);  return; }
+  if (val >= 255) { digitalWrite(pin, HIGH); return; }
+  if (digitalPinToTimer(pin) == NOT_ON_TIMER) { digitalWrite(pin, val < 128 ? LOW : HIGH); return; }
+  g_obs->pwm(pin, (uint8_t)val);
+}
+
+void tone(uint8_t pin, unsigned int hz, unsigned long duration_ms) {
+  (void)duration_ms;
+  g_obs->tone(pin, hz);
+}
+void noTone(uint8_t pin) { g_obs->tone(pin, 0); }
+
+// ================= Math =================
+static uint32_t g_rand_next = 1;
+
+// avr-libc's do_random(): Park-Miller minimal standard, as used by random()
+static long do_random() {
+  int32_t x = (int32_t)g_rand_next;
+  if (x == 0) x = 123459876L;
+  const int32_t hi = x / 127773L, lo = x % 127773L;
+  x = 16807L * lo - 2836L * hi;
+  if (x < 0) x += 0x7FFFFFFFL;
+  g_rand_next = (uint32_t)x;
+  return x % (0x7FFFFFFFL + 1UL);
+}
+long random(long howbig) { return howbig == 0 ? 0 : do_random() % howbig; }
+long random(long lo, long hi) { return lo >= hi ? lo : random(hi - lo) + lo; }
+void randomSeed(unsigned long seed) { if (seed != 0) g_rand_next = (uint32_t)seed; }
+long map(long x, long in_lo, long in_hi, long out_lo, long out_hi) {
+  return (x - in_lo) * (out_hi - out_lo) / (in_hi - in_lo) + out_lo;
+}
+
+// ================= String / Print =================
+void String::fmt(bool neg, unsigned long long v, unsigned char base) {
+  if (base < 2 || base > 36) base = 10;
+  char buf[66];
+  char* p = buf + sizeof buf - 1;
+  *p = 0;
+  do { const uint8_t d = (uint8_t)(v % base); *--p = (char)(d < 10 ? '0' + d : 'a' + d - 10); v /= base; } while (v);
+  if (neg) *--p = '-';
+  s_ = p;
+}
+
+size_t Print::write(const uint8_t* buf, size_t n) {
+  size_t k = 0;
+  while (n--) k += write(*buf++);
+  return k;
+}
+
+size_t Print::print_number(unsigned long long v, int base) {
+  if (base < 2) base = 10;
+  char buf[66];
+  char* p = buf + sizeof buf - 1;
+  *p = 0;
+  do { const uint8_t d = (uint8_t)(v % (unsigned)base); *--p = (char)(d < 10 ? '0' + d : 'A' + d - 10); v /= (unsigned)base; } while (v);
+  return write(p);
+}
+
+// Print::printFloat from the core: rounds, then up to 'digits' decimals
+size_t Print::print_float(double v, int digits) {
+  if (isnan(v)) return print("nan");
+  if (isinf(v)) return print("inf");
+  if (v > 4294967040.0 || v < -4294967040.0) return print("ovf");
+  size_t n = 0;
+  if (v < 0.0) { n += print('-'); v = -v; }
+  double rounding = 0.5;
+  for (int i = 0; i < digits; ++i) rounding /= 10.0;
+  v += rounding;
+  const unsigned long ip = (unsigned long)v;
+  double rem = v - (double)ip;
+  n += print_number(ip, 10);
+  if (digits > 0) n += print('.');
+  while (digits-- > 0) {
+    rem *= 10.0;
+    const unsigned d = (unsigned)rem;
+    n += print_number(d, 10);
+    rem -= d;
+  }
+  return n;
+}
+
+size_t Print::print(const __FlashStringHelper* s) { return write(reinterpret_cast<const char*>(s)); }
+size_t Print::print(const String& s)              { return write(s.c_str(), s.length()); }
+size_t Print::print(const char* s)                { return write(s); }
+size_t Print::print(char c)                       { return write((uint8_t)c); }
+size_t Print::print(unsigned char v, int base)    { return print_number(v, base); }
+size_t Print::print(unsigned int v, int base)     { return print_number(v, base); }
+size_t Print::print(unsigned long v, int base)    { return print_number(v, base); }
+size_t Print::print(unsigned long long v, int base) { return print_number(v, base); }
+size_t Print::print(int v, int base)              { return print((long long)v, base); }
+size_t Print::print(long v, int base)             { return print((long long)v, base); }
+// Negative numbers in other bases print as the board's 32-bit two's complement
+size_t Print::print(long long v, int base) {
+  if (base != 10) return print_number((uint32_t)v, base);
+  if (v >= 0) return print_number((unsigned long long)v, 10);
+  const size_t n = print('-');
+  return n + print_number(0ULL - (unsigned long long)v, 10);
+}
+size_t Print::print(double v, int digits) { return print_float(v, digits); }
+size_t Print::println() { return write("\r\n"); }
+
+// ================= UARTs =================
+// TX drains one frame (start, 8 data, stop) at a time at the baud rate the
+// core's divisor actually gives; a write into a full ring waits for room.
+// RX bytes land in the ring as they arrive and are dropped when it is full.
+struct Uart {
+  uint64_t tx_frame_ns = 0;    // 0 = not begun, bytes go out at once
+  uint64_t rx_frame_ns = 0;
+  uint16_t tx_pending = 0;     // in the ring plus the one on the wire
+  uint64_t tx_done_ns = 0;     // when the byte on the wire is out
+  uint64_t tx_blocked_ns = 0;
+  std::deque<std::pair<uint64_t, uint8_t>> rx_line;   // arrival time, byte
+  uint64_t rx_line_end = 0;
+  std::deque<uint8_t> rx_ring;
+  uint32_t rx_dropped = 0;
+};
+static Uart g_uart[4];
+
+HardwareSerial Serial(0), Serial1(1), Serial2(2), Serial3(3);
+
+static void tx_drain(Uart& u) {
+  while (u.tx_pending && u.tx_done_ns <= g_ns) {
+    if (--u.tx_pending) u.tx_done_ns += u.tx_frame_ns;
+  }
+}
+
+static void rx_pump(Uart& u) {
+  while (!u.rx_line.empty() && u.rx_line.front().first <= g_ns) {
+    if (u.rx_ring.size() < SERIAL_RX_BUFFER_SIZE - 1) u.rx_ring.push_back(u.rx_line.front().second);
+    else u.rx_dropped++;
+    u.rx_line.pop_front();
+  }
+}
+
+void HardwareSerial::begin(unsigned long baud, uint8_t config) {
+  (void)config;
+  // HardwareSerial::begin(): U2X divisor, except 57600 at 16 MHz
+  bool u2x = !(F_CPU == 16000000UL && baud == 57600);
+  unsigned long setting = (F_CPU / 4 / baud - 1) / 2;
+  if (setting > 4095) u2x = false;
+  if (!u2x) setting = (F_CPU / 8 / baud - 1) / 2;
+  const uint64_t actual = F_CPU / ((u2x ? 8ULL : 16ULL) * (setting + 1));
+  g_uart[n_].tx_frame_ns = 10ULL * 1000000000ULL / actual;
+  g_uart[n_].rx_frame_ns = 10ULL * 1000000000ULL / baud;
+}
+void HardwareSerial::end() { flush(); g_uart[n_].tx_frame_ns = 0; }
+
+int HardwareSerial::available() { Uart& u = g_uart[n_]; rx_pump(u); return (int)u.rx_ring.size(); }
+int HardwareSerial::peek() { Uart& u = g_uart[n_]; rx_pump(u); return u.rx_ring.empty() ? -1 : u.rx_ring.front(); }
+int HardwareSerial::read() {
+  Uart& u = g_uart[n_];
+  rx_pump(u);
+  if (u.rx_ring.empty()) return -1;
+  const uint8_t b = u.rx_ring.front();
+  u.rx_ring.pop_front();
+  return b;
+}
+
+int HardwareSerial::availableForWrite() {
+  Uart& u = g_uart[n_];
+  tx_drain(u);
+  const int in_ring = u.tx_pending ? u.tx_pending - 1 : 0;
+  return SERIAL_TX_BUFFER_SIZE - 1 - in_ring;
+}
+
+size_t HardwareSerial::write(uint8_t b) {
+  Uart& u = g_uart[n_];
+  g_obs->uart_tx(n_, b);
+  if (!u.tx_frame_ns) return 1;
+  tx_drain(u);
+  while (u.tx_pending >= SERIAL_TX_BUFFER_SIZE && !g_advancing) {
+    const uint64_t wait = u.tx_done_ns - g_ns;
+    u.tx_blocked_ns += wait;
+    host_advance(wait);
+    tx_drain(u);
+  }
+  if (!u.tx_pending) u.tx_done_ns = g_ns + u.tx_frame_ns;
+  u.tx_pending++;
+  return 1;
+}
+
+void HardwareSerial::flush() {
+  Uart& u = g_uart[n_];
+  tx_drain(u);
+  while (u.tx_pending && !g_advancing) { host_advance(u.tx_done_ns - g_ns); tx_drain(u); }
+}
+
+void host_uart_rx(uint8_t uart, const char* data, size_t n) {
+  Uart& u = g_uart[uart & 3];
+  const uint64_t frame = u.rx_frame_ns ? u.rx_frame_ns : 86806;   // 115200 until begin()
+  uint64_t t = max(u.rx_line_end, g_ns);
+  for (size_t i = 0; i < n; i++) { t += frame; u.rx_line.push_back(std::make_pair(t, (uint8_t)data[i])); }
+  u.rx_line_end = t;
+}
+uint32_t host_uart_rx_dropped(uint8_t uart)    { Uart& u = g_uart[uart & 3]; rx_pump(u); return u.rx_dropped; }
+uint64_t host_uart_tx_blocked_ns(uint8_t uart) { return g_uart[uart & 3].tx_blocked_ns; }
+
+// ================= EEPROM =================
+static uint8_t  g_eeprom[4096];
+static bool     g_eeprom_init = false;
+static uint64_t g_ee_ready_ns = 0;
+
+uint8_t* host_eeprom() {
+  if (!g_eeprom_init) { memset(g_eeprom, 0xFF, sizeof g_eeprom); g_eeprom_init = true; }
+  return g_eeprom;
+}
+bool eeprom_is_ready() { return g_ns >= g_ee_ready_ns; }
+
+// avr-libc waits for the previous write before any access
+static void ee_wait() { if (g_ns < g_ee_ready_ns) host_advance(g_ee_ready_ns - g_ns); }
+
+uint8_t EEPROMClass::read(int addr) { ee_wait(); return host_eeprom()[addr & 4095]; }
+void EEPROMClass::write(int addr, uint8_t v) {
+  ee_wait();
+  host_eeprom()[addr & 4095] = v;
+  g_ee_ready_ns = g_ns + EE_WRITE_NS;
+}
+void EEPROMClass::update(int addr, uint8_t v) { if (read(addr) != v) write(addr, v); }
+EEPROMClass EEPROM;
+
+// ================= I2C and the HT16K33 at 0x70 =================
+static HostDisplay g_ht = {{0, 0, 0, 0}, 0, 0, 15};
+static uint8_t     g_ht_ram[16];
+
+static void ht16k33_transfer(const uint8_t* b, uint8_t n) {
+  if (!n) return;
+  const uint8_t cmd = b[0];
+  if ((cmd & 0xF0) == 0x00) {
+    for (uint8_t i = 1; i < n; i++) g_ht_ram[(cmd + i - 1) & 15] = b[i];
+    for (uint8_t d = 0; d < 4; d++) g_ht.word[d] = (uint16_t)(g_ht_ram[2 * d] | (g_ht_ram[2 * d + 1] << 8));
+  }
+  else if ((cmd & 0xF0) == 0x80) { g_ht.on = cmd & 1; g_ht.blink = (cmd >> 1) & 3; }
+  else if ((cmd & 0xF0) == 0xE0) g_ht.dim = cmd & 0x0F;
+  else return;   // oscillator, row/int setup
+  g_obs->display(g_ht);
+}
+
+void TwoWire::begin() {}
+void TwoWire::end() {}
+void TwoWire::setClock(uint32_t hz) { if (hz) hz_ = hz; }
+void TwoWire::setWireTimeout(uint32_t timeout_us, bool reset_with_timeout) { (void)timeout_us; (void)reset_with_timeout; }
+void TwoWire::beginTransmission(uint8_t addr) { addr_ = addr; n_ = 0; }
+size_t TwoWire::write(uint8_t b) { if (n_ >= sizeof buf_) return 0; buf_[n_++] = b; return 1; }
+size_t TwoWire::write(const uint8_t* buf, size_t n) { size_t k = 0; while (n-- && write(*buf++)) k++; return k; }
+
+// Address plus data, 9 clocks a byte, and start/stop: the caller blocks for all of it
+uint8_t TwoWire::endTransmission(bool stop) {
+  (void)stop;
+  host_advance((9ULL * (n_ + 1) + 2) * 1000000000ULL / hz_);
+  if (addr_ != 0x70) return 2;   // address NACK
+  ht16k33_transfer(buf_, n_);
+  return 0;
+}
+TwoWire Wire;
+
+// Adafruit_LEDBackpack / Adafruit_AlphaNum4
+void Adafruit_LEDBackpack::command(uint8_t c) {
+  Wire.beginTransmission(addr_);
+  Wire.write(c);
+  Wire.endTransmission();
+}
+bool Adafruit_LEDBackpack::begin(uint8_t addr) {
+  addr_ = addr;
+  Wire.begin();
+  Wire.beginTransmission(addr_);
+  if (Wire.endTransmission() != 0) return false;
+  command(0x21);   // oscillator on
+  blinkRate(HT16K33_BLINK_OFF);
+  setBrightness(15);
+  return true;
+}
+void Adafruit_LEDBackpack::setBrightness(uint8_t b) { command((uint8_t)(HT16K33_CMD_BRIGHTNESS | (b > 15 ? 15 : b))); }
+void Adafruit_LEDBackpack::blinkRate(uint8_t b) {
+  if (b > 3) b = 0;
+  command((uint8_t)(HT16K33_BLINK_CMD | HT16K33_BLINK_DISPLAYON | (b << 1)));
+}
+void Adafruit_LEDBackpack::writeDisplay() {
+  Wire.beginTransmission(addr_);
+  Wire.write((uint8_t)0x00);
+  for (uint8_t i = 0; i < 8; i++) { Wire.write((uint8_t)(displaybuffer[i] & 0xFF)); Wire.write((uint8_t)(displaybuffer[i] >> 8)); }
+  Wire.endTransmission();
+}
+void Adafruit_LEDBackpack::clear() { for (uint8_t i = 0; i < 8; i++) displaybuffer[i] = 0; }
+void Adafruit_AlphaNum4::writeDigitRaw(uint8_t n, uint16_t bitmask) { displaybuffer[n & 7] = bitmask; }
+void Adafruit_AlphaNum4::writeDigitAscii(uint8_t n, uint8_t ascii, bool dot) {
+  displaybuffer[n & 7] = (uint16_t)(pgm_read_word(alphafonttable + (ascii & 0x7F)) | (dot ? 0x4000 : 0));
+}
+
+// The library's 14-segment font
+const uint16_t alphafonttable[128] PROGMEM = {
+  0x0001, 0x0002, 0x0004, 0x0008, 0x0010, 0x0020, 0x0040, 0x0080,
+  0x0100, 0x0200, 0x0400, 0x0800, 0x1000, 0x2000, 0x4000, 0x8000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x12C9, 0x15C0, 0x12F9, 0x00E3, 0x0530, 0x12C8, 0x3A00, 0x1700,
+  0x0000, 0x0006, 0x0220, 0x12CE, 0x12ED, 0x0C24, 0x235D, 0x0400,   //   ! " # $ % & '
+  0x2400, 0x0900, 0x3FC0, 0x12C0, 0x0800, 0x00C0, 0x4000, 0x0C00,   // ( ) * + , - . /
+  0x0C3F, 0x0006, 0x00DB, 0x008F, 0x00E6, 0x2069, 0x00FD, 0x0007,   // 0..7
+  0x00FF, 0x00EF, 0x1200, 0x0A00, 0x2400, 0x00C8, 0x0900, 0x1083,   // 8 9 : ; < = > ?
+  0x02BB, 0x00F7, 0x128F, 0x0039, 0x120F, 0x00F9, 0x0071, 0x00BD,   // @ A..G
+  0x00F6, 0x1209, 0x001E, 0x2470, 0x0038, 0x0536, 0x2136, 0x003F,   // H..O
+  0x00F3, 0x203F, 0x20F3, 0x00ED, 0x1201, 0x003E, 0x0C30, 0x2836,   // P..W
+  0x2D00, 0x1500, 0x0C09, 0x0039, 0x2100, 0x000F, 0x0C03, 0x0008,   // X Y Z [ \ ] ^ _
+  0x0100, 0x1058, 0x2078, 0x00D8, 0x088E, 0x0858, 0x0071, 0x048E,   // ` a..g
+  0x1070, 0x1000, 0x000E, 0x3600, 0x0030, 0x10D4, 0x1050, 0x00DC,   // h..o
+  0x0170, 0x0486, 0x0050, 0x2088, 0x0078, 0x001C, 0x2004, 0x2814,   // p..w
+  0x28C0, 0x200C, 0x0848, 0x0949, 0x1200, 0x2489, 0x0520, 0x3FFF,   // x y z { | } ~ DEL
+};
+
+char host_glyph(uint16_t word) {
+  static const char ORDER[] = " 0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ-_abcdefghijklmnopqrstuvwxyz!\"#$%&'()*+,./:;<=>?@[\\]^`{|}~";
+  for (const char* c = ORDER; *c; c++) if (alphafonttable[(uint8_t)*c] == word) return *c;
+  return 0;
+}
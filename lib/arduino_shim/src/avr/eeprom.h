@@ -0,0 +1,5 @@
+// A write keeps the EEPROM busy for 3.4 ms of virtual time, as on the chip
+#pragma once
+#include <stdint.h>
+
+bool eeprom_is_ready();
@@ -0,0 +1,64 @@
+// ATmega2560 registers the firmware touches outside pin_traits.hpp: SREG,
+// the reset cause and watchdog, and Timer5. Timer5 counts and raises its
+// compare and overflow interrupts against the virtual clock.
+#pragma once
+#include <stdint.h>
+
+#define _BV(b) (1u << (b))
+
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+// Status register: only the I bit means anything here. Restoring a saved
+// SREG with I set runs interrupts that came due while it was clear.
+struct HostSreg {
+  volatile uint8_t v;
+  operator uint8_t() const { return v; }
+  HostSreg& operator=(uint8_t b);
+};
+extern HostSreg SREG;
+void cli();
+void sei();
+
+// Reset cause and watchdog (recovery.cpp); a host run is always a power-on
+extern volatile uint8_t MCUSR, WDTCSR;
+#define PORF  0
+#define EXTRF 1
+#define BORF  2
+#define WDRF  3
+#define WDP0  0
+#define WDP1  1
+#define WDP2  2
+#define WDE   3
+#define WDCE  4
+#define WDP3  5
+#define WDIE  6
+#define WDIF  7
+
+// Timer5. Writing 1 to a TIFR5 bit clears it, as on the chip.
+struct HostTifr {
+  volatile uint8_t v;
+  operator uint8_t() const { return v; }
+  HostTifr& operator=(uint8_t b) { v &= (uint8_t)~b; return *this; }
+};
+extern volatile uint16_t TCNT5, OCR5A, OCR5B, OCR5C;
+extern volatile uint8_t  TCCR5A, TCCR5B, TIMSK5;
+extern HostTifr TIFR5;
+#define TOIE5  0
+#define OCIE5A 1
+#define OCIE5B 2
+#define OCIE5C 3
+#define TOV5   0
+#define OCF5A  1
+#define OCF5B  2
+#define OCF5C  3
+#define CS50   0
+#define CS51   1
+#define CS52   2
+
+#define ISR(vector) extern "C" void vector(void)
+extern "C" void TIMER5_COMPA_vect(void);
+extern "C" void TIMER5_COMPB_vect(void);
+extern "C" void TIMER5_COMPC_vect(void);
+extern "C" void TIMER5_OVF_vect(void);
@@ -0,0 +1,24 @@
+// One address space on the host: flash data is ordinary const data
+#pragma once
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+
+#define PROGMEM
+#define PGM_P const char*
+#define PSTR(s) (s)
+
+#define pgm_read_byte(p)  (*(const uint8_t*)(p))
+#define pgm_read_word(p)  (*(const uint16_t*)(p))
+#define pgm_read_dword(p) (*(const uint32_t*)(p))
+#define pgm_read_ptr(p)   (*(void* const*)(p))
+
+#define memcpy_P      memcpy
+#define memcmp_P      memcmp
+#define strcpy_P      strcpy
+#define strncpy_P     strncpy
+#define strcmp_P      strcmp
+#define strncmp_P     strncmp
+#define strcasecmp_P  strcasecmp
+#define strlen_P      strlen
+#define snprintf_P    snprintf
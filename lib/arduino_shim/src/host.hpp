@@ -0,0 +1,49 @@
+// Driver side of the native shim: the virtual clock, stimuli and what the
+// firmware drove. Time moves only when the firmware reads the clock (1 us
+// per millis()/micros() call, so polling loops end), waits in delay(), or
+// blocks on a full UART ring, the I2C bus or a busy EEPROM. CPU time of the
+// code itself is not modelled; loop pass times mean blocking I/O, nothing else.
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+
+uint64_t host_now_ns();
+void     host_advance(uint64_t ns);
+
+// Run fn when the clock reaches t_ns, in time order (ties in call order)
+void host_at(uint64_t t_ns, std::function<void()> fn);
+
+// Level on an input pin (default HIGH, as with the pull-ups and nothing attached)
+void host_set_input(uint8_t pin, uint8_t level);
+
+// Bytes arriving on a UART's RX line at its baud rate, after any still in flight
+void     host_uart_rx(uint8_t uart, const char* data, size_t n);
+uint32_t host_uart_rx_dropped(uint8_t uart);    // lost to a full RX ring
+uint64_t host_uart_tx_blocked_ns(uint8_t uart); // time write() waited for ring space
+
+// The modelled EEPROM, 4096 bytes, erased (0xFF) at start
+uint8_t* host_eeprom();
+
+// HT16K33 state after each RAM write or setup command
+struct HostDisplay {
+  uint16_t word[4];   // digit segment words, digit 0 first
+  uint8_t  on;        // oscillator and display on
+  uint8_t  blink;     // HT16K33_BLINK_*
+  uint8_t  dim;       // 0..15
+};
+
+// Everything the firmware drives. Pin edges are reported at the first
+// clock read after the write, so from outframe_flush() and Timer5 alike.
+struct HostObserver {
+  virtual ~HostObserver() {}
+  virtual void pin(uint8_t pin, uint8_t level) { (void)pin; (void)level; }
+  virtual void pwm(uint8_t pin, uint8_t duty) { (void)pin; (void)duty; }
+  virtual void tone(uint8_t pin, unsigned int hz) { (void)pin; (void)hz; }
+  virtual void display(const HostDisplay& d) { (void)d; }
+  virtual void uart_tx(uint8_t uart, uint8_t b) { (void)uart; (void)b; }
+};
+void host_observe(HostObserver* o);
+
+// Text for a segment word from the backpack font, 0 when it is no character
+char host_glyph(uint16_t word);
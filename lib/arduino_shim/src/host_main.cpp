@@ -0,0 +1,193 @@
+// Native entry point: runs setup() and loop() on the virtual clock, plays a
+// beam/console trace into the pins and the console UART, and prints what the
+// firmware drove as a timeline, one event per line:
+//
+//     3000.000  IN   B1 0                 beam level as read, 0 = broken
+//     3031.204  OUT  D27 pi_show 1        output pin edge
+//     3031.950  DISP "----" dim 15        display text (or raw words), dim, blink
+//    20000.000  >    STATE 16             console line sent
+//    20000.912  CON  OK STATE 16          console output (--console)
+//
+// Trace lines (docs/bench_trace.csv):  t_ms,beam,level  or  t_ms,>,TEXT
+// ('#' starts a comment). The same trace and options always print the same
+// timeline, so two firmware revisions can be diffed line for line.
+//
+//   pio run -e native
+//   .pio/build/native/program trace.csv [--tail 25] [--console] [--audio] [--pwm]
+//                                       [--eeprom in.bin] [--save-eeprom out.bin]
+#include <string>
+#include <vector>
+
+#include <Arduino.h>
+#include "host.hpp"
+#include "pins.hpp"
+
+static const uint8_t BEAM_PIN[7] = {PIN_BEAM_0, PIN_BEAM_1, PIN_BEAM_2, PIN_BEAM_3, PIN_BEAM_4, PIN_BEAM_5, PIN_BEAM_6};
+
+struct PinName { uint8_t pin; const char* name; };
+static const PinName PIN_NAMES[] = {
+  {PIN_MAGNET_CTRL, "magnet"},   {PIN_BUZZER, "buzzer"},       {LED_ARMED, "led_armed"},
+  {LED_HOLD, "led_hold"},        {LED_COOLDOWN, "led_cooldown"}, {PIN_TECHLIGHT, "techlight"},
+  {PIN_TRIG_SHOW, "pi_show"},    {PIN_TRIG_BLOOD, "pi_blood"}, {PIN_TRIG_GRAVE, "pi_grave"},
+  {PIN_TRIG_FUR, "pi_fur"},      {PIN_TRIG_FRANKEN, "pi_franken"},
+};
+
+static const char* pin_name(uint8_t pin) {
+  for (const PinName& p : PIN_NAMES) if (p.pin == pin) return p.name;
+  return "";
+}
+
+static void stamp(const char* kind) {
+  const uint64_t ns = host_now_ns();
+  printf("%9llu.%03u  %-4s ", (unsigned long long)(ns / 1000000ULL), (unsigned)(ns / 1000ULL % 1000ULL), kind);
+}
+
+class Timeline : public HostObserver {
+public:
+  bool console = false, audio = false, pwm_on = false;
+
+  void pin(uint8_t p, uint8_t level) override {
+    pwm_[p] = 0;
+    stamp("OUT");
+    printf("D%u %s%s%u\n", p, pin_name(p), *pin_name(p) ? " " : "", level);
+  }
+
+  void pwm(uint8_t p, uint8_t duty) override {
+    if (!pwm_on || pwm_[p] == duty) return;
+    pwm_[p] = duty;
+    stamp("PWM");
+    printf("D%u %s%s%u\n", p, pin_name(p), *pin_name(p) ? " " : "", duty);
+  }
+
+  void tone(uint8_t p, unsigned int hz) override {
+    if (!audio || tone_[p] == hz) return;
+    tone_[p] = hz;
+    stamp("TONE");
+    if (hz) printf("D%u %u Hz\n", p, hz); else printf("D%u off\n", p);
+  }
+
+  void display(const HostDisplay& d) override {
+    if (have_ && !memcmp(d.word, last_.word, sizeof d.word) && d.on == last_.on &&
+        d.blink == last_.blink && d.dim == last_.dim) return;
+    have_ = true;
+    last_ = d;
+    stamp("DISP");
+    if (!d.on) { printf("off\n"); return; }
+    std::string text;
+    bool glyphs = true;
+    for (uint8_t i = 0; i < 4 && glyphs; i++) {
+      const char c = host_glyph(d.word[i] & 0x3FFF);
+      if (!c) glyphs = false;
+      text += c;
+      if (d.word[i] & 0x4000) text += '.';
+    }
+    if (glyphs) printf("\"%s\"", text.c_str());
+    else        printf("raw %04X %04X %04X %04X", d.word[0], d.word[1], d.word[2], d.word[3]);
+    printf(" dim %u", d.dim);
+    if (d.blink) printf(" blink %s", d.blink == 1 ? "2Hz" : d.blink == 2 ? "1Hz" : "0.5Hz");
+    printf("\n");
+  }
+
+  void uart_tx(uint8_t uart, uint8_t b) override {
+    if (uart != 0 || !console) return;
+    if (b == '\n') { stamp("CON"); printf("%s\n", line_.c_str()); line_.clear(); return; }
+    if (b != '\r') line_ += ((b >= 0x20 && b < 0x7F) || b == '\t') ? (char)b : '.';
+  }
+
+private:
+  uint8_t      pwm_[70] = {0};
+  unsigned int tone_[70] = {0};
+  HostDisplay  last_;
+  bool         have_ = false;
+  std::string  line_;
+};
+
+static bool load_trace(const char* path, uint64_t& last_ns) {
+  FILE* f = fopen(path, "r");
+  if (!f) { fprintf(stderr, "cannot open %s\n", path); return false; }
+  char line[1024];
+  unsigned n = 0;
+  while (fgets(line, sizeof line, f)) {
+    n++;
+    char* hash = strchr(line, '#');
+    if (hash) *hash = 0;
+    line[strcspn(line, "\r\n")] = 0;
+    char* p = line;
+    while (*p == ' ' || *p == '\t') p++;
+    if (!*p) continue;
+
+    char* end;
+    const unsigned long t_ms = strtoul(p, &end, 10);
+    if (end == p || *end != ',') { fprintf(stderr, "%s:%u: expected t_ms,...\n", path, n); fclose(f); return false; }
+    p = end + 1;
+    const uint64_t t = (uint64_t)t_ms * 1000000ULL;
+    if (t > last_ns) last_ns = t;
+
+    if (p[0] == '>' && p[1] == ',') {
+      const std::string text = p + 2;
+      host_at(t, [text]() {
+        stamp(">");
+        printf("%s\n", text.c_str());
+        const std::string wire = text + "\n";
+        host_uart_rx(0, wire.data(), wire.size());
+      });
+      continue;
+    }
+    const long beam = strtol(p, &end, 10);
+    if (end == p || *end != ',' || beam < 0 || beam > 6) { fprintf(stderr, "%s:%u: beam must be 0..6\n", path, n); fclose(f); return false; }
+    const uint8_t level = atoi(end + 1) ? HIGH : LOW;
+    host_at(t, [beam, level]() {
+      host_set_input(BEAM_PIN[beam], level);
+      stamp("IN");
+      printf("B%ld %u\n", beam, level);
+    });
+  }
+  fclose(f);
+  return true;
+}
+
+static bool file_io(const char* path, bool save) {
+  FILE* f = fopen(path, save ? "wb" : "rb");
+  if (!f) { fprintf(stderr, "cannot open %s\n", path); return false; }
+  const size_t n = save ? fwrite(host_eeprom(), 1, 4096, f) : fread(host_eeprom(), 1, 4096, f);
+  fclose(f);
+  return save ? n == 4096 : true;
+}
+
+int main(int argc, char** argv) {
+  Timeline tl;
+  const char* trace = nullptr;
+  const char* save_ee = nullptr;
+  double tail_s = 25.0;
+
+  for (int i = 1; i < argc; i++) {
+    const std::string a = argv[i];
+    if      (a == "--console") tl.console = true;
+    else if (a == "--audio")   tl.audio = true;
+    else if (a == "--pwm")     tl.pwm_on = true;
+    else if (a == "--tail" && i + 1 < argc)        tail_s = atof(argv[++i]);
+    else if (a == "--eeprom" && i + 1 < argc)      { if (!file_io(argv[++i], false)) return 2; }
+    else if (a == "--save-eeprom" && i + 1 < argc) save_ee = argv[++i];
+    else if (a[0] != '-' && !trace) trace = argv[i];
+    else {
+      fprintf(stderr, "usage: %s [trace.csv] [--tail s] [--console] [--audio] [--pwm] "
+                      "[--eeprom in.bin] [--save-eeprom out.bin]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  uint64_t last_ns = 0;
+  if (trace && !load_trace(trace, last_ns)) return 2;
+  const uint64_t end_ns = last_ns + (uint64_t)(tail_s * 1e9);
+
+  host_observe(&tl);
+  printf("# %s native, trace %s\n", HH_VERSION, trace ? trace : "(none)");
+  setup();
+  unsigned long passes = 0;
+  while (host_now_ns() < end_ns) { loop(); passes++; }
+
+  printf("# end %.3f ms, %lu loop passes, console rx dropped %u, tx blocked %.3f ms\n",
+         host_now_ns() / 1e6, passes, host_uart_rx_dropped(0), host_uart_tx_blocked_ns(0) / 1e6);
+  if (save_ee && !file_io(save_ee, true)) return 2;
+  return 0;
+}
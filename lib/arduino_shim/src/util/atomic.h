@@ -0,0 +1,14 @@
+#pragma once
+#include <avr/io.h>
+
+#define ATOMIC_RESTORESTATE 0
+#define ATOMIC_FORCEON      1
+
+// Interrupts off for the block, SREG put back on the way out
+struct HostAtomic {
+  uint8_t sreg;
+  bool    once;
+  HostAtomic() : sreg(SREG), once(true) { cli(); }
+  ~HostAtomic() { SREG = sreg; }
+};
+#define ATOMIC_BLOCK(type) for (HostAtomic host_atomic_; host_atomic_.once; host_atomic_.once = false)
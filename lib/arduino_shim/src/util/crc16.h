@@ -0,0 +1,9 @@
+// Same polynomial as avr-libc's inline asm version (CRC-16/ARC, 0xA001 reflected)
+#pragma once
+#include <stdint.h>
+
+static inline uint16_t _crc16_update(uint16_t crc, uint8_t a) {
+  crc ^= a;
+  for (uint8_t i = 0; i < 8; i++) crc = (crc & 1) ? (uint16_t)((crc >> 1) ^ 0xA001) : (uint16_t)(crc >> 1);
+  return crc;
+}
@@ -0,0 +1,64 @@
+// src/boot.cpp
+#include <Arduino.h>
+#include "boot.hpp"
+#include "console.hpp"
+#include "display.hpp"
+#include "inputs.hpp"
+#include "pilink.hpp"
+#include "prng.hpp"
+#include "settings.hpp"
+
+static uint32_t g_stamp[BOOT_N_STAGES];
+static bool     g_have[BOOT_N_STAGES];
+static uint8_t  g_step = 0;
+
+static const char STAGE_NAMES[BOOT_N_STAGES][9] PROGMEM = {
+  "SETUP", "SAFE", "ARMED", "SETTINGS", "RECOVERY", "LIVE", "BANNER", "DISPLAY", "PILINK", "DONE"
+};
+
+void boot_mark(BootStage stage) {
+  if (stage >= BOOT_N_STAGES || g_have[stage]) return;
+  g_stamp[stage] = micros();
+  g_have[stage]  = true;
+}
+
+// One step per loop() pass so no single pass blocks beam polling for long
+bool boot_deferred_step() {
+  switch (g_step) {
+    case 0:
+      console_log(F("Haunted Hearse Booting..."));
+      console_log(F("Pins: Beams D2 D3 D4 D5 D7 D9, Magnet D6, Buzzer D8, LEDs D10 D11 D12, I2C 0x70"));
+      inputs_print_banner();
+      boot_mark(BOOT_BANNER);
+      break;
+    case 1:
+      display_begin(0x70, settings_ref().brightness);
+      boot_mark(BOOT_DISPLAY);
+      break;
+    case 2:
+      pilink_begin(Serial1, 115200);
+      boot_mark(BOOT_PILINK);
+      break;
+    case 3:
+      prng_seed(prng_entropy());
+      boot_mark(BOOT_DONE);
+      console_log(F("Setup complete. Type '?' for help."));
+      break;
+    default:
+      return false;
+  }
+  g_step++;
+  return true;
+}
+
+void boot_print(Stream& s) {
+  s.println(F("=== Boot timeline (us since reset) ==="));
+  uint32_t prev = 0;
+  for (uint8_t i = 0; i < BOOT_N_STAGES; i++) {
+    s.print(F("  ")); s.print(reinterpret_cast<const __FlashStringHelper*>(STAGE_NAMES[i])); s.print(F("\t"));
+    if (!g_have[i]) { s.println(F("-")); continue; }
+    s.print(g_stamp[i]);
+    s.print(F("\t+")); s.println(g_stamp[i] - prev);
+    prev = g_stamp[i];
+  }
+}
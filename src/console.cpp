@@ -4,40 +4,97 @@
 #include "settings.hpp"
 #include "mapping.hpp"
 #include "triggers.hpp"
+#include "pilink.hpp"
+#include "boot.hpp"
+#include "recovery.hpp"
+#include "eventlog.hpp"
+#include "prng.hpp"
+#include "scenevm.hpp"
+#include "loopstats.hpp"
+#include "outframe.hpp"
+#include "outputs.hpp"
+#include "memstats.hpp"
+#include "telemetry.hpp"
+#include "uart.hpp"
+#include "display.hpp"
 #include "techlight.hpp"
 #include "pins.hpp"                 // <-- needed for PIN_* and LED_* macros
 #include "scenes/scene_frankenphone.hpp"
 
 static String inbuf;
+static const uint8_t  INBUF_MAX = 96;
+static bool     g_overflow  = false;   // current line passed INBUF_MAX, drop it at newline
+static uint32_t g_lines     = 0;
+static uint32_t g_too_long  = 0;
 
 static void print_kv(const __FlashStringHelper* k, int v) {
-  Serial.print(k); Serial.println(v);
+  Console.print(k); Console.println(v);
 }
 
 static void cmd_help() {
-  Serial.println(F("Commands:"));
-  Serial.println(F("  ? | HELP           show this help"));
-  Serial.println(F("  VER                print firmware version"));
-  Serial.println(F("  CFG                print pins and live states"));
-  Serial.println(F("  MAP                print beam -> scene map"));
-  Serial.println(F("  STATE 16           force Frankenphones Lab now"));
-  Serial.println(F("  QUIET ON|OFF       mute or unmute buzzer"));
-  Serial.println(F("  TRIG LIST          show GPIO trigger mapping"));
-  Serial.println(F("  TRIG <ROOM>        pulse GPIO for SHOW|BLOOD|GRAVE|FUR|FRANKEN"));
-  Serial.println(F("  TRIG ALL           pulse BLOOD, GRAVE, FUR, FRANKEN in sequence"));
-  Serial.println(F("  LIGHT ON|OFF|AUTO|TOGGLE   tech booth light override"));
+  Console.println(F("Commands:"));
+  Console.println(F("  ? | HELP           show this help"));
+  Console.println(F("  VER                print firmware version"));
+  Console.println(F("  CFG                print pins and live states"));
+  Console.println(F("  BOOT               boot stage timeline in us"));
+  Console.println(F("  WDT                reset cause, watchdog and warm restart stats"));
+  Console.println(F("  LOOP [RESET]       worst loop pass, per-stage max, free RAM low"));
+  Console.println(F("  DISP               display owner and arbitration counters"));
+  Console.println(F("  MEM [RESET]        free RAM, deepest stack, heap fragmentation"));
+  Console.println(F("  MAP                print beam -> scene map"));
+  Console.println(F("  STATE 16           force Frankenphones Lab now"));
+  Console.println(F("  HOLD|COOL <ms>     Frankenphone hold | cooldown (live)"));
+  Console.println(F("  SDEB|SREARM <ms>   beam debounce ceiling | re-arm (live)"));
+  Console.println(F("  SDEBMIN <ms>       adaptive debounce floor, = SDEB for a fixed window"));
+  Console.println(F("  BINSTANT <0..5|ALL> ON|OFF  fire on the leading edge (after SPULSE)"));
+  Console.println(F("  SPULSE <us>        leading-edge minimum pulse width (glitch reject)"));
+  Console.println(F("  REARM [RESET]      re-arm policy, accepted/suppressed trips per beam"));
+  Console.println(F("  REARM <0..5|ALL> <TIME|CLEAR|DOWN|ALWAYS>  join with | for any, + for all"));
+  Console.println(F("  REARM <0..5|ALL> NEXT <0..5|NONE>  downstream beam for DOWN"));
+  Console.println(F("  SCLEAR <ms>        quiet time for CLEAR re-arm"));
+  Console.println(F("  BEAMSTAT [RESET]   per-beam window, bounce histogram, chatter, short breaks"));
+  Console.println(F("  BRIGHT <0..15>     display base brightness (live)"));
+  Console.println(F("  SAVE | LOAD        journal settings to EEPROM | reload"));
+  Console.println(F("  RESET              factory defaults (not saved until SAVE)"));
+  Console.println(F("  QUIET ON|OFF       mute or unmute buzzer"));
+  Console.println(F("  TRIG LIST          show GPIO trigger mapping"));
+  Console.println(F("  TRIG <ROOM>        pulse GPIO for SHOW|BLOOD|GRAVE|FUR|FRANKEN"));
+  Console.println(F("  TRIG ALL           pulse BLOOD, GRAVE, FUR, FRANKEN in sequence"));
+  Console.println(F("  OUT                timed output channels, pending edges"));
+  Console.println(F("  OUT <ch|NAME> ON|OFF | PULSE|HOLD|EXTEND <ms> | AFTER <ms> <ms>"));
+  Console.println(F("  LIGHT ON|OFF|AUTO|TOGGLE   tech booth light override"));
+  Console.println(F("  PI CUE <n|ROOM>    send acked cue to Pi over Serial1"));
+  Console.println(F("  PI START <name>    start FPP sequence/playlist by name"));
+  Console.println(F("  PI STOP | PI PING  stop playback | round-trip check"));
+  Console.println(F("  PI STAT            link counters and round-trip times"));
+  Console.println(F("  LOG                event log status"));
+  Console.println(F("  LOG DUMP [EE]      binary dump of RAM log | last EEPROM checkpoint"));
+  Console.println(F("  LOG DRAIN          LOG DUMP, then clear (host polls this)"));
+  Console.println(F("  LOG CKPT <min>     EEPROM checkpoint period, 0 = off"));
+  Console.println(F("  LOG MARK [n] | LOG CLEAR   operator marker | empty the log"));
+  Console.println(F("  SVM                bytecode scenes: image, programs, running state"));
+  Console.println(F("  SVM RUN <n|NAME> | SVM STOP   start | stop a bytecode scene"));
+  Console.println(F("  SVM LOAD <len> | W <off> <hex> | COMMIT | ERASE   image upload (hh_scenec.py)"));
+  Console.println(F("  TEL                telemetry channels, rates and counters"));
+  Console.println(F("  TEL SUB <ch:hz>..  e.g. TEL SUB beams:100 rgb:20 loop:1, 0 Hz drops one"));
+  Console.println(F("  TEL OFF            stop all telemetry"));
+  Console.println(F("  UART               baud, ring sizes and fill, log lines dropped"));
+  Console.println(F("  UART BENCH [ms]    stream a pattern, report B/s and TX CPU % (max 500 ms)"));
+  Console.println(F("  PINBENCH           cycles per digitalRead/Write vs Pin<> on D13, Pin<> read on D7 (PORTH)"));
+  Console.println(F("  SEED [n]           effect random seed | reseed all streams (deterministic)"));
+  Console.println(F("  PRNGBENCH          cycles per random() vs the xorshift streams"));
 }
 
 static void cmd_ver() {
-  Serial.println(F("Haunted Hearse build:"));
-  Serial.println(F("  frankenphone-locked-2025-09-14-09sA"));
-  Serial.println(F("OK VER"));
+  Console.println(F("Haunted Hearse build:"));
+  Console.println(F("  frankenphone-locked-2025-09-14-09sA"));
+  Console.println(F("OK VER"));
 }
 
 static void cmd_cfg() {
-  Serial.println(F("=== CFG ==="));
-  Serial.println(F("Pins"));
-  Serial.println(F("  Beam0..5: D2 D3 D4 D5 D7 D9 (INPUT_PULLUP, active LOW)"));
+  Console.println(F("=== CFG ==="));
+  Console.println(F("Pins"));
+  Console.println(F("  Beam0..5: D2 D3 D4 D5 D7 D9 (INPUT_PULLUP, active LOW)"));
   print_kv(F("  Beam6 (reed) D"), PIN_BEAM_6);
   print_kv(F("  Magnet D"), PIN_MAGNET_CTRL);
   print_kv(F("  Buzzer D"), PIN_BUZZER);
@@ -45,92 +102,396 @@ static void cmd_cfg() {
   print_kv(F("  LED Red   D"), LED_HOLD);
   print_kv(F("  LED Yell  D"), LED_COOLDOWN);
   print_kv(F("  TechLight OUT D"), PIN_TECHLIGHT);
-  Serial.println(F("  I2C display 0x70 on SDA=20 SCL=21"));
-
-  Serial.println(F("States"));
-  Serial.print(F("  Beam0: ")); Serial.println(digitalRead(PIN_BEAM_0) == LOW ? F("BROKEN") : F("CLEAR"));
-  Serial.print(F("  Beam1: ")); Serial.println(digitalRead(PIN_BEAM_1) == LOW ? F("BROKEN") : F("CLEAR"));
-  Serial.print(F("  Beam2: ")); Serial.println(digitalRead(PIN_BEAM_2) == LOW ? F("BROKEN") : F("CLEAR"));
-  Serial.print(F("  Beam3: ")); Serial.println(digitalRead(PIN_BEAM_3) == LOW ? F("BROKEN") : F("CLEAR"));
-  Serial.print(F("  Beam4: ")); Serial.println(digitalRead(PIN_BEAM_4) == LOW ? F("BROKEN") : F("CLEAR"));
-  Serial.print(F("  Beam5: ")); Serial.println(digitalRead(PIN_BEAM_5) == LOW ? F("BROKEN") : F("CLEAR"));
-  Serial.print(F("  Reed(B6): ")); Serial.println(digitalRead(PIN_BEAM_6) == LOW ? F("CLOSED") : F("OPEN"));
-  Serial.print(F("  Magnet: ")); Serial.println(digitalRead(PIN_MAGNET_CTRL) ? F("ON") : F("OFF"));
-  Serial.print(F("  TechLight: ")); Serial.println(techlight_is_on() ? F("ON") : F("OFF"));
-  Serial.print(F("  TechLight mode: ")); Serial.println(techlight_mode_name());
-  Serial.println(F("OK CFG"));
+  Console.println(F("  I2C display 0x70 on SDA=20 SCL=21"));
+  settings_print(Console);
+
+  Console.println(F("States"));
+  Console.print(F("  Beam0: ")); Console.println(digitalRead(PIN_BEAM_0) == LOW ? F("BROKEN") : F("CLEAR"));
+  Console.print(F("  Beam1: ")); Console.println(digitalRead(PIN_BEAM_1) == LOW ? F("BROKEN") : F("CLEAR"));
+  Console.print(F("  Beam2: ")); Console.println(digitalRead(PIN_BEAM_2) == LOW ? F("BROKEN") : F("CLEAR"));
+  Console.print(F("  Beam3: ")); Console.println(digitalRead(PIN_BEAM_3) == LOW ? F("BROKEN") : F("CLEAR"));
+  Console.print(F("  Beam4: ")); Console.println(digitalRead(PIN_BEAM_4) == LOW ? F("BROKEN") : F("CLEAR"));
+  Console.print(F("  Beam5: ")); Console.println(digitalRead(PIN_BEAM_5) == LOW ? F("BROKEN") : F("CLEAR"));
+  Console.print(F("  Reed(B6): ")); Console.println(digitalRead(PIN_BEAM_6) == LOW ? F("CLOSED") : F("OPEN"));
+  Console.print(F("  Magnet: ")); Console.println(digitalRead(PIN_MAGNET_CTRL) ? F("ON") : F("OFF"));
+  Console.print(F("  TechLight: ")); Console.println(techlight_is_on() ? F("ON") : F("OFF"));
+  Console.print(F("  TechLight mode: ")); Console.println(techlight_mode_name());
+  Console.println(F("OK CFG"));
+}
+
+// "<CMD> <number>" -> number. False if the argument is missing or not numeric.
+static bool arg_u32(const String& s, uint32_t& out) {
+  int sp = s.indexOf(' ');
+  if (sp < 0 || sp + 1 >= (int)s.length() || !isDigit(s[sp + 1])) return false;
+  out = (uint32_t)s.substring(sp + 1).toInt();
+  return true;
+}
+
+static void cmd_tune(const String& up) {
+  uint32_t v;
+  if (!arg_u32(up, v)) { Console.println(F("ERR value")); return; }
+  if      (up.startsWith("HOLD "))   settings_set_hold(v);
+  else if (up.startsWith("COOL "))   settings_set_cool(v);
+  else if (up.startsWith("SDEB "))   settings_set_debounce((uint16_t)min(v, 65535UL));
+  else if (up.startsWith("SDEBMIN ")) settings_set_debounce_min((uint16_t)min(v, 65535UL));
+  else if (up.startsWith("SPULSE "))  settings_set_min_pulse((uint16_t)min(v, 65535UL));
+  else if (up.startsWith("SCLEAR "))  settings_set_rearm_clear((uint16_t)min(v, 65535UL));
+  else if (up.startsWith("SREARM ")) settings_set_rearm(v);
+  else if (up.startsWith("BRIGHT ")) settings_set_brightness((uint8_t)min(v, 15UL));
+  Console.print(F("OK ")); Console.println(up);
+}
+
+// "0".."5" -> bit, "ALL" -> all six beams, 0 if neither
+static uint8_t beam_bits(const String& who) {
+  if (who == "ALL") return 0x3F;
+  if (who.length() == 1 && who[0] >= '0' && who[0] <= '5') return 1 << (who[0] - '0');
+  return 0;
+}
+
+// BINSTANT <beam|ALL> ON|OFF
+static void cmd_binstant(const String& up) {
+  const int sp = up.indexOf(' ', 9);
+  if (sp < 0) { Console.println(F("ERR BINSTANT <0..5|ALL> ON|OFF")); return; }
+  const String who = up.substring(9, sp);
+  const String how = up.substring(sp + 1);
+  const uint8_t bits = beam_bits(who);
+  if (!bits) { Console.println(F("ERR BINSTANT <0..5|ALL> ON|OFF")); return; }
+
+  uint8_t mask = settings_ref().beam_instant;
+  if      (how == "ON")  mask |= bits;
+  else if (how == "OFF") mask &= ~bits;
+  else { Console.println(F("ERR BINSTANT <0..5|ALL> ON|OFF")); return; }
+  settings_set_beam_instant(mask);
+  Console.print(F("OK BINSTANT 0x")); Console.println(mask, HEX);
+}
+
+// REARM <beam|ALL> <TIME|CLEAR|DOWN joined by | or +, or ALWAYS>
+// REARM <beam|ALL> NEXT <beam|NONE>
+static void cmd_rearm(const String& up) {
+  const int sp = up.indexOf(' ', 6);
+  const uint8_t bits = sp > 0 ? beam_bits(up.substring(6, sp)) : 0;
+  if (!bits) { Console.println(F("ERR REARM <0..5|ALL> <policy> | NEXT <0..5|NONE>")); return; }
+  String arg = up.substring(sp + 1);
+  arg.trim();
+
+  uint8_t pol[6];
+  for (uint8_t i = 0; i < 6; i++) {
+    uint8_t p = pol[i] = settings_ref().beam_rearm[i];
+    if (!(bits & (1 << i))) continue;
+    if (arg.startsWith("NEXT ")) {
+      const String n = arg.substring(5);
+      uint8_t next;
+      if (n == "NONE") next = 0x0F;
+      else if (n.length() == 1 && n[0] >= '0' && n[0] <= '5') next = n[0] - '0';
+      else { Console.println(F("ERR REARM NEXT <0..5|NONE>")); return; }
+      p = (uint8_t)((next << 4) | (p & 0x0F));
+    } else {
+      uint8_t mode = 0;
+      if (arg != "ALWAYS") {
+        if (arg.indexOf('+') >= 0) mode |= REARM_ALL;
+        if (arg.indexOf("TIME")  >= 0) mode |= REARM_TIME;
+        if (arg.indexOf("CLEAR") >= 0) mode |= REARM_CLEAR;
+        if (arg.indexOf("DOWN")  >= 0) mode |= REARM_DOWN;
+        if (!(mode & ~REARM_ALL)) { Console.println(F("ERR REARM policy TIME|CLEAR|DOWN|ALWAYS")); return; }
+      }
+      p = (uint8_t)((p & 0xF0) | mode);
+    }
+    // DOWN waits for the downstream beam; without one the beam would never re-arm
+    if ((p & REARM_DOWN) && (REARM_NEXT(p) > 5 || REARM_NEXT(p) == i)) {
+      Console.print(F("ERR REARM B")); Console.print(i);
+      Console.println(F(" DOWN needs NEXT set to another beam (REARM <b> NEXT <0..5> first)"));
+      return;
+    }
+    pol[i] = p;
+  }
+  for (uint8_t i = 0; i < 6; i++) if (bits & (1 << i)) settings_set_rearm_policy(i, pol[i]);
+  Console.print(F("OK ")); Console.println(up);
 }
 
 static void cmd_state(const String& s) {
   int sp = s.indexOf(' ');
-  if (sp < 0) { Serial.println(F("ERR STATE")); return; }
+  if (sp < 0) { Console.println(F("ERR STATE")); return; }
   int code = s.substring(sp + 1).toInt();
   if (code == 16) {
     scene_frankenphone();
-    Serial.println(F("OK STATE 16"));
+    Console.println(F("OK STATE 16"));
   } else {
-    Serial.println(F("ERR STATE unsupported"));
+    Console.println(F("ERR STATE unsupported"));
   }
 }
 
 static void cmd_quiet(const String& s) {
-  if (s.endsWith(" ON"))  { frankenphone_set_mute(true);  Serial.println(F("OK QUIET ON"));  return; }
-  if (s.endsWith(" OFF")) { frankenphone_set_mute(false); Serial.println(F("OK QUIET OFF")); return; }
-  Serial.println(F("ERR QUIET use ON or OFF"));
+  if (s.endsWith(" ON"))  { frankenphone_set_mute(true);  Console.println(F("OK QUIET ON"));  return; }
+  if (s.endsWith(" OFF")) { frankenphone_set_mute(false); Console.println(F("OK QUIET OFF")); return; }
+  Console.println(F("ERR QUIET use ON or OFF"));
 }
 
 static void cmd_trig(const String& s) {
-  if (s.endsWith(" LIST")) { triggers_print_map(); Serial.println(F("OK TRIG LIST")); return; }
+  if (s.endsWith(" LIST")) { triggers_print_map(); Console.println(F("OK TRIG LIST")); return; }
 
   if (s.endsWith(" ALL")) {
-    const char* names[4] = {"BLOOD","GRAVE","FUR","FRANKEN"};
-    for (uint8_t i=0;i<4;i++) {
-      triggers_pulse_by_name(String(names[i]));
-      Serial.print(F("TRIG ")); Serial.println(names[i]);
-      delay(500);
+    for (uint8_t i = 1; i < TRIGGERS_N; i++) {   // BLOOD, GRAVE, FUR, FRANKEN
+      triggers_pulse(i);
+      Console.print(F("TRIG ")); Console.println(triggers_name(i));
+      const unsigned long t0 = millis();
+      while (millis() - t0 < 600) { outputs_update(); outframe_flush(); }   // end the pulse on time while waiting
+      recovery_kick();   // 600 ms per step, inside the 1 s watchdog window
     }
-    Serial.println(F("OK TRIG ALL"));
+    Console.println(F("OK TRIG ALL"));
     return;
   }
 
   int sp = s.indexOf(' ');
-  if (sp < 0 || sp+1 >= (int)s.length()) { Serial.println(F("ERR TRIG")); return; }
+  if (sp < 0 || sp+1 >= (int)s.length()) { Console.println(F("ERR TRIG")); return; }
   String name = s.substring(sp + 1);
   name.trim();
   name.toUpperCase();
   if (triggers_pulse_by_name(name)) {
-    Serial.print(F("OK TRIG ")); Serial.println(name);
+    Console.print(F("OK TRIG ")); Console.println(name);
   } else {
-    Serial.println(F("ERR TRIG name (use BLOOD|GRAVE|FUR|FRANKEN)"));
+    Console.println(F("ERR TRIG name (use BLOOD|GRAVE|FUR|FRANKEN)"));
   }
 }
 
+// OUT <ch|NAME> ON|OFF | PULSE|HOLD|EXTEND <ms> | AFTER <delay ms> <ms>
+static void cmd_out(const String& up) {
+  const int sp = up.indexOf(' ', 4);
+  const int8_t ch = sp > 0 ? outputs_find(up.substring(4, sp).c_str()) : -1;
+  if (ch < 0) { Console.println(F("ERR OUT <ch|NAME> ...")); return; }
+  const String op = up.substring(sp + 1);
+  const int sp2 = op.indexOf(' ');
+  const uint32_t ms = sp2 > 0 ? (uint32_t)op.substring(sp2 + 1).toInt() : 0;
+
+  if      (op == "ON")                 outputs_on(ch);
+  else if (op == "OFF")                outputs_off(ch);
+  else if (op.startsWith("PULSE "))    outputs_pulse(ch, ms);
+  else if (op.startsWith("HOLD "))     outputs_hold_for(ch, ms);
+  else if (op.startsWith("EXTEND ")) {
+    if (!outputs_extend(ch, ms)) { Console.println(F("ERR OUT EXTEND channel not timed on")); return; }
+  } else if (op.startsWith("AFTER ")) {
+    const int sp3 = op.indexOf(' ', sp2 + 1);
+    if (sp3 < 0) { Console.println(F("ERR OUT AFTER <delay ms> <ms>")); return; }
+    outputs_pulse_after(ch, ms, (uint32_t)op.substring(sp3 + 1).toInt());
+  } else { Console.println(F("ERR OUT ON|OFF|PULSE|HOLD|EXTEND|AFTER")); return; }
+  Console.print(F("OK ")); Console.println(up);
+}
+
+static void cmd_pi(const String& up, const String& line) {
+  if (up == "PI STAT") { pilink_print_stats(Console); Console.println(F("OK PI STAT")); return; }
+  if (up == "PI PING") { Console.println(pilink_ping() ? F("OK PI PING") : F("ERR PI busy")); return; }
+  if (up == "PI STOP") { Console.println(pilink_stop() ? F("OK PI STOP") : F("ERR PI busy")); return; }
+
+  if (up.startsWith("PI START ")) {
+    String name = line.substring(9);   // keep case, FPP names are case sensitive
+    name.trim();
+    if (pilink_start(name.c_str())) { Console.print(F("OK PI START ")); Console.println(name); }
+    else                            Console.println(F("ERR PI START (1..16 chars, or busy)"));
+    return;
+  }
+
+  if (up.startsWith("PI CUE ")) {
+    String arg = up.substring(7);
+    arg.trim();
+    int cue = triggers_index(arg);   // room names map to the same 0..4 as the opto lines
+    if (cue < 0 && arg.length() && isDigit(arg[0])) cue = arg.toInt();
+    if (cue < 0 || cue > 255) { Console.println(F("ERR PI CUE (0..255 or room name)")); return; }
+    if (pilink_cue((uint8_t)cue)) { Console.print(F("OK PI CUE ")); Console.println(cue); }
+    else                          Console.println(F("ERR PI busy"));
+    return;
+  }
+
+  Console.println(F("ERR PI (CUE|START|STOP|PING|STAT)"));
+}
+
+static void cmd_log(const String& up) {
+  if (up == "LOG")       { evlog_print_status(Console); Console.println(F("OK LOG")); return; }
+  if (up == "LOG CLEAR") { evlog_clear(); Console.println(F("OK LOG CLEAR")); return; }
+
+  if (up == "LOG DUMP" || up == "LOG DUMP EE") {
+    const bool ee = up.endsWith(" EE");
+    if (evlog_dump(Console, ee)) Console.println(F("OK LOG DUMP"));
+    else                        Console.println(F("ERR LOG no valid checkpoint"));
+    return;
+  }
+
+  if (up == "LOG DRAIN") {
+    evlog_dump(Console, false);
+    evlog_clear();
+    Console.println(F("OK LOG DUMP"));
+    return;
+  }
+
+  if (up.startsWith("LOG CKPT ")) {
+    long m = up.substring(9).toInt();
+    if (m < 0 || m > 1440) { Console.println(F("ERR LOG CKPT (0..1440 min)")); return; }
+    evlog_set_checkpoint_minutes((uint16_t)m);
+    Console.print(F("OK LOG CKPT ")); Console.println(m);
+    return;
+  }
+
+  if (up == "LOG MARK" || up.startsWith("LOG MARK ")) {
+    const uint8_t id = up.length() > 9 ? (uint8_t)up.substring(9).toInt() : 0;
+    evlog_add(EV_MARK, id);
+    Console.print(F("OK LOG MARK ")); Console.println(id);
+    return;
+  }
+
+  Console.println(F("ERR LOG (DUMP|DUMP EE|DRAIN|CKPT|MARK|CLEAR)"));
+}
+
+static int8_t hex_nibble(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+// SVM W <offset> <hex>, answered with the offset so the host can match replies
+static void cmd_svm_w(const String& up) {
+  const int a = up.indexOf(' ', 6);
+  if (a < 0) { Console.println(F("ERR SVM W <off> <hex>")); return; }
+  const uint16_t off = (uint16_t)up.substring(6, a).toInt();
+  const String hex = up.substring(a + 1);
+  uint8_t buf[32];
+  const uint8_t n = hex.length() / 2;
+  if (hex.length() % 2 || n == 0 || n > sizeof(buf)) { Console.println(F("ERR SVM W 1..32 bytes")); return; }
+  for (uint8_t i = 0; i < n; i++) {
+    const int8_t hi = hex_nibble(hex[2 * i]), lo = hex_nibble(hex[2 * i + 1]);
+    if (hi < 0 || lo < 0) { Console.println(F("ERR SVM W hex")); return; }
+    buf[i] = (uint8_t)(hi << 4 | lo);
+  }
+  if (svm_load_busy())                 { Console.println(F("ERR SVM busy")); return; }
+  if (!svm_load_write(off, buf, n))    { Console.println(F("ERR SVM W not loading or past end")); return; }
+  Console.print(F("OK SVM W ")); Console.println(off);
+}
+
+static void cmd_svm(const String& up) {
+  if (up == "SVM")        { svm_print(Console); Console.println(F("OK SVM")); return; }
+  if (up == "SVM STOP")   { svm_stop(); Console.println(F("OK SVM STOP")); return; }
+  if (up == "SVM ERASE")  { svm_erase(); Console.println(F("OK SVM ERASE")); return; }
+  if (up == "SVM COMMIT") {
+    if (svm_load_commit()) Console.println(F("OK SVM COMMIT"));
+    else if (*svm_bad_channel()) { Console.print(F("ERR SVM COMMIT unknown channel ")); Console.println(svm_bad_channel()); }
+    else                   Console.println(F("ERR SVM COMMIT image rejected (crc or bytecode)"));
+    return;
+  }
+  if (up.startsWith("SVM W "))   { cmd_svm_w(up); return; }
+  if (up.startsWith("SVM RUN ")) {
+    String arg = up.substring(8);
+    arg.trim();
+    const int8_t p = svm_find(arg.c_str());
+    if (p >= 0 && svm_run(p)) { Console.print(F("OK SVM RUN ")); Console.println(p); }
+    else                      Console.println(F("ERR SVM RUN unknown program"));
+    return;
+  }
+  if (up.startsWith("SVM LOAD ")) {
+    uint32_t len = 0;
+    if (!arg_u32(up.substring(4), len) || len > 0xFFFF || !svm_load_begin((uint16_t)len)) {
+      Console.println(F("ERR SVM LOAD <len> (image too big)"));
+      return;
+    }
+    Console.print(F("OK SVM LOAD ")); Console.println(len);
+    return;
+  }
+  Console.println(F("ERR SVM (RUN|STOP|LOAD|W|COMMIT|ERASE)"));
+}
+
+static void cmd_tel(const String& up) {
+  if (up == "TEL")     { telemetry_print(Console); Console.println(F("OK TEL")); return; }
+  if (up == "TEL OFF") { telemetry_off(); Console.println(F("OK TEL OFF")); return; }
+  if (up.startsWith("TEL SUB ") && telemetry_subscribe(up.substring(8))) {
+    Console.print(F("OK ")); Console.println(up);
+    return;
+  }
+  Console.println(F("ERR TEL (SUB scene|beams|out|rgb|light|loop|studio:<hz> ...|OFF)"));
+}
+
+static void cmd_loop() {
+  loopstats_print(Console);
+  Console.print(F("  console lines ")); Console.print(g_lines);
+  Console.print(F("  too long ")); Console.println(g_too_long);
+  Console.println(F("OK LOOP"));
+}
+
 static void handle_line(String line) {
   line.trim();
   if (line.length() == 0) return;
-  Serial.print(F("> ")); Serial.println(line);
+  Console.print(F("> ")); Console.println(line);
 
   String up = line; up.toUpperCase();
 
   if (up == "?" || up == "HELP") { cmd_help(); return; }
   if (up == "VER")               { cmd_ver();  return; }
   if (up == "CFG")               { cmd_cfg();  return; }
-  if (up == "MAP")               { inputs_print_map(); Serial.println(F("OK MAP")); return; }
+  if (up == "BOOT")              { boot_print(Console); Console.println(F("OK BOOT")); return; }
+  if (up == "WDT")               { recovery_print(Console); Console.println(F("OK WDT")); return; }
+  if (up == "LOOP")              { cmd_loop(); return; }
+  if (up == "LOOP RESET")        { loopstats_reset(); g_lines = g_too_long = 0; Console.println(F("OK LOOP RESET")); return; }
+  if (up == "MEM")               { mem_print(Console); Console.println(F("OK MEM")); return; }
+  if (up == "MEM RESET")         { mem_repaint(); Console.println(F("OK MEM RESET")); return; }
+  if (up == "DISP")              { display_print_stats(Console); Console.println(F("OK DISP")); return; }
+  if (up == "MAP")               { inputs_print_map(); Console.println(F("OK MAP")); return; }
   if (up.startsWith("STATE"))    { cmd_state(up); return; }
+  if (up.startsWith("HOLD ") || up.startsWith("COOL ") || up.startsWith("SDEB ") ||
+      up.startsWith("SDEBMIN ") || up.startsWith("SPULSE ") || up.startsWith("SCLEAR ") ||
+      up.startsWith("SREARM ") || up.startsWith("BRIGHT ")) { cmd_tune(up); return; }
+  if (up.startsWith("BINSTANT "))  { cmd_binstant(up); return; }
+  if (up == "REARM")             { inputs_print_rearm(Console); Console.println(F("OK REARM")); return; }
+  if (up == "REARM RESET")       { inputs_stats_reset(); Console.println(F("OK REARM RESET")); return; }
+  if (up.startsWith("REARM "))   { cmd_rearm(up); return; }
+  if (up == "BEAMSTAT")          { inputs_print_stats(Console); Console.println(F("OK BEAMSTAT")); return; }
+  if (up == "BEAMSTAT RESET")    { inputs_stats_reset(); Console.println(F("OK BEAMSTAT RESET")); return; }
+  if (up == "SAVE")              { Console.println(settings_save() ? F("OK SAVE") : F("ERR SAVE record too large, nothing written")); return; }
+  if (up == "LOAD")              { Console.println(settings_load() ? F("OK LOAD") : F("ERR LOAD no valid record")); return; }
+  if (up == "RESET")             { settings_reset_defaults(false); Console.println(F("OK RESET")); return; }
   if (up.startsWith("QUIET"))    { cmd_quiet(up); return; }
   if (up.startsWith("TRIG"))     { cmd_trig(up); return; }
+  if (up == "OUT")               { outputs_print(Console); outframe_print(Console); Console.println(F("OK OUT")); return; }
+  if (up.startsWith("OUT "))     { cmd_out(up); return; }
+  if (up == "PI" || up.startsWith("PI ")) { cmd_pi(up, line); return; }
+  if (up == "LOG" || up.startsWith("LOG ")) { cmd_log(up); return; }
+  if (up == "SVM" || up.startsWith("SVM ")) { cmd_svm(up); return; }
+  if (up == "TEL" || up.startsWith("TEL ")) { cmd_tel(up); return; }
+  if (up == "UART")              { uart_print(Console); Console.println(F("OK UART")); return; }
+  if (up == "PINBENCH")          { pin_bench(Console); Console.println(F("OK PINBENCH")); return; }
+  if (up == "PRNGBENCH")         { prng_bench(Console); Console.println(F("OK PRNGBENCH")); return; }
+  if (up == "SEED")              { Console.print(F("  seed 0x")); Console.println(prng_seed_value(), HEX); Console.println(F("OK SEED")); return; }
+  if (up.startsWith("SEED ")) {
+    uint32_t v;
+    if (!arg_u32(up, v)) { Console.println(F("ERR SEED <n>")); return; }
+    prng_seed(v);
+    Console.print(F("OK SEED ")); Console.println(v);
+    return;
+  }
+  if (up.startsWith("UART BENCH")) {
+    uint32_t ms = 200;
+    if (up.length() > 10 && !arg_u32(up.substring(6), ms)) { Console.println(F("ERR UART BENCH [ms]")); return; }
+    uart_bench((uint16_t)min(ms, 500UL));
+    Console.println(F("OK UART BENCH"));
+    return;
+  }
 
-  Serial.println(F("ERR unknown"));
+  Console.println(F("ERR unknown"));
 }
 
 void console_update() {
-  while (Serial.available()) {
-    char c = (char)Serial.read();
+  while (Console.available()) {
+    char c = (char)Console.read();
     if (c == '\r') continue;
-    if (c == '\n') { handle_line(inbuf); inbuf = ""; }
-    else if (inbuf.length() < 96) inbuf += c;
+    if (c == '\n') {
+      g_lines++;
+      // A truncated line could still parse as a different command, so never run it
+      if (g_overflow) { g_too_long++; Console.println(F("ERR line too long")); }
+      else            handle_line(inbuf);
+      inbuf = "";
+      g_overflow = false;
+    }
+    else if (inbuf.length() < INBUF_MAX) inbuf += c;
+    else g_overflow = true;
   }
 }
 
-void console_log(const char* msg)   { Serial.println(msg); }
-void console_log(const String& msg) { Serial.println(msg); }
\ No newline at end of file
+// Log lines never block loop(); see uart_log_nb()
+void console_log(const char* msg)   { uart_log_nb(Console, nullptr, msg); }
+void console_log(const String& msg) { uart_log_nb(Console, nullptr, msg.c_str()); }
+void console_log(const __FlashStringHelper* msg) { uart_log_nb(Console, msg, nullptr); }
+void console_log(const __FlashStringHelper* msg, const char* detail) { uart_log_nb(Console, msg, detail); }
\ No newline at end of file
@@ -4,37 +4,102 @@
 #include <Adafruit_GFX.h>
 #include <Adafruit_LEDBackpack.h>
 #include "display.hpp"
+#include "eventlog.hpp"
+#include "prof.hpp"
 
 static Adafruit_AlphaNum4 g_alpha;
 static bool     g_inited = false;
 
-static char     g_owner[16] = "";      // current owner tag
+static char     g_owner[8]  = "";      // RAM copy of the current owner tag
 static uint8_t  g_prio      = 0;       // current owner priority
 static uint32_t g_hold_until= 0;       // 0 = indefinite
 static char     g_last4[5]  = "    ";
-static uint8_t  g_bright    = 8;       // 0..15
+static uint16_t g_seg[4]    = {0, 0, 0, 0};     // segment words on the display
+static bool     g_raw       = false;   // last frame was raw segments, g_last4 is stale
+static uint8_t  g_bright    = 8;       // 0..15, current hardware level
+static uint8_t  g_base      = 8;       // 0..15, level restored when no one owns the display
+static uint8_t  g_blink     = DISP_BLINK_OFF;   // current hardware blink
+static uint8_t  g_base_blink= DISP_BLINK_OFF;   // blink restored when no one owns the display
+
+// Owner brightness ramp, one level per step
+static bool     g_ramp      = false;
+static uint8_t  g_ramp_to   = 0;
+static uint16_t g_ramp_step = 0;       // ms per level
+static uint32_t g_ramp_next = 0;
+
+// Arbitration counters for the DISP command
+static uint32_t g_n_grant   = 0;       // ownership changes
+static uint32_t g_n_preempt = 0;       // a higher priority took it from a live owner
+static uint32_t g_n_denied  = 0;       // acquire refused, lower or equal priority
+static uint32_t g_n_expired = 0;
+static uint32_t g_n_writes  = 0;       // I2C transactions: text, brightness, blink
 
 static inline uint32_t now_ms() { return millis(); }
 
+static void hw_brightness(uint8_t level) {
+  if (level == g_bright) return;
+  g_bright = level;
+  if (g_inited) { g_alpha.setBrightness(level); g_n_writes++; }
+}
+
+static void hw_blink(uint8_t rate) {
+  if (rate == g_blink) return;
+  g_blink = rate;
+  if (g_inited) { g_alpha.blinkRate(rate); g_n_writes++; }
+}
+
+// Scenes may dim, boost, blink or ramp while they own the display; undo that when they let go
+static void restore_base() {
+  g_ramp = false;
+  if (!g_inited) return;
+  hw_brightness(g_base);
+  hw_blink(g_base_blink);
+}
+
+// Ownership changes go to the event log, owner packed into the arg as up to 4 chars
+static void log_owner(const char* owner, uint8_t prio) {
+  uint32_t tag = 0;
+  for (uint8_t i = 0; owner && i < 4; i++) {
+    const uint8_t c = pgm_read_byte(owner + i);
+    if (!c) break;
+    tag |= (uint32_t)c << (8 * i);
+  }
+  evlog_add(EV_DISPLAY, prio, tag);
+}
+
 static void maybe_expire() {
   if (g_owner[0] && g_hold_until && now_ms() > g_hold_until) {
     g_owner[0] = '\0';
     g_prio     = 0;
     g_hold_until = 0;
+    restore_base();
+    g_n_expired++;
+    log_owner(nullptr, 0);
   }
 }
 
 void display_begin(uint8_t i2c_addr, uint8_t brightness) {
   if (!g_inited) {
     Wire.begin();
+#if defined(WIRE_HAS_TIMEOUT)
+    // A stuck bus aborts the transfer instead of hanging loop() until the watchdog bites
+    Wire.setWireTimeout(25000, true);
+#endif
     g_alpha.begin(i2c_addr);
     g_inited = true;
   }
   g_bright = constrain(brightness, 0, 15);
+  g_base   = g_bright;
+  g_blink  = g_base_blink;
+  g_ramp   = false;
   g_alpha.setBrightness(g_bright);
+  g_alpha.blinkRate(g_blink);
   g_alpha.clear();
   g_alpha.writeDisplay();
+  g_n_writes += 3;
   strcpy(g_last4, "    ");
+  memset(g_seg, 0, sizeof(g_seg));
+  g_raw = false;
   g_owner[0] = '\0';
   g_prio     = 0;
   g_hold_until = 0;
@@ -44,19 +109,28 @@ bool display_is_free() { maybe_expire(); return g_owner[0] == '\0'; }
 
 bool display_is_owner(const char* owner) {
   maybe_expire();
-  return owner && g_owner[0] && strcmp(owner, g_owner) == 0;
+  return owner && g_owner[0] && strcmp_P(g_owner, owner) == 0;
 }
 
 bool display_acquire(const char* owner, uint8_t priority, uint32_t hold_ms) {
-  if (!owner || !owner[0]) return false;
+  if (!owner || !pgm_read_byte(owner)) return false;
   maybe_expire();
-  if (!g_owner[0] || strcmp(owner, g_owner) == 0 || priority > g_prio) {
-    strncpy(g_owner, owner, sizeof(g_owner)-1);
+  const bool same = strcmp_P(g_owner, owner) == 0;
+  if (!g_owner[0] || same || priority > g_prio) {
+    if (!same) {
+      if (g_owner[0]) g_n_preempt++;
+      g_n_grant++;
+      log_owner(owner, priority);
+      g_ramp = false;            // effects stay with the owner that set them
+      hw_blink(DISP_BLINK_OFF);
+    }
+    strncpy_P(g_owner, owner, sizeof(g_owner)-1);
     g_owner[sizeof(g_owner)-1] = '\0';
     g_prio = priority;
     g_hold_until = hold_ms ? (now_ms() + hold_ms) : 0;
     return true;
   }
+  g_n_denied++;
   return false;
 }
 
@@ -71,20 +145,66 @@ void display_release(const char* owner) {
   g_owner[0] = '\0';
   g_prio = 0;
   g_hold_until = 0;
+  restore_base();
+  log_owner(nullptr, 0);
+}
+
+void display_set_brightness(uint8_t level) {
+  g_base = constrain(level, 0, 15);
+  if (!g_owner[0]) restore_base(); // an owner keeps its level until release
+}
+
+void display_set_blink(DisplayBlink rate) {
+  g_base_blink = rate & 3;
+  if (!g_owner[0]) restore_base();
+}
+
+uint16_t display_glyph(char c) {
+  // The font table is private to the library: let it look the char up into
+  // a buffer word that every frame overwrites anyway
+  g_alpha.writeDigitAscii(0, (uint8_t)c);
+  return g_alpha.displaybuffer[0];
+}
+
+void display_glyphs(uint16_t* out, const char* s, uint8_t n) {
+  for (uint8_t i = 0; i < n; i++) out[i] = display_glyph(s && *s ? *s++ : ' ');
+}
+
+void display_glyphs_P(uint16_t* out, PGM_P s, uint8_t n) {
+  char c = s ? pgm_read_byte(s) : 0;
+  for (uint8_t i = 0; i < n; i++) {
+    out[i] = display_glyph(c ? c : ' ');
+    if (c) c = pgm_read_byte(++s);
+  }
+}
+
+static void hw_segments(const uint16_t* w4) {
+  if (memcmp(w4, g_seg, sizeof(g_seg)) == 0) return; // avoid redundant I2C writes
+  PROF_BEGIN(PROF_I2C);
+  for (uint8_t i = 0; i < 4; i++) g_alpha.writeDigitRaw(i, w4[i]);
+  g_alpha.writeDisplay();
+  PROF_END(PROF_I2C);
+  g_n_writes++;
+  memcpy(g_seg, w4, sizeof(g_seg));
 }
 
 static void hw_show4(const char* s4) {
+  if (!g_inited) return; // fast-arm boot: scenes may run before display_begin()
   char buf[5] = {' ',' ',' ',' ','\0'};
   for (uint8_t i=0;i<4;i++) buf[i] = s4 && s4[i] ? s4[i] : ' ';
-  if (strncmp(buf, g_last4, 4) == 0) return; // avoid redundant I2C writes
-  g_alpha.clear();
-  g_alpha.writeDigitAscii(0, buf[0]);
-  g_alpha.writeDigitAscii(1, buf[1]);
-  g_alpha.writeDigitAscii(2, buf[2]);
-  g_alpha.writeDigitAscii(3, buf[3]);
-  g_alpha.writeDisplay();
+  if (!g_raw && strncmp(buf, g_last4, 4) == 0) return; // same text, skip the font lookups
+  uint16_t w[4];
+  display_glyphs(w, buf, 4);
+  hw_segments(w);
   memcpy(g_last4, buf, 4);
   g_last4[4] = '\0';
+  g_raw = false;
+}
+
+static void hw_raw4(const uint16_t* w4) {
+  if (!g_inited) return;
+  hw_segments(w4);
+  g_raw = true;
 }
 
 void display_print4_unchecked(const char* s4) { hw_show4(s4); }
@@ -94,17 +214,85 @@ void display_print4_owned(const char* owner, const char* s4) {
   hw_show4(s4);
 }
 
+void display_segments_owned(const char* owner, const uint16_t* w4) {
+  if (!display_is_owner(owner)) return;
+  hw_raw4(w4);
+}
+
+void display_segments_owned_P(const char* owner, const uint16_t* w4) {
+  if (!display_is_owner(owner)) return;
+  uint16_t w[4];
+  memcpy_P(w, w4, sizeof(w));
+  hw_raw4(w);
+}
+
 bool display_set_brightness_owned(const char* owner, uint8_t level) {
   if (!display_is_owner(owner)) return false;
-  uint8_t l = constrain(level, 0, 15);
-  if (l == g_bright) return true;
-  g_bright = l;
-  g_alpha.setBrightness(g_bright);
+  g_ramp = false;
+  hw_brightness(constrain(level, 0, 15));
   return true;
 }
 
+bool display_blink_owned(const char* owner, DisplayBlink rate) {
+  if (!display_is_owner(owner)) return false;
+  hw_blink(rate & 3);
+  return true;
+}
+
+bool display_ramp_owned(const char* owner, uint8_t level, uint32_t ms) {
+  if (!display_is_owner(owner)) return false;
+  const uint8_t to = constrain(level, 0, 15);
+  const uint8_t steps = to > g_bright ? to - g_bright : g_bright - to;
+  if (!steps || !ms) { g_ramp = false; hw_brightness(to); return true; }
+  g_ramp_to   = to;
+  g_ramp_step = (uint16_t)min(ms / steps, 65535UL);
+  g_ramp_next = now_ms() + g_ramp_step;
+  g_ramp      = true;
+  return true;
+}
+
+bool display_ramping() { return g_ramp; }
+
+void display_update() {
+  if (!g_ramp) return;
+  maybe_expire();                        // an expired owner's ramp ends with it
+  const uint32_t now = now_ms();
+  if (!g_ramp || (int32_t)(now - g_ramp_next) < 0) return;
+  hw_brightness(g_bright < g_ramp_to ? g_bright + 1 : g_bright - 1);
+  g_ramp_next += g_ramp_step;
+  if (g_bright == g_ramp_to) g_ramp = false;
+}
+
 void display_idle(const char* s4) {
   maybe_expire();
   if (g_owner[0]) return; // someone else owns it
   hw_show4(s4);
-}
\ No newline at end of file
+}
+
+void display_idle_P(PGM_P s4) {
+  char buf[5];
+  strncpy_P(buf, s4, 4);
+  buf[4] = '\0';
+  display_idle(buf);
+}
+
+void display_print_stats(Stream& s) {
+  maybe_expire();
+  s.println(F("=== Display ==="));
+  s.print(F("  owner ")); s.print(g_owner[0] ? g_owner : "-");
+  s.print(F("  prio ")); s.print(g_prio);
+  if (g_raw) {
+    s.print(F("  raw"));
+    for (uint8_t i = 0; i < 4; i++) { s.print(' '); s.print(g_seg[i], HEX); }
+  } else {
+    s.print(F("  text '")); s.print(g_last4); s.print(F("'"));
+  }
+  s.print(F("  bright ")); s.print(g_bright); s.print(F("/")); s.print(g_base);
+  if (g_ramp) { s.print(F(" ->")); s.print(g_ramp_to); }
+  s.print(F("  blink ")); s.print(g_blink); s.print(F("/")); s.println(g_base_blink);
+  s.print(F("  grants ")); s.print(g_n_grant);
+  s.print(F("  preempted ")); s.print(g_n_preempt);
+  s.print(F("  denied ")); s.print(g_n_denied);
+  s.print(F("  expired ")); s.print(g_n_expired);
+  s.print(F("  writes ")); s.println(g_n_writes);
+}
@@ -1,6 +1,8 @@
 // effects.cpp
 #include "effects.hpp"
 #include "pins.hpp"
+#include "outframe.hpp"
+#include "prng.hpp"
 #include <Arduino.h>
 
 // ===== Internal RGB state for telemetry =====
@@ -18,18 +20,16 @@ void effects_getRGB(uint8_t& r, uint8_t& g, uint8_t& b) {
 
 // ===== Hardware status LEDs on the Mega (not pixels) =====
 static inline void leds_all_off() {
-  digitalWrite(LED_ARMED, LOW);
-  digitalWrite(LED_HOLD, LOW);
-  digitalWrite(LED_COOLDOWN, LOW);
+  outframe_write<LED_ARMED>(LOW);
+  outframe_write<LED_HOLD>(LOW);
+  outframe_write<LED_COOLDOWN>(LOW);
 }
 
 void effects_begin() {
-  pinMode(LED_ARMED, OUTPUT);
-  pinMode(LED_HOLD, OUTPUT);
-  pinMode(LED_COOLDOWN, OUTPUT);
-  leds_all_off();
+  outframe_claim(LED_ARMED, true);
+  outframe_claim(LED_HOLD);
+  outframe_claim(LED_COOLDOWN);
   effects_setRGB(0, 16, 0);
-  digitalWrite(LED_ARMED, HIGH);
 }
 
 // ===== Small helpers =====
@@ -52,14 +52,14 @@ static uint8_t sin8(uint32_t t, uint32_t period_ms, uint8_t minv, uint8_t maxv)
 
 static uint8_t rand_between(uint8_t a, uint8_t b) {
   if (a > b) { uint8_t t = a; a = b; b = t; }
-  return (uint8_t)(a + (uint8_t)random(b - a + 1));
+  return (uint8_t)(a + prng_below(PRNG_EFFECTS, (uint16_t)(b - a) + 1));
 }
 
 // ===== Core scene helpers =====
 void effects_holdPulseRed(unsigned long elapsed) {
-  digitalWrite(LED_ARMED, LOW);
-  digitalWrite(LED_COOLDOWN, LOW);
-  digitalWrite(LED_HOLD, HIGH);
+  outframe_write<LED_ARMED>(LOW);
+  outframe_write<LED_COOLDOWN>(LOW);
+  outframe_write<LED_HOLD>(HIGH);
 
   uint8_t r = tri8(elapsed, 1200);
   uint8_t g = 32;
@@ -69,16 +69,16 @@ void effects_holdPulseRed(unsigned long elapsed) {
 
 void effects_updateCooldown() {
   uint32_t now = millis();
-  digitalWrite(LED_COOLDOWN, ((now / 500) & 1) ? HIGH : LOW);
-  digitalWrite(LED_ARMED, LOW);
-  digitalWrite(LED_HOLD, LOW);
+  outframe_write<LED_COOLDOWN>(((now / 500) & 1) ? HIGH : LOW);
+  outframe_write<LED_ARMED>(LOW);
+  outframe_write<LED_HOLD>(LOW);
   effects_setRGB(8, 0, 0);
 }
 
 void effects_updateArmed() {
-  digitalWrite(LED_ARMED, HIGH);
-  digitalWrite(LED_HOLD, LOW);
-  digitalWrite(LED_COOLDOWN, LOW);
+  outframe_write<LED_ARMED>(HIGH);
+  outframe_write<LED_HOLD>(LOW);
+  outframe_write<LED_COOLDOWN>(LOW);
   effects_setRGB(0, 16, 0);
 }
 
@@ -95,7 +95,7 @@ void effects_exitStrobe() {
   const uint16_t period = 100;
 
   if (now - last >= period) { on = !on; last = now; }
-  digitalWrite(LED_HOLD, on ? HIGH : LOW);
+  outframe_write<LED_HOLD>(on ? HIGH : LOW);
   effects_setRGB(on ? 255 : 0, on ? 255 : 0, on ? 255 : 0);
 }
 
@@ -113,10 +113,10 @@ void effects_fireFlicker() {
     uint8_t r = rand_between(180, 255);
     uint8_t g = rand_between(40, 90);
     effects_setRGB(r, g, 0);
-    digitalWrite(LED_HOLD, (r > 220) ? HIGH : LOW);
+    outframe_write<LED_HOLD>((r > 220) ? HIGH : LOW);
   }
-  digitalWrite(LED_ARMED, LOW);
-  digitalWrite(LED_COOLDOWN, LOW);
+  outframe_write<LED_ARMED>(LOW);
+  outframe_write<LED_COOLDOWN>(LOW);
 }
 
 // ===== Fur room =====
@@ -124,9 +124,9 @@ void effects_furPulse() {
   uint32_t now = millis();
   uint8_t v = sin8(now, 1600, 10, 180);
   effects_setRGB(v, 0, v);
-  digitalWrite(LED_HOLD, (v > 120) ? HIGH : LOW);
-  digitalWrite(LED_ARMED, LOW);
-  digitalWrite(LED_COOLDOWN, LOW);
+  outframe_write<LED_HOLD>((v > 120) ? HIGH : LOW);
+  outframe_write<LED_ARMED>(LOW);
+  outframe_write<LED_COOLDOWN>(LOW);
 }
 
 // ===== Graveyard =====
@@ -135,9 +135,9 @@ void effects_mistyGraveyard() {
   uint8_t g = sin8(now, 2800, 10, 120);
   uint8_t b = sin8(now + 700, 3200, 20, 180);
   effects_setRGB(0, g, b);
-  digitalWrite(LED_ARMED, LOW);
-  digitalWrite(LED_HOLD, LOW);
-  digitalWrite(LED_COOLDOWN, (g + b) > 200 ? HIGH : LOW);
+  outframe_write<LED_ARMED>(LOW);
+  outframe_write<LED_HOLD>(LOW);
+  outframe_write<LED_COOLDOWN>((g + b) > 200 ? HIGH : LOW);
 }
 
 // ===== Blood room =====
@@ -145,9 +145,9 @@ void effects_bloodPulse() {
   uint32_t now = millis();
   uint8_t r = sin8(now, 1400, 40, 255);
   effects_setRGB(r, 8, 8);
-  digitalWrite(LED_HOLD, (r > 180) ? HIGH : LOW);
-  digitalWrite(LED_ARMED, LOW);
-  digitalWrite(LED_COOLDOWN, LOW);
+  outframe_write<LED_HOLD>((r > 180) ? HIGH : LOW);
+  outframe_write<LED_ARMED>(LOW);
+  outframe_write<LED_COOLDOWN>(LOW);
 }
 
 void effects_bloodDrip() {
@@ -157,10 +157,10 @@ void effects_bloodDrip() {
 
   if (now >= nextSpike) {
     r = 255;
-    nextSpike = now + 600 + random(800);
+    nextSpike = now + 600 + prng_below(PRNG_BLOOD, 800);
   }
   effects_setRGB(r, 12, 12);
-  digitalWrite(LED_HOLD, (r == 255) ? HIGH : LOW);
+  outframe_write<LED_HOLD>((r == 255) ? HIGH : LOW);
 }
 
 // ===== Spider lair =====
@@ -169,20 +169,20 @@ void effects_spiderCrawl() {
   uint32_t now = millis();
   if (now >= nextBlink) {
     effects_setRGB(255, 255, 255);
-    nextBlink = now + 50 + random(250);
+    nextBlink = now + 50 + prng_below(PRNG_SPIDER, 250);
   } else {
     effects_setRGB(4, 4, 4);
   }
-  digitalWrite(LED_HOLD, HIGH);
-  digitalWrite(LED_ARMED, LOW);
-  digitalWrite(LED_COOLDOWN, LOW);
+  outframe_write<LED_HOLD>(HIGH);
+  outframe_write<LED_ARMED>(LOW);
+  outframe_write<LED_COOLDOWN>(LOW);
 }
 
 void effects_spiderEyes() {
   effects_setRGB(8, 0, 0);
-  digitalWrite(LED_HOLD, LOW);
-  digitalWrite(LED_ARMED, LOW);
-  digitalWrite(LED_COOLDOWN, LOW);
+  outframe_write<LED_HOLD>(LOW);
+  outframe_write<LED_ARMED>(LOW);
+  outframe_write<LED_COOLDOWN>(LOW);
 }
 
 void effects_spiderWebFlash() {
@@ -190,7 +190,7 @@ void effects_spiderWebFlash() {
   uint8_t v = tri8(now, 200);
   uint8_t on = v > 220 ? 255 : 0;
   effects_setRGB(on, on, on);
-  digitalWrite(LED_HOLD, on ? HIGH : LOW);
+  outframe_write<LED_HOLD>(on ? HIGH : LOW);
 }
 
 // ===== Mirror room =====
@@ -201,21 +201,21 @@ void effects_mirrorStrobe() {
   const uint16_t period = 60;
   if (now - last >= period) { on = !on; last = now; }
   effects_setRGB(on ? 255 : 0, on ? 255 : 0, on ? 255 : 0);
-  digitalWrite(LED_HOLD, on ? HIGH : LOW);
+  outframe_write<LED_HOLD>(on ? HIGH : LOW);
 }
 
 void effects_mirrorSweep() {
   uint32_t now = millis();
   uint8_t v = tri8(now, 1000);
   effects_setRGB(v, v, v);
-  digitalWrite(LED_HOLD, (v > 128) ? HIGH : LOW);
+  outframe_write<LED_HOLD>((v > 128) ? HIGH : LOW);
 }
 
 void effects_mirrorFlash() {
   uint32_t now = millis();
   uint8_t v = (tri8(now, 300) > 200) ? 255 : 0;
   effects_setRGB(v, v, v);
-  digitalWrite(LED_HOLD, v ? HIGH : LOW);
+  outframe_write<LED_HOLD>(v ? HIGH : LOW);
 }
 
 // ===== Orca scene =====
@@ -224,9 +224,9 @@ void effects_orcaBlueFade() {
   uint8_t b = sin8(now, 2000, 30, 200);
   uint8_t g = sin8(now + 400, 2400, 10, 80);
   effects_setRGB(0, g, b);
-  digitalWrite(LED_HOLD, LOW);
-  digitalWrite(LED_ARMED, LOW);
-  digitalWrite(LED_COOLDOWN, LOW);
+  outframe_write<LED_HOLD>(LOW);
+  outframe_write<LED_ARMED>(LOW);
+  outframe_write<LED_COOLDOWN>(LOW);
 }
 
 void effects_orcaWave() {
@@ -243,7 +243,7 @@ void effects_orcaSplash() {
   uint8_t b = phase;
   uint8_t g = phase / 3;
   effects_setRGB(0, g, b);
-  digitalWrite(LED_HOLD, (b > 200) ? HIGH : LOW);
+  outframe_write<LED_HOLD>((b > 200) ? HIGH : LOW);
 }
 
 // ===== Intro =====
@@ -251,9 +251,9 @@ void effects_introFade() {
   uint32_t now = millis();
   uint8_t v = sin8(now, 3000, 0, 255);
   effects_setRGB(v, v, v);
-  digitalWrite(LED_ARMED, (v > 128) ? HIGH : LOW);
-  digitalWrite(LED_HOLD, LOW);
-  digitalWrite(LED_COOLDOWN, LOW);
+  outframe_write<LED_ARMED>((v > 128) ? HIGH : LOW);
+  outframe_write<LED_HOLD>(LOW);
+  outframe_write<LED_COOLDOWN>(LOW);
 }
 
 // ===== Secret =====
@@ -262,7 +262,7 @@ void effects_secretGlow() {
   uint8_t r = sin8(now, 1800, 20, 120);
   uint8_t b = sin8(now + 600, 1800, 40, 180);
   effects_setRGB(r, 0, b);
-  digitalWrite(LED_HOLD, (r + b) > 160 ? HIGH : LOW);
+  outframe_write<LED_HOLD>((r + b) > 160 ? HIGH : LOW);
 }
 
 void effects_secretReveal() {
@@ -271,12 +271,12 @@ void effects_secretReveal() {
   uint8_t flash = pulse > 230 ? 255 : 0;
   if (flash) {
     effects_setRGB(255, 255, 255);
-    digitalWrite(LED_HOLD, HIGH);
+    outframe_write<LED_HOLD>(HIGH);
   } else {
     uint8_t r = sin8(now, 2200, 40, 120);
     uint8_t b = sin8(now + 700, 2200, 80, 200);
     effects_setRGB(r, 0, b);
-    digitalWrite(LED_HOLD, (r + b) > 160 ? HIGH : LOW);
+    outframe_write<LED_HOLD>((r + b) > 160 ? HIGH : LOW);
   }
 }
 
@@ -286,7 +286,7 @@ void effects_standbyIdle() {
   uint8_t g = sin8(now, 2400, 4, 30);
   uint8_t r = sin8(now + 900, 2400, 2, 16);
   effects_setRGB(r, g, 0);
-  digitalWrite(LED_ARMED, (g > 20) ? HIGH : LOW);
-  digitalWrite(LED_HOLD, LOW);
-  digitalWrite(LED_COOLDOWN, LOW);
+  outframe_write<LED_ARMED>((g > 20) ? HIGH : LOW);
+  outframe_write<LED_HOLD>(LOW);
+  outframe_write<LED_COOLDOWN>(LOW);
 }
\ No newline at end of file
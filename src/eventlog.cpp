@@ -0,0 +1,250 @@
+// src/eventlog.cpp
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <avr/eeprom.h> // eeprom_is_ready
+#include <util/crc16.h>
+#include "eventlog.hpp"
+#include "eeprom_map.hpp"
+
+static const uint8_t CAP = HH_EVLOG_RECORDS;
+static_assert(HH_EVLOG_RECORDS >= 2 && HH_EVLOG_RECORDS <= 255, "ring index is uint8_t");
+
+struct EvRecord {
+  uint16_t dt_ms;
+  uint8_t  type;
+  uint8_t  id;
+  uint32_t arg;
+};
+static_assert(sizeof(EvRecord) == 8, "records are 8 bytes on the wire");
+
+// ---------------- RAM ring ----------------
+static EvRecord g_ring[CAP];
+static uint8_t  g_head  = 0;     // next slot to write
+static uint8_t  g_count = 0;     // valid records
+static uint16_t g_total = 0;     // records ever added (wraps), for checkpoint bookkeeping
+static uint32_t g_t0      = 0;   // absolute ms of the oldest record
+static uint32_t g_last_ms = 0;   // absolute ms of the newest record
+
+// ---------------- EEPROM checkpoint ----------------
+// Two slots in the EEPROM area, written alternately, so a reset or brown-out
+// mid-write leaves the previous checkpoint intact and each slot wears half as fast.
+// Slot: [ 'E' 'L' ][seq u16][n u8][t0 u32][n records][crc16 over seq..records]
+// The magic is cleared first and written last: a torn slot never reads as valid.
+static const uint8_t  CK_HDR   = 9;
+static const uint16_t CK_SLOT  = EE_EVLOG_BYTES / 2;
+static const uint8_t  CK_MAX   = (CK_SLOT - CK_HDR - 2) / 8 < CAP ? (CK_SLOT - CK_HDR - 2) / 8 : CAP;  // newest records kept
+static_assert(CK_MAX >= 1, "checkpoint slot holds no records");
+
+static uint32_t g_ck_period_ms = 0;
+static uint32_t g_ck_next      = 0;
+static bool     g_ck_active    = false;
+static uint16_t g_ck_step      = 0;   // write order: clear magic, body, magic
+static uint16_t g_ck_len       = 0;
+static uint16_t g_ck_first     = 0;   // g_total index of the first record written
+static uint8_t  g_ck_n         = 0;
+static uint32_t g_ck_t0        = 0;
+static uint16_t g_ck_crc       = 0xFFFF;
+static uint8_t  g_ck_slot      = 0;   // slot being written / written next
+static uint16_t g_ck_seq       = 0;   // sequence of the next checkpoint
+static uint32_t g_ck_done      = 0;   // checkpoints completed
+static uint32_t g_ck_aborted   = 0;
+
+static void put(uint16_t dt, uint8_t type, uint8_t id, uint32_t arg) {
+  EvRecord& r = g_ring[g_head];
+  r.dt_ms = dt; r.type = type; r.id = id; r.arg = arg;
+  if (++g_head >= CAP) g_head = 0;
+  g_total++;
+
+  if (g_count < CAP) { g_count++; return; }
+
+  // Full: the oldest record was just overwritten, re-anchor t0 on the new oldest
+  const EvRecord& o = g_ring[g_head];
+  g_t0 = (o.type == EV_TIME) ? o.arg : g_t0 + o.dt_ms;
+}
+
+void evlog_clear() {
+  g_head = 0;
+  g_count = 0;
+  g_t0 = g_last_ms = millis();
+}
+
+void evlog_add(uint8_t type, uint8_t id, uint32_t arg) {
+  const uint32_t now = millis();
+  if (g_count == 0) { g_t0 = g_last_ms = now; }
+
+  uint32_t dt = now - g_last_ms;
+  if (dt > 0xFFFF) { put(0, EV_TIME, 0, now); dt = 0; }
+  put((uint16_t)dt, type, id, arg);
+  g_last_ms = now;
+}
+
+// Ring slot holding g_total index idx, or -1 if it has been overwritten
+static int16_t slot_of(uint16_t idx) {
+  const uint16_t back = g_total - idx;          // 1 = newest
+  if (back == 0 || back > g_count) return -1;
+  return (g_head >= back) ? g_head - back : g_head + CAP - back;
+}
+
+// ---------------- Checkpoint writer ----------------
+static inline uint16_t ck_base(uint8_t slot) { return EE_EVLOG_BASE + (uint16_t)slot * CK_SLOT; }
+
+static uint8_t ck_byte(uint16_t pos, bool& ok) {
+  ok = true;
+  switch (pos) {
+    case 0: return 'E';
+    case 1: return 'L';
+    case 2: case 3: return (uint8_t)(g_ck_seq >> (8 * (pos - 2)));
+    case 4: return g_ck_n;
+    case 5: case 6: case 7: case 8: return (uint8_t)(g_ck_t0 >> (8 * (pos - 5)));
+    default: break;
+  }
+  const uint16_t rel = pos - CK_HDR;
+  if (rel < (uint16_t)g_ck_n * 8) {
+    const int16_t slot = slot_of(g_ck_first + (rel >> 3));
+    if (slot < 0) { ok = false; return 0; }     // overwritten while we were writing
+    return reinterpret_cast<const uint8_t*>(&g_ring[slot])[rel & 7];
+  }
+  return (rel == (uint16_t)g_ck_n * 8) ? (uint8_t)(g_ck_crc & 0xFF) : (uint8_t)(g_ck_crc >> 8);
+}
+
+// Slot holds a complete checkpoint: magic, sane count and CRC
+static bool ck_valid(uint8_t slot, uint16_t& seq, uint8_t& n) {
+  const uint16_t b = ck_base(slot);
+  if (EEPROM.read(b) != 'E' || EEPROM.read(b + 1) != 'L') return false;
+  n = EEPROM.read(b + 4);
+  if (n > CK_MAX) return false;
+  uint16_t c = 0xFFFF;
+  for (uint16_t i = 2; i < CK_HDR + (uint16_t)n * 8; i++) c = _crc16_update(c, EEPROM.read(b + i));
+  const uint16_t at = b + CK_HDR + (uint16_t)n * 8;
+  if (c != ((uint16_t)EEPROM.read(at) | ((uint16_t)EEPROM.read(at + 1) << 8))) return false;
+  seq = (uint16_t)EEPROM.read(b + 2) | ((uint16_t)EEPROM.read(b + 3) << 8);
+  return true;
+}
+
+// Newest valid slot, or -1
+static int8_t ck_newest() {
+  uint16_t s0, s1;
+  uint8_t  n;
+  const bool v0 = ck_valid(0, s0, n), v1 = ck_valid(1, s1, n);
+  if (v0 && v1) return (int16_t)(s1 - s0) > 0 ? 1 : 0;
+  return v0 ? 0 : v1 ? 1 : -1;
+}
+
+static void ck_start() {
+  g_ck_n      = g_count < CK_MAX ? g_count : CK_MAX;
+  g_ck_first  = g_total - g_ck_n;
+  // t0 of the first record kept: walk forward from the oldest one in the ring
+  g_ck_t0     = g_t0;
+  for (uint16_t idx = g_total - g_count + 1; idx != (uint16_t)(g_ck_first + 1); idx++) {
+    const EvRecord& r = g_ring[slot_of(idx)];
+    g_ck_t0 = (r.type == EV_TIME) ? r.arg : g_ck_t0 + r.dt_ms;
+  }
+  g_ck_step   = 0;
+  g_ck_len    = CK_HDR + (uint16_t)g_ck_n * 8 + 2;
+  g_ck_crc    = 0xFFFF;
+  g_ck_active = true;
+}
+
+void evlog_update() {
+  if (g_ck_period_ms && !g_ck_active && (int32_t)(millis() - g_ck_next) >= 0) {
+    g_ck_next = millis() + g_ck_period_ms;
+    if (g_count) ck_start();
+  }
+  if (!g_ck_active || !eeprom_is_ready()) return;
+
+  // Step 0 clears the magic, steps 1..len-2 write bytes 2..len-1, then 'L', then 'E'
+  const uint16_t b = ck_base(g_ck_slot);
+  const uint16_t k = g_ck_step++;
+  if (k == 0) { EEPROM.update(b, 0x00); return; }
+  const uint16_t pos = (k < g_ck_len - 1) ? k + 1 : (k == g_ck_len - 1 ? 1 : 0);
+
+  bool ok;
+  const uint8_t v = ck_byte(pos, ok);
+  if (!ok) { g_ck_active = false; g_ck_aborted++; return; }   // slot stays invalid, the other one stands
+  if (pos >= 2 && pos < g_ck_len - 2) g_ck_crc = _crc16_update(g_ck_crc, v);
+  EEPROM.update(b + pos, v);   // starts the write, returns at once
+  if (pos == 0) {
+    g_ck_active = false;
+    g_ck_done++;
+    g_ck_seq++;
+    g_ck_slot ^= 1;
+  }
+}
+
+void evlog_begin() {
+  evlog_clear();
+  // Continue the sequence and write over the older slot first
+  uint16_t seq;
+  uint8_t  n;
+  const int8_t newest = ck_newest();
+  if (newest >= 0 && ck_valid((uint8_t)newest, seq, n)) {
+    g_ck_seq  = seq + 1;
+    g_ck_slot = (uint8_t)newest ^ 1;
+  }
+}
+
+void evlog_set_checkpoint_minutes(uint16_t minutes) {
+  g_ck_period_ms = (uint32_t)minutes * 60000UL;
+  g_ck_next = millis() + g_ck_period_ms;
+}
+
+// ---------------- Dump ----------------
+static void out(Stream& s, uint16_t& crc, const uint8_t* p, uint8_t n) {
+  for (uint8_t i = 0; i < n; i++) crc = _crc16_update(crc, p[i]);
+  s.write(p, n);
+}
+
+bool evlog_dump(Stream& s, bool from_eeprom) {
+  uint8_t  n;
+  uint32_t t0;
+  uint16_t base = 0;
+  if (from_eeprom) {
+    const int8_t slot = ck_newest();
+    uint16_t seq;
+    if (slot < 0 || !ck_valid((uint8_t)slot, seq, n)) return false;
+    base = ck_base((uint8_t)slot);
+    EEPROM.get(base + 5, t0);
+  } else {
+    n  = g_count;
+    t0 = g_t0;
+  }
+
+  s.print(F("LOG DUMP ")); s.println(n);
+  uint16_t crc = 0xFFFF;
+  s.write(reinterpret_cast<const uint8_t*>("HHLOG"), 5);
+  const uint8_t hdr[7] = { 1, n, 0,
+                           (uint8_t)t0, (uint8_t)(t0 >> 8), (uint8_t)(t0 >> 16), (uint8_t)(t0 >> 24) };
+  out(s, crc, hdr, sizeof(hdr));
+
+  const uint8_t oldest = (g_head >= g_count) ? g_head - g_count : g_head + CAP - g_count;
+  for (uint8_t k = 0; k < n; k++) {
+    uint8_t rec[8];
+    if (from_eeprom) {
+      for (uint8_t i = 0; i < 8; i++) rec[i] = EEPROM.read(base + CK_HDR + (uint16_t)k * 8 + i);
+    } else {
+      uint8_t slot = oldest + k;
+      if (slot >= CAP) slot -= CAP;
+      memcpy(rec, &g_ring[slot], 8);
+    }
+    out(s, crc, rec, 8);
+  }
+  const uint8_t tail[2] = { (uint8_t)(crc & 0xFF), (uint8_t)(crc >> 8) };
+  s.write(tail, 2);
+  s.println();
+  return true;
+}
+
+void evlog_print_status(Stream& s) {
+  s.println(F("=== Event log ==="));
+  s.print(F("  records ")); s.print(g_count); s.print(F("/")); s.print(CAP);
+  s.print(F("  added "));   s.println(g_total);
+  s.print(F("  checkpoint every "));
+  s.print(g_ck_period_ms / 60000UL); s.print(F(" min"));
+  s.print(g_ck_active ? F("  (writing)") : F(""));
+  s.print(F("  done ")); s.print(g_ck_done);
+  s.print(F("  aborted ")); s.println(g_ck_aborted);
+  const int8_t newest = ck_newest();
+  s.print(F("  EEPROM slot ")); if (newest < 0) s.print(F("none")); else s.print(newest);
+  s.print(F("  next seq ")); s.print(g_ck_seq);
+  s.print(F("  keeps newest ")); s.print(CK_MAX); s.println(F(" records"));
+}
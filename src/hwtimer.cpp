@@ -0,0 +1,190 @@
+// src/hwtimer.cpp
+#include <Arduino.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+#include "hwtimer.hpp"
+
+static const uint8_t US_PER_TICK = 64000000UL / F_CPU;   // prescaler 64
+
+enum : uint8_t { S_IDLE = 0, S_SET, S_CLEAR };            // next edge to fire
+
+struct Slot {
+  volatile uint8_t* reg;     // PORTx
+  uint8_t  mask;
+  uint8_t  pin;
+  bool     active_high;
+  volatile uint8_t state;
+  uint32_t t_set, t_clear;   // requested edges, ticks
+};
+static Slot g_slot[HWT_SLOTS];
+static volatile uint16_t g_hi = 0;   // Timer5 overflows, upper half of the tick clock
+
+// Edge error, actual minus requested, in ticks. [0] set edges, [1] clear edges.
+static uint16_t g_err_max[2];
+static uint32_t g_err_sum[2];
+static uint32_t g_err_n[2];
+static uint32_t g_windows = 0;
+static uint32_t g_no_slot = 0;
+
+static inline uint32_t to_ticks(uint32_t us) { return us / US_PER_TICK; }
+static inline uint8_t  oc_bit(uint8_t s)     { return _BV(OCIE5A + s); }   // OCIE5A..C and OCF5A..C share bit numbers
+
+static inline volatile uint16_t& ocr(uint8_t s) { return s == 0 ? OCR5A : s == 1 ? OCR5B : OCR5C; }
+
+// Interrupts off. An overflow not yet serviced counts when TCNT5 has wrapped.
+static uint32_t now_locked() {
+  uint16_t hi = g_hi;
+  const uint16_t lo = TCNT5;
+  if ((TIFR5 & _BV(TOV5)) && lo < 0x8000) hi++;
+  return ((uint32_t)hi << 16) | lo;
+}
+
+// Fire the slot's next edge. Interrupts off.
+static void edge(uint8_t s, uint32_t now) {
+  Slot& x = g_slot[s];
+  const bool set = x.state == S_SET;
+  if (set == x.active_high) *x.reg |= x.mask; else *x.reg &= ~x.mask;
+
+  const uint8_t k = set ? 0 : 1;
+  const uint32_t err = now - (set ? x.t_set : x.t_clear);
+  const uint16_t e = err > 0xFFFF ? 0xFFFF : (uint16_t)err;
+  if (e > g_err_max[k]) g_err_max[k] = e;
+  g_err_sum[k] += e;
+  g_err_n[k]++;
+
+  x.state = set ? S_CLEAR : S_IDLE;
+}
+
+// Point the compare channel at the next edge, or fire it if it is already due.
+// Edges more than one timer period out are picked up by the overflow interrupt.
+// Interrupts off.
+static void arm(uint8_t s) {
+  Slot& x = g_slot[s];
+  for (;;) {
+    if (x.state == S_IDLE) { TIMSK5 &= ~oc_bit(s); return; }
+    const uint32_t t = x.state == S_SET ? x.t_set : x.t_clear;
+    uint32_t now = now_locked();
+    if ((int32_t)(now - t) >= 0) { edge(s, now); continue; }
+    if (t - now > 0xFFFF) { TIMSK5 &= ~oc_bit(s); return; }
+
+    ocr(s) = (uint16_t)t;
+    TIFR5  = oc_bit(s);           // drop a stale match flag
+    TIMSK5 |= oc_bit(s);
+    now = now_locked();
+    if ((int32_t)(now - t) < 0) return;
+    TIFR5 = oc_bit(s);            // TCNT5 passed it while we wrote OCR: fire here, not a period later
+    edge(s, now);
+  }
+}
+
+static void service(uint8_t s) {
+  const uint32_t now = now_locked();
+  Slot& x = g_slot[s];
+  if (x.state != S_IDLE) {
+    const uint32_t t = x.state == S_SET ? x.t_set : x.t_clear;
+    if ((int32_t)(now - t) >= 0) edge(s, now);
+  }
+  arm(s);
+}
+
+ISR(TIMER5_COMPA_vect) { service(0); }
+ISR(TIMER5_COMPB_vect) { service(1); }
+ISR(TIMER5_COMPC_vect) { service(2); }
+
+ISR(TIMER5_OVF_vect) {
+  g_hi++;
+  for (uint8_t s = 0; s < HWT_SLOTS; s++) {
+    if (g_slot[s].state != S_IDLE && !(TIMSK5 & oc_bit(s))) arm(s);
+  }
+}
+
+void hwtimer_begin() {
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    TCCR5A = 0;                          // normal mode, OC5A..C disconnected
+    TCCR5B = 0;
+    TCNT5  = 0;
+    TIFR5  = 0xFF;
+    TIMSK5 = _BV(TOIE5);
+    TCCR5B = _BV(CS51) | _BV(CS50);      // clk/64
+    g_hi = 0;
+  }
+}
+
+uint32_t hwtimer_ticks() {
+  uint32_t t;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { t = now_locked(); }
+  return t;
+}
+
+int8_t hwtimer_window(uint8_t pin, bool active_high, uint32_t delay_us, uint32_t width_us) {
+  const uint8_t port = digitalPinToPort(pin);
+  if (port == NOT_A_PIN) return -1;
+
+  int8_t s = -1;
+  for (uint8_t i = 0; i < HWT_SLOTS; i++) if (g_slot[i].state == S_IDLE) { s = i; break; }
+  if (s < 0) { g_no_slot++; return -1; }
+
+  Slot& x = g_slot[s];
+  x.reg  = portOutputRegister(port);
+  x.mask = digitalPinToBitMask(pin);
+  x.pin  = pin;
+  x.active_high = active_high;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    x.t_set   = now_locked() + to_ticks(delay_us);
+    x.t_clear = x.t_set + to_ticks(width_us);
+    x.state   = S_SET;
+    arm(s);
+  }
+  g_windows++;
+  return s;
+}
+
+bool hwtimer_clear_in(int8_t slot, uint32_t us) {
+  if (slot < 0 || slot >= HWT_SLOTS) return false;
+  bool ok = false;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    Slot& x = g_slot[slot];
+    if (x.state != S_IDLE) {
+      x.t_clear = now_locked() + to_ticks(us);
+      if (x.state == S_CLEAR) arm(slot);
+      ok = true;
+    }
+  }
+  return ok;
+}
+
+bool hwtimer_cancel(int8_t slot) {
+  if (slot < 0 || slot >= HWT_SLOTS) return false;
+  bool on = false;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    on = g_slot[slot].state == S_CLEAR;
+    g_slot[slot].state = S_IDLE;
+    TIMSK5 &= ~oc_bit(slot);
+  }
+  return on;
+}
+
+bool hwtimer_busy(int8_t slot) {
+  return slot >= 0 && slot < HWT_SLOTS && g_slot[slot].state != S_IDLE;
+}
+
+void hwtimer_print(Stream& s) {
+  uint16_t emax[2]; uint32_t esum[2], en[2];
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    for (uint8_t k = 0; k < 2; k++) { emax[k] = g_err_max[k]; esum[k] = g_err_sum[k]; en[k] = g_err_n[k]; }
+  }
+  s.print(F("  Timer5 windows ")); s.print(g_windows);
+  s.print(F("  no free slot ")); s.print(g_no_slot);
+  s.print(F("  busy"));
+  for (uint8_t i = 0; i < HWT_SLOTS; i++) {
+    if (g_slot[i].state == S_IDLE) continue;
+    s.print(F(" D")); s.print(g_slot[i].pin);
+  }
+  s.println();
+  for (uint8_t k = 0; k < 2; k++) {
+    s.print(k ? F("  clear edge error us  max ") : F("  set edge error us    max "));
+    s.print((uint32_t)emax[k] * US_PER_TICK);
+    s.print(F("  mean ")); s.print(en[k] ? esum[k] * US_PER_TICK / en[k] : 0);
+    s.print(F("  n ")); s.println(en[k]);
+  }
+}
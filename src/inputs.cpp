@@ -6,8 +6,12 @@
 #include "inputs.hpp"
 #include "triggers.hpp"
 #include "display.hpp"   // for any idle writers you already use
+#include "eventlog.hpp"
+#include "outframe.hpp"
+#include "uart.hpp"
 
 // Scene entry points
+#include "scenevm.hpp"
 #include "scenes/scene_frankenphone.hpp"
 void scene_intro();
 void scene_blackout();
@@ -21,21 +25,60 @@ void scene_blood_tick();
 
 static const uint8_t N_SCENE_BEAMS = 6; // beams 0..5 launch scenes
 
-// Map: which Arduino pins are beams 0..6
-static const uint8_t BEAM_PINS[7] = {
-  PIN_BEAM_0, PIN_BEAM_1, PIN_BEAM_2, PIN_BEAM_3, PIN_BEAM_4, PIN_BEAM_5, PIN_BEAM_6
-};
-static const char*   BEAM_NAMES[7] = { "B0","B1","B2","B3","B4","B5","B6" };
+// Beams 0..6 sampled together once per pass, bit i = pin level of beam i
+// (1 = clear / reed open). D2, D3, D4, D5 and the reed are on ports E, G and
+// C in the I/O space (one in each); D7 and D9 are on PINH at 0x100, above it,
+// so those two are an lds plus a bit test. PINBENCH times both kinds.
+static uint8_t g_pins = 0x7F;
+static inline uint8_t sample_pins() {
+  return (uint8_t)( BeamPin0::read()       | (BeamPin1::read() << 1) | (BeamPin2::read() << 2) |
+                   (BeamPin3::read() << 3) | (BeamPin4::read() << 4) | (BeamPin5::read() << 5) |
+                   (ReedPin::read()  << 6));
+}
+
+// Debounce and rearm timing (defaults, live-tuned via settings SDEB / SDEBMIN / SREARM).
+// Each beam's window adapts between g_deb_min_ms and g_debounce_ms (ceiling)
+// to the longest bounce it has shown lately; the reed uses the ceiling.
+static unsigned long g_debounce_ms = 30;
+static unsigned long g_deb_min_ms  = 3;
+static unsigned long g_rearm_ms    = 20000; // 20 s
 
-// Debounce and rearm timing
-static const unsigned long DEBOUNCE_MS = 30;
-static const unsigned long REARM_MS    = 20000; // 20 s
+// Leading-edge beams (bit i): a break fires once it has lasted g_min_pulse_us,
+// measured from the edge timestamp; debounce then applies to the release.
+static uint8_t  g_instant      = 0;
+static uint16_t g_min_pulse_us = 1000;
 
 // Per-beam state machine (for beams 0..5)
 static uint8_t stable_state[6];     // 0 clear, 1 broken
 static uint8_t last_raw[6];
 static unsigned long t_change[6];
+static uint32_t t_edge_us[6];       // micros() of the last raw edge, for pulse width
 static unsigned long t_last_fire[6];
+static uint8_t g_fired = 0;         // bit i set once beam i has fired (armed at boot)
+
+// Re-arm policy per beam (REARM command), see inputs.hpp for the byte layout
+static uint8_t  g_rearm_policy[6] = {REARM_DEFAULT, REARM_DEFAULT, REARM_DEFAULT,
+                                     REARM_DEFAULT, REARM_DEFAULT, REARM_DEFAULT};
+static uint16_t g_rearm_clear_ms  = 3000;
+static unsigned long t_clear_start[6]; // when the beam last settled clear
+static uint8_t  g_down_seen = 0;       // bit i: beam i's downstream beam broke since i fired
+static uint16_t g_accepted[6];
+static uint16_t g_suppressed[6];
+
+// Signal quality per beam (BEAMSTAT). A bounce is any raw level that lasted
+// less than the debounce ceiling, whether or not the current window let it through.
+static const uint8_t BOUNCE_BUCKETS = 8;   // <1 <2 <4 <8 <16 <32 <64 >=64 ms
+struct BeamQuality {
+  uint16_t hist[BOUNCE_BUCKETS];
+  uint16_t bounces;        // chatter: raw edges that did not settle
+  uint16_t short_breaks;   // breaks rejected as shorter than the window
+  uint16_t settles;        // accepted level changes
+  uint16_t trips;
+  uint16_t peak_q4;        // recent longest bounce, ms * 16, decays per settle
+  uint16_t window_ms;      // current adaptive debounce
+  uint8_t  max_bounce_ms;  // longest bounce since reset
+};
+static BeamQuality g_q[6];
 
 // Beam 6 (reed) raw tracking
 static uint8_t  reed_last_raw = 1;  // 1 = open due to pullup
@@ -50,21 +93,22 @@ static bool    gLightIsOn         = false;
 static bool    gLightIntroLatch   = false;
 static unsigned long gLightBlockUntil = 0;
 
-static inline uint8_t raw_active_low(uint8_t pin) { return digitalRead(pin) == LOW ? 1 : 0; }
+static inline uint8_t read_beam(uint8_t i) { return (g_pins >> i) & 1; }
+static inline uint8_t raw_active_low(uint8_t i) { return read_beam(i) == LOW ? 1 : 0; }
 
 static inline void techlight_write_hw(bool on) {
 #if TECHLIGHT_ACTIVE_HIGH
-  digitalWrite(PIN_TECHLIGHT, on ? HIGH : LOW);
+  outframe_write<PIN_TECHLIGHT>(on);
 #else
-  digitalWrite(PIN_TECHLIGHT, on ? LOW : HIGH);
+  outframe_write<PIN_TECHLIGHT>(!on);
 #endif
   gLightIsOn = on;
 }
 
 // ====== Techlight API (implementation) ======
-void techlight_override_on()  { gLightOverride = 1;  gLightIntroLatch = false; techlight_write_hw(true);  console_log("TechLight OVERRIDE ON"); }
-void techlight_override_off() { gLightOverride = 0;  techlight_write_hw(false); console_log("TechLight OVERRIDE OFF"); }
-void techlight_override_auto(){ gLightOverride = -1; console_log("TechLight AUTO (follow reed)"); }
+void techlight_override_on()  { gLightOverride = 1;  gLightIntroLatch = false; techlight_write_hw(true);  console_log(F("TechLight OVERRIDE ON")); }
+void techlight_override_off() { gLightOverride = 0;  techlight_write_hw(false); console_log(F("TechLight OVERRIDE OFF")); }
+void techlight_override_auto(){ gLightOverride = -1; console_log(F("TechLight AUTO (follow reed)")); }
 
 // Header declares default 5000 ms. Definition here enforces OFF now,
 // minimum blackout window, then latch until reed closes in AUTO or override ON.
@@ -72,7 +116,7 @@ void techlight_scene_intro_kill(uint16_t ms_holdoff) {
   techlight_write_hw(false);
   gLightIntroLatch   = true;
   gLightBlockUntil   = millis() + ms_holdoff;
-  console_log("TechLight OFF by Intro/Cue");
+  console_log(F("TechLight OFF by Intro/Cue"));
 }
 
 bool techlight_is_on() { return gLightIsOn; }
@@ -84,8 +128,173 @@ const char* techlight_mode_name() {
   }
 }
 
+// ====== Live timing ======
+uint8_t inputs_beam_mask() {
+  uint8_t m = reed_stable == LOW ? (1 << 6) : 0;
+  for (uint8_t i = 0; i < N_SCENE_BEAMS; ++i) if (stable_state[i]) m |= (1 << i);
+  return m;
+}
+
+static uint8_t bounce_bucket(uint32_t ms) {
+  uint8_t b = 0;
+  while (b < BOUNCE_BUCKETS - 1 && ms >= (1UL << b)) b++;
+  return b;
+}
+
+// Window = 1.5x the recent bounce peak plus 1 ms, within [min, ceiling]
+static void adapt_window(uint8_t i) {
+  uint32_t w = ((uint32_t)g_q[i].peak_q4 * 3 / 2 >> 4) + 1;
+  if (w < g_deb_min_ms)  w = g_deb_min_ms;
+  if (w > g_debounce_ms) w = g_debounce_ms;
+  g_q[i].window_ms = (uint16_t)w;
+}
+
+static void note_bounce(uint8_t i, uint32_t ms) {
+  BeamQuality& q = g_q[i];
+  q.hist[bounce_bucket(ms)]++;
+  if (q.bounces < 0xFFFF) q.bounces++;
+  if (ms > q.max_bounce_ms) q.max_bounce_ms = (uint8_t)min(ms, 255UL);
+  const uint32_t q4 = ms << 4;
+  if (q4 > q.peak_q4) { q.peak_q4 = (uint16_t)min(q4, 0xFFFFUL); adapt_window(i); }
+}
+
+static void note_settle(uint8_t i) {
+  BeamQuality& q = g_q[i];
+  if (q.settles < 0xFFFF) q.settles++;
+  q.peak_q4 -= q.peak_q4 >> 3;          // forget old bounces over ~8 clean edges
+  adapt_window(i);
+}
+
+void inputs_set_debounce(uint16_t ms) {
+  g_debounce_ms = ms;
+  for (uint8_t i = 0; i < N_SCENE_BEAMS; ++i) adapt_window(i);
+}
+// ====== Re-arm policy ======
+void inputs_set_rearm_policy(const uint8_t* policy) { memcpy(g_rearm_policy, policy, sizeof(g_rearm_policy)); }
+void inputs_set_rearm_clear(uint16_t ms)            { g_rearm_clear_ms = ms; }
+
+// DOWN needs a downstream beam other than i itself, or nothing would ever
+// re-arm the beam. Without one (settings from before NEXT existed, or a
+// hand-edited record) the condition is ignored instead of locking it for good.
+static bool down_usable(uint8_t i, uint8_t p) {
+  return REARM_NEXT(p) < N_SCENE_BEAMS && REARM_NEXT(p) != i;
+}
+
+static uint8_t rearm_want(uint8_t i) {
+  const uint8_t p = g_rearm_policy[i];
+  uint8_t want = p & (REARM_TIME | REARM_CLEAR | REARM_DOWN);
+  if (!down_usable(i, p)) want &= ~REARM_DOWN;
+  return want;
+}
+
+// Conditions met for a break of beam i at now after clear_ms clear
+static uint8_t rearm_met(uint8_t i, unsigned long now, unsigned long clear_ms) {
+  uint8_t met = 0;
+  if (now - t_last_fire[i] >= g_rearm_ms) met |= REARM_TIME;
+  if (clear_ms >= g_rearm_clear_ms)       met |= REARM_CLEAR;
+  if (g_down_seen & (1 << i))             met |= REARM_DOWN;
+  return met;
+}
+
+static bool rearm_holds(uint8_t i, uint8_t want, uint8_t met) {
+  if (!want) return true;
+  return (g_rearm_policy[i] & REARM_ALL) ? (met & want) == want : (met & want) != 0;
+}
+
+// Called on a settled break of beam i, before it is accepted or suppressed
+static bool rearmed(uint8_t i, unsigned long now) {
+  if (!(g_fired & (1 << i))) return true;        // first trip since boot
+  return rearm_holds(i, rearm_want(i), rearm_met(i, now, t_change[i] - t_clear_start[i]));
+}
+
+// A settled break on beam j tells every beam whose downstream is j that the group moved on
+static void note_downstream(uint8_t j) {
+  for (uint8_t i = 0; i < N_SCENE_BEAMS; ++i) {
+    if (i != j && REARM_NEXT(g_rearm_policy[i]) == j) g_down_seen |= (1 << i);
+  }
+}
+
+// Why a break of beam i right now would be suppressed: the conditions still missing
+static void print_rearm_state(Stream& s, uint8_t i, unsigned long now) {
+  const uint8_t want = rearm_want(i);
+  const uint8_t met = rearm_met(i, now, stable_state[i] ? 0 : now - t_clear_start[i]);
+  if (!(g_fired & (1 << i)) || rearm_holds(i, want, met)) { s.print(F("armed")); return; }
+  s.print(F("locked, needs"));
+  const uint8_t miss = want & ~met;
+  const char sep = (g_rearm_policy[i] & REARM_ALL) ? '+' : '|';
+  uint8_t n = 0;
+  if (miss & REARM_TIME) {
+    s.print(F(" TIME ")); s.print((g_rearm_ms - (now - t_last_fire[i]) + 999) / 1000); s.print('s'); n++;
+  }
+  if (miss & REARM_CLEAR) {
+    s.print(n++ ? sep : ' '); s.print(F("CLEAR"));
+    if (stable_state[i]) s.print(F(" once clear"));
+    else { s.print(' '); s.print(g_rearm_clear_ms - (now - t_clear_start[i])); s.print(F("ms")); }
+  }
+  if (miss & REARM_DOWN) { s.print(n++ ? sep : ' '); s.print(F("DOWN B")); s.print(REARM_NEXT(g_rearm_policy[i])); }
+}
+
+void inputs_print_rearm(Stream& s) {
+  const unsigned long now = millis();
+  s.print(F("=== Re-arm (time ")); s.print(g_rearm_ms);
+  s.print(F(" ms, clear ")); s.print(g_rearm_clear_ms); s.println(F(" ms) ==="));
+  s.println(F("  beam policy      next accepted suppressed state"));
+  for (uint8_t i = 0; i < N_SCENE_BEAMS; ++i) {
+    const uint8_t p = g_rearm_policy[i];
+    s.print(F("  B")); s.print(i); s.print(F("   "));
+    uint8_t w = 0;
+    if (p & REARM_TIME)  { s.print(F("TIME"));  w += 4; }
+    if (p & REARM_CLEAR) { if (w) { s.print((p & REARM_ALL) ? '+' : '|'); w++; } s.print(F("CLEAR")); w += 5; }
+    if (p & REARM_DOWN)  { if (w) { s.print((p & REARM_ALL) ? '+' : '|'); w++; } s.print(F("DOWN"));  w += 4; }
+    if (!w)              { s.print(F("ALWAYS")); w = 6; }
+    while (w++ < 13) s.print(' ');
+    if (REARM_NEXT(p) < N_SCENE_BEAMS) { s.print('B'); s.print(REARM_NEXT(p)); } else s.print('-');
+    s.print(F("\t")); s.print(g_accepted[i]);
+    s.print(F("\t")); s.print(g_suppressed[i]);
+    s.print(F("\t")); print_rearm_state(s, i, now);
+    if ((p & REARM_DOWN) && !down_usable(i, p)) s.print(F(" (DOWN ignored: NEXT not another beam)"));
+    s.println();
+  }
+}
+
+void inputs_set_instant(uint8_t mask)      { g_instant = mask & 0x3F; }
+void inputs_set_min_pulse(uint16_t us)     { g_min_pulse_us = us; }
+
+void inputs_set_debounce_min(uint16_t ms) {
+  g_deb_min_ms = ms;
+  for (uint8_t i = 0; i < N_SCENE_BEAMS; ++i) adapt_window(i);
+}
+void inputs_set_rearm(uint32_t ms)    { g_rearm_ms = ms; }
+
+// ====== Warm restart ======
+uint32_t inputs_fire_age(uint8_t beam) {
+  if (beam >= N_SCENE_BEAMS || !(g_fired & (1 << beam))) return INPUTS_NEVER_FIRED;
+  return millis() - t_last_fire[beam];
+}
+
+void inputs_resume_fire_age(uint8_t beam, uint32_t age_ms) {
+  if (beam >= N_SCENE_BEAMS || age_ms == INPUTS_NEVER_FIRED) return;
+  t_last_fire[beam] = millis() - age_ms;   // unsigned wrap keeps now - t == age
+  g_fired |= (1 << beam);
+}
+
+void techlight_warm_get(int8_t& override_mode, bool& latch, uint32_t& block_left_ms) {
+  const unsigned long now = millis();
+  override_mode = gLightOverride;
+  latch         = gLightIntroLatch;
+  block_left_ms = (gLightIntroLatch && gLightBlockUntil > now) ? gLightBlockUntil - now : 0;
+}
+
+void techlight_warm_resume(int8_t override_mode, bool latch, uint32_t block_left_ms) {
+  gLightOverride   = (override_mode < -1 || override_mode > 1) ? -1 : override_mode;
+  gLightIntroLatch = latch;
+  gLightBlockUntil = millis() + block_left_ms;
+}
+
 // ====== Scene mapper ======
 static void scene_for_beam(uint8_t idx) {
+  if (svm_beam(idx)) return;   // a loaded bytecode scene bound to this beam replaces the built-in one
+
   switch (idx) {
     case 0:
       scene_frankenphone();
@@ -111,51 +320,85 @@ static void scene_for_beam(uint8_t idx) {
 }
 
 void inputs_init() {
-  // Beams 0..5
+  // Outputs first so nothing floats while the beams are sampled
+  outframe_claim(PIN_TECHLIGHT, !TECHLIGHT_ACTIVE_HIGH); // start OFF
+  techlight_write_hw(false);
+
+  // Triggers to Pi (SHOW, BLOOD, GRAVE, FUR, FRANKEN)
+  triggers_begin();
+
+  // Beams 0..5, beam 6 is the reed switch (Adafruit 375), active when CLOSED
+  BeamPin0::input_pullup(); BeamPin1::input_pullup(); BeamPin2::input_pullup();
+  BeamPin3::input_pullup(); BeamPin4::input_pullup(); BeamPin5::input_pullup();
+  ReedPin::input_pullup();
+  g_pins = sample_pins();
   for (uint8_t i = 0; i < N_SCENE_BEAMS; ++i) {
-    pinMode(BEAM_PINS[i], INPUT_PULLUP);
-    uint8_t r = raw_active_low(BEAM_PINS[i]);
+    uint8_t r = raw_active_low(i);
     last_raw[i]   = r;
     stable_state[i]= r;
     t_change[i]   = millis();
+    t_edge_us[i]  = micros();
     t_last_fire[i]= 0;
+    t_clear_start[i] = millis();
+    adapt_window(i);
   }
+  g_fired = 0;
+  g_down_seen = 0;
 
-  // Beam 6: Reed switch (Adafruit 375). INPUT_PULLUP, active when CLOSED.
-  pinMode(PIN_BEAM_6, INPUT_PULLUP);
-  reed_last_raw = digitalRead(PIN_BEAM_6); // 0 when closed, 1 when open
+  reed_last_raw = (g_pins >> 6) & 1; // 0 when closed, 1 when open
   reed_stable   = reed_last_raw;
   reed_t_change = millis();
+}
 
-  // Tech booth light output
-  pinMode(PIN_TECHLIGHT, OUTPUT);
-  techlight_write_hw(false); // start OFF
-
-  // Triggers to Pi (SHOW, BLOOD, GRAVE, FUR, FRANKEN)
-  triggers_begin();
-
-  console_log("Inputs: beams B0..B5 debounced + rearm, B6 reed drives tech light");
-  console_log("Map: B0=Franken, B1=Intro+SHOW, B2=Blood, B3=Graveyard, B4=Mirror, B5=Exit, B6=TechLight");
+void inputs_print_banner() {
+  console_log(F("Inputs: beams B0..B5 debounced + rearm, B6 reed drives tech light"));
+  console_log(F("Map: B0=Franken, B1=Intro+SHOW, B2=Blood, B3=Graveyard, B4=Mirror, B5=Exit, B6=TechLight"));
 }
 
 void inputs_update() {
   const unsigned long now = millis();
+  const uint32_t now_us = micros();
+  g_pins = sample_pins();
 
   // Beams 0..5: edge detect break with rearm
   for (uint8_t i = 0; i < N_SCENE_BEAMS; ++i) {
-    uint8_t r = raw_active_low(BEAM_PINS[i]);
+    uint8_t r = raw_active_low(i);
+    const bool instant = g_instant & (1 << i);
     if (r != last_raw[i]) {
+      const uint32_t run = now - t_change[i];   // how long the previous raw level lasted
+      if (run < g_debounce_ms) {
+        note_bounce(i, run);
+        const bool rejected = instant ? now_us - t_edge_us[i] < g_min_pulse_us : run < g_q[i].window_ms;
+        if (last_raw[i] == 1 && stable_state[i] == 0 && rejected) g_q[i].short_breaks++;
+      }
       last_raw[i] = r;
       t_change[i] = now;
+      t_edge_us[i] = now_us;
     }
-    if (now - t_change[i] >= DEBOUNCE_MS) {
+    // Leading edge: a break qualifies on pulse width alone, the release still waits out the window
+    const bool settled = (instant && r == 1 && stable_state[i] == 0)
+                       ? now_us - t_edge_us[i] >= g_min_pulse_us
+                       : now - t_change[i] >= g_q[i].window_ms;
+    if (settled) {
       if (stable_state[i] != r) {
         stable_state[i] = r;
+        note_settle(i);
+        if (r == 0) t_clear_start[i] = now;
         if (r == 1) { // newly broken
-          if (now - t_last_fire[i] >= REARM_MS) {
+          note_downstream(i);
+          if (rearmed(i, now)) {
             t_last_fire[i] = now;
-            console_log(String("TRIP ") + BEAM_NAMES[i]);
+            g_fired |= (1 << i);
+            g_down_seen &= ~(1 << i);
+            g_q[i].trips++;
+            if (g_accepted[i] < 0xFFFF) g_accepted[i]++;
+            evlog_add(EV_TRIP, i, now - t_change[i]);
+            const char name[3] = { 'B', char('0' + i), '\0' };
+            console_log(F("TRIP "), name);
             scene_for_beam(i);
+          } else {
+            if (g_suppressed[i] < 0xFFFF) g_suppressed[i]++;
+            evlog_add(EV_TRIP_LOCKED, i, now - t_last_fire[i]);
           }
         }
       }
@@ -163,14 +406,15 @@ void inputs_update() {
   }
 
   // Beam 6: reed switch debounced
-  uint8_t reed_raw = digitalRead(PIN_BEAM_6); // 0 = closed, 1 = open (pullup)
+  uint8_t reed_raw = read_beam(6); // 0 = closed, 1 = open (pullup)
   if (reed_raw != reed_last_raw) {
     reed_last_raw = reed_raw;
     reed_t_change = now;
   }
-  if (now - reed_t_change >= DEBOUNCE_MS) {
+  if (now - reed_t_change >= g_debounce_ms) {
     if (reed_stable != reed_raw) {
       reed_stable = reed_raw;
+      evlog_add(EV_REED, 6, reed_stable == LOW ? 1 : 0);
     }
   }
 
@@ -198,9 +442,9 @@ void inputs_update() {
   if (want_on != gLightIsOn) {
     techlight_write_hw(want_on);
     if (gLightOverride == -1 && !gLightIntroLatch) {
-      console_log(want_on ? "TechLight ON (reed)" : "TechLight OFF (reed)");
+      console_log(want_on ? F("TechLight ON (reed)") : F("TechLight OFF (reed)"));
     } else if (gLightOverride != -1) {
-      console_log(want_on ? "TechLight ON (override)" : "TechLight OFF (override)");
+      console_log(want_on ? F("TechLight ON (override)") : F("TechLight OFF (override)"));
     }
   }
 
@@ -208,15 +452,52 @@ void inputs_update() {
   scene_blood_tick();
 }
 
+// ====== Signal quality ======
+void inputs_stats_reset() {
+  for (uint8_t i = 0; i < N_SCENE_BEAMS; ++i) {
+    const uint16_t w = g_q[i].window_ms;
+    memset(&g_q[i], 0, sizeof(g_q[i]));
+    g_q[i].window_ms = w;          // keep the learned window, peak restarts at 0
+  }
+  memset(g_accepted, 0, sizeof(g_accepted));
+  memset(g_suppressed, 0, sizeof(g_suppressed));
+}
+
+void inputs_print_stats(Stream& s) {
+  s.print(F("=== Beam quality (debounce ")); s.print(g_deb_min_ms);
+  s.print(F("..")); s.print(g_debounce_ms); s.print(F(" ms, instant pulse "));
+  s.print(g_min_pulse_us); s.println(F(" us) ==="));
+  s.println(F("  beam  win trips settle bounce short maxb  <1 <2 <4 <8 <16 <32 <64 >=64"));
+  for (uint8_t i = 0; i < N_SCENE_BEAMS; ++i) {
+    const BeamQuality& q = g_q[i];
+    s.print(F("  B")); s.print(i);
+    s.print((g_instant & (1 << i)) ? F(" I ") : F("   "));   // I = leading-edge trigger
+    s.print(q.window_ms);
+    s.print(F("\t")); s.print(q.trips);
+    s.print(F("\t")); s.print(q.settles);
+    s.print(F("\t")); s.print(q.bounces);
+    s.print(F("\t")); s.print(q.short_breaks);
+    s.print(F("\t")); s.print(q.max_bounce_ms);
+    s.print(F("\t"));
+    for (uint8_t b = 0; b < BOUNCE_BUCKETS; b++) { s.print(q.hist[b]); s.print(' '); }
+    // Bounces per accepted edge: 0 is a clean beam, above 1 it chatters on every edge
+    if (!q.bounces)                 s.println(F(" CLEAN"));
+    else if (q.bounces <= q.settles) s.println(F(" OK"));
+    else                            s.println(F(" NOISY"));
+  }
+}
+
 // ====== Mapping printer for console ======
 void inputs_print_map() {
-  Serial.println(F("=== Beam -> Scene Map ==="));
-  Serial.println(F("B0 D2  -> Frankenphones Lab"));
-  Serial.println(F("B1 D3  -> Intro / Cue Card  + Pi SHOW trigger  + TechLight kill"));
-  Serial.println(F("B2 D4  -> Blood Room (DRIP in/flash/fade/out animation)"));
-  Serial.println(F("B3 D5  -> Graveyard"));
-  Serial.println(F("B4 D7  -> Mirror Room"));
-  Serial.println(F("B5 D9  -> Exit"));
-  Serial.println(F("B6 D30 -> TechLight reed  | Output D26"));
-  Serial.println(F("Debounce 30 ms, Re-arm 20 s for B0..B5"));
+  Console.println(F("=== Beam -> Scene Map ==="));
+  Console.println(F("B0 D2  -> Frankenphones Lab"));
+  Console.println(F("B1 D3  -> Intro / Cue Card  + Pi SHOW trigger  + TechLight kill"));
+  Console.println(F("B2 D4  -> Blood Room (DRIP in/flash/fade/out animation)"));
+  Console.println(F("B3 D5  -> Graveyard"));
+  Console.println(F("B4 D7  -> Mirror Room"));
+  Console.println(F("B5 D9  -> Exit"));
+  Console.println(F("B6 D30 -> TechLight reed  | Output D26"));
+  Console.print(F("Debounce ")); Console.print(g_debounce_ms);
+  Console.print(F(" ms, Re-arm ")); Console.print(g_rearm_ms);
+  Console.println(F(" ms for B0..B5"));
 }
\ No newline at end of file
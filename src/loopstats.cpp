@@ -0,0 +1,88 @@
+// src/loopstats.cpp
+#include <Arduino.h>
+#include "loopstats.hpp"
+#include "memstats.hpp"
+
+static const uint8_t N_STAGES = LOOP_IDLE + 1;
+
+static uint8_t  g_stage     = LOOP_NONE;   // stage currently being timed
+static uint32_t g_t_stage   = 0;           // micros() when it started
+static uint32_t g_t_pass    = 0;           // micros() at LOOP_CONSOLE
+static uint32_t g_stage_max[N_STAGES];
+static uint32_t g_passes    = 0;
+static uint32_t g_pass_sum  = 0;
+static uint32_t g_pass_max  = 0;
+static uint8_t  g_pass_max_stage = LOOP_NONE; // slowest stage of the slowest pass
+static uint32_t g_pass_stage_max = 0;
+static uint8_t  g_slow_stage = LOOP_NONE;     // slowest stage of the current pass
+static uint32_t g_slow_us    = 0;
+static const uint16_t SLOW_US = 5000;         // passes above this are counted
+static uint32_t g_slow_passes = 0;
+static uint16_t g_ram_min   = 0xFFFF;
+static uint32_t g_win_max   = 0;           // telemetry window
+static uint16_t g_win_passes = 0;
+
+void loopstats_mark(LoopStage s) {
+  const uint32_t now = micros();
+
+  if (g_stage != LOOP_NONE && g_stage < N_STAGES) {
+    const uint32_t d = now - g_t_stage;
+    if (d > g_stage_max[g_stage]) g_stage_max[g_stage] = d;
+    if (d > g_slow_us) { g_slow_us = d; g_slow_stage = g_stage; }
+  }
+
+  if (s == LOOP_CONSOLE) {
+    g_t_pass = now;
+    g_slow_us = 0;
+    g_slow_stage = LOOP_NONE;
+  } else if (s == LOOP_IDLE && g_t_pass) {
+    const uint32_t pass = now - g_t_pass;
+    g_passes++;
+    g_pass_sum += pass;
+    if (pass > SLOW_US) g_slow_passes++;
+    if (pass > g_win_max) g_win_max = pass;
+    if (g_win_passes < 0xFFFF) g_win_passes++;
+    if (pass > g_pass_max) {
+      g_pass_max = pass;
+      g_pass_max_stage = g_slow_stage;
+      g_pass_stage_max = g_slow_us;
+    }
+    const uint16_t ram = mem_free_now();
+    if (ram < g_ram_min) g_ram_min = ram;
+  }
+
+  g_stage   = s;
+  g_t_stage = now;
+}
+
+void loopstats_reset() {
+  memset(g_stage_max, 0, sizeof(g_stage_max));
+  g_passes = g_pass_sum = g_pass_max = g_slow_passes = 0;
+  g_pass_max_stage = LOOP_NONE;
+  g_pass_stage_max = 0;
+  g_ram_min = 0xFFFF;
+  g_t_pass = 0;            // restart timing at the next LOOP_CONSOLE
+}
+
+void loopstats_window(uint32_t& max_us, uint16_t& passes) {
+  max_us = g_win_max;
+  passes = g_win_passes;
+  g_win_max = 0;
+  g_win_passes = 0;
+}
+
+void loopstats_print(Stream& s) {
+  s.println(F("=== Loop ==="));
+  s.print(F("  passes ")); s.print(g_passes);
+  s.print(F("  avg ")); s.print(g_passes ? g_pass_sum / g_passes : 0UL);
+  s.print(F(" us  max ")); s.print(g_pass_max);
+  s.print(F(" us (")); s.print(loop_stage_name(g_pass_max_stage));
+  s.print(F(" ")); s.print(g_pass_stage_max);
+  s.print(F(" us)  >")); s.print(SLOW_US / 1000); s.print(F("ms ")); s.println(g_slow_passes);
+  s.print(F("  stage max us:"));
+  for (uint8_t i = LOOP_CONSOLE; i < LOOP_IDLE; i++) {
+    s.print(F(" ")); s.print(loop_stage_name(i)); s.print(F("=")); s.print(g_stage_max[i]);
+  }
+  s.println();
+  s.print(F("  free RAM low ")); s.println(g_ram_min == 0xFFFF ? 0 : g_ram_min);
+}
@@ -1,31 +1,93 @@
 // src/main.cpp
 #include <Arduino.h>
 
+#include "boot.hpp"
 #include "display.hpp"
 #include "effects.hpp"
+#include "eventlog.hpp"
+#include "hwtimer.hpp"
 #include "console.hpp"
 #include "inputs.hpp"
 #include "pins.hpp"
+#include "settings.hpp"
+#include "pilink.hpp"
+#include "recovery.hpp"
+#include "loopstats.hpp"
+#include "outframe.hpp"
+#include "outputs.hpp"
+#include "prof.hpp"
+#include "scenevm.hpp"
+#include "telemetry.hpp"
+#include "uart.hpp"
 #include "scenes/scene_frankenphone.hpp"
 
-void setup() {
-  Serial.begin(115200);
-  while (!Serial) {}
+// Stall attribution for the watchdog plus per-stage timing for LOOP (and
+// cycle markers for the simulator benchmark)
+static inline void stage(LoopStage s) { PROF_MARK(s); recovery_stage(s); loopstats_mark(s); }
 
-  console_log("Haunted Hearse Booting...");
-  console_log("Pins: Beams D2 D3 D4 D5 D7 D9, Magnet D6, Buzzer D8, LEDs D10 D11 D12, I2C 0x70");
+void setup() {
+  boot_mark(BOOT_SETUP);
+  evlog_begin();
 
+  // Fast arm: actuators safe and beams live before any serial or I2C traffic
+  hwtimer_begin();
   effects_begin();
-  display_begin(0x70, 8);
-  inputs_init();
+  outputs_begin();
   frankenphone_init();
+  boot_mark(BOOT_SAFE);
+
+  inputs_init();
+  // Beam timing straight from the journal, so beams arm with their stored
+  // debounce before the rest of the settings are loaded
+  uint16_t deb, deb_min, pulse;
+  uint8_t  instant;
+  if (settings_peek(SET_TAG_DEBOUNCE_MS,     &deb,     sizeof deb))     inputs_set_debounce(deb);
+  if (settings_peek(SET_TAG_DEBOUNCE_MIN_MS, &deb_min, sizeof deb_min)) inputs_set_debounce_min(deb_min);
+  if (settings_peek(SET_TAG_BEAM_INSTANT,    &instant, sizeof instant)) inputs_set_instant(instant);
+  if (settings_peek(SET_TAG_MIN_PULSE_US,    &pulse,   sizeof pulse))   inputs_set_min_pulse(pulse);
+  boot_mark(BOOT_ARMED);
+
+  Serial.begin(HH_CONSOLE_BAUD);
 
-  console_log("Setup complete. Type '?' for help.");
+  // Stored tuning, applied live to the running modules
+  settings_begin(frankenphone_set_hold,
+                 frankenphone_set_cooldown,
+                 inputs_set_debounce,
+                 inputs_set_rearm,
+                 display_set_brightness,
+                 inputs_set_debounce_min,
+                 inputs_set_instant,
+                 inputs_set_min_pulse,
+                 inputs_set_rearm_policy,
+                 inputs_set_rearm_clear);
+  boot_mark(BOOT_SETTINGS);
+
+  // Bytecode scenes from EEPROM, else the ones baked into flash
+  svm_begin();
+
+  // Resume an in-flight scene after a watchdog or button reset, then arm the watchdog
+  recovery_begin();
+  boot_mark(BOOT_RECOVERY);
+
+  // Banners, display and Pi link follow from loop(), one step per pass
+  boot_mark(BOOT_LIVE);
 }
 
 void loop() {
-  console_update();     // console commands
-  inputs_update();      // beam manager
-  frankenphone_update();// scene runtime
+  recovery_update();    // kick watchdog, refresh warm-restart snapshot
+
+  stage(LOOP_CONSOLE);  console_update();     // console commands
+  stage(LOOP_INPUTS);   inputs_update();      // beam manager
+  stage(LOOP_PILINK);   pilink_update();      // Pi acks and retries
+  stage(LOOP_SCENE);    frankenphone_update();// scene runtime
+                        svm_update();         // bytecode scenes, image loader
+                        display_update();     // owner brightness ramp
+  stage(LOOP_SETTINGS); settings_update();    // background EEPROM journal writes
+                        evlog_update();       // background event log checkpoint
+  stage(LOOP_BOOT);     boot_deferred_step(); // remaining boot init, no-op once done
+  stage(LOOP_TELEMETRY); telemetry_update();  // subscribed channels that changed
+  stage(LOOP_OUTPUTS);  outputs_update();     // timed output edges, one compare when none due
+                        outframe_flush();     // this pass's pin changes, one write per port
+  stage(LOOP_IDLE);
   delay(1);
-}
\ No newline at end of file
+}
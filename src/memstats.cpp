@@ -0,0 +1,93 @@
+// src/memstats.cpp
+#include <Arduino.h>
+#include "memstats.hpp"
+
+#if defined(__AVR__)
+
+static const uint8_t CANARY       = 0xC5;
+static const uint8_t REPAINT_SKIP = 64;    // leave room below SP for ISR frames
+
+// Linker symbols (avr-libc default linker script)
+extern uint8_t __data_start, __data_end;
+extern uint8_t __bss_start, __bss_end;
+extern uint8_t __noinit_start, __noinit_end;
+extern uint8_t __heap_start;
+extern uint8_t __stack;                    // RAMEND
+extern char*   __brkval;                   // heap break, 0 until the first malloc
+
+// avr-libc malloc free list (stdlib_private.h)
+struct __freelist { size_t sz; struct __freelist* nx; };
+extern struct __freelist* __flp;
+
+// Runs from .init3: SP and r1 are set up, .data/.bss not yet, nothing on the stack
+void mem_paint() __attribute__((naked, used, section(".init3")));
+void mem_paint() {
+  uint8_t* p = &__heap_start;
+  while (p <= &__stack) { *p = CANARY; p++; }
+}
+
+static uint8_t* heap_top() { return __brkval ? (uint8_t*)__brkval : &__heap_start; }
+
+uint16_t mem_free_now() {
+  uint8_t top;
+  return (uint16_t)(&top - heap_top());
+}
+
+uint16_t mem_lowest_gap() {
+  const uint8_t* p = heap_top();
+  uint16_t n = 0;
+  while (p <= &__stack && *p == CANARY) { p++; n++; }
+  return n;
+}
+
+void mem_repaint() {
+  uint8_t* p = heap_top();
+  uint8_t* end = (uint8_t*)SP - REPAINT_SKIP;
+  while (p < end) *p++ = CANARY;
+}
+
+void mem_print(Stream& s) {
+  const uint16_t data   = &__data_end - &__data_start;
+  const uint16_t bss    = &__bss_end - &__bss_start;
+  const uint16_t noinit = &__noinit_end - &__noinit_start;
+  const uint16_t heap   = heap_top() - &__heap_start;
+
+  uint16_t fl_total = 0, fl_largest = 0, fl_blocks = 0;
+  for (struct __freelist* f = __flp; f; f = f->nx) {
+    const uint16_t sz = f->sz + sizeof(size_t);
+    fl_total += sz;
+    if (sz > fl_largest) fl_largest = sz;
+    fl_blocks++;
+  }
+
+  const uint16_t gap     = mem_free_now();
+  const uint16_t free_ram = gap + fl_total;
+  const uint16_t largest = gap > fl_largest ? gap : fl_largest;
+  const uint16_t stack_now  = &__stack - (uint8_t*)SP;
+  const uint16_t low_gap    = mem_lowest_gap();
+  const uint16_t stack_peak = (&__stack + 1) - (heap_top() + low_gap);
+
+  s.println(F("=== Memory ==="));
+  s.print(F("  .data ")); s.print(data);
+  s.print(F("  .bss ")); s.print(bss);
+  s.print(F("  .noinit ")); s.print(noinit);
+  s.print(F("  heap ")); s.print(heap);
+  s.print(F(" (free list ")); s.print(fl_total);
+  s.print(F(" in ")); s.print(fl_blocks); s.println(F(" blocks)"));
+  s.print(F("  stack now ")); s.print(stack_now);
+  s.print(F("  deepest ")); s.println(stack_peak);
+  s.print(F("  free ")); s.print(free_ram);
+  s.print(F("  lowest gap ")); s.print(low_gap);
+  s.print(F("  largest block ")); s.print(largest);
+  s.print(F("  fragmentation ")); s.print(free_ram ? 100 - (uint32_t)largest * 100 / free_ram : 0);
+  s.println(F("%"));
+}
+
+#else   // host builds have no fixed SRAM map
+
+uint16_t mem_free_now()   { return 0; }
+uint16_t mem_lowest_gap() { return 0; }
+void mem_repaint() {}
+void mem_print(Stream& s) { s.println(F("=== Memory ===")); s.println(F("  AVR only")); }
+
+#endif
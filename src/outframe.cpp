@@ -0,0 +1,136 @@
+// src/outframe.cpp
+#include <Arduino.h>
+#include <util/atomic.h>
+#include "outframe.hpp"
+#include "prof.hpp"
+
+static const uint8_t N_PWM = 4;      // status LEDs are the only PWM outputs
+
+uint8_t  g_outframe_img[OUTFRAME_PORTS];   // levels wanted at the next flush
+uint8_t  g_outframe_pwm[OUTFRAME_PORTS];   // bits whose timer output is connected or about to be
+uint16_t g_outframe_dirty = 0;             // bit p: image of port p changed since the last flush
+static uint8_t g_out[OUTFRAME_PORTS];      // levels last written
+static uint8_t g_own[OUTFRAME_PORTS];      // bits the frame drives
+
+struct PwmSlot {
+  uint8_t pin;
+  uint8_t duty;      // wanted
+  uint8_t written;   // last analogWrite or level
+};
+static PwmSlot g_pwm[N_PWM];
+static uint8_t g_npwm = 0;
+static bool    g_pwm_dirty = false;
+
+static uint32_t g_flushes = 0, g_port_writes = 0, g_pwm_writes = 0;
+
+static inline bool mid(uint8_t duty) { return duty != 0 && duty != 255; }
+
+static PwmSlot* pwm_slot(uint8_t pin) {
+  for (uint8_t i = 0; i < g_npwm; i++) if (g_pwm[i].pin == pin) return &g_pwm[i];
+  return nullptr;
+}
+
+static void pwm_mask(const PwmSlot& s) {
+  const uint8_t port = digitalPinToPort(s.pin);
+  const uint8_t bit  = digitalPinToBitMask(s.pin);
+  if (mid(s.duty) || mid(s.written)) g_outframe_pwm[port] |= bit;
+  else                               g_outframe_pwm[port] &= ~bit;
+}
+
+bool outframe_locate(uint8_t pin, uint8_t& port, uint8_t& mask) {
+  port = digitalPinToPort(pin);
+  if (port == NOT_A_PIN || port >= OUTFRAME_PORTS) return false;
+  mask = digitalPinToBitMask(pin);
+  return true;
+}
+
+void outframe_claim(uint8_t pin, bool high) {
+  uint8_t port, bit;
+  if (!outframe_locate(pin, port, bit)) return;
+  volatile uint8_t* reg = portOutputRegister(port);
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    if (high) *reg |= bit; else *reg &= ~bit;
+  }
+  g_own[port] |= bit;
+  if (high) { g_outframe_img[port] |= bit;  g_out[port] |= bit;  }
+  else      { g_outframe_img[port] &= ~bit; g_out[port] &= ~bit; }
+  if (PwmSlot* s = pwm_slot(pin)) { s->duty = s->written = high ? 255 : 0; pwm_mask(*s); }
+  pinMode(pin, OUTPUT);
+}
+
+void outframe_release(uint8_t pin) {
+  uint8_t port, bit;
+  if (outframe_locate(pin, port, bit)) g_own[port] &= ~bit;
+}
+
+void outframe_write(uint8_t pin, bool high) {
+  uint8_t port, bit;
+  if (!outframe_locate(pin, port, bit)) return;
+  if (g_outframe_pwm[port] & bit) {
+    if (PwmSlot* s = pwm_slot(pin)) {
+      s->duty = high ? 255 : 0;
+      if (s->duty != s->written) g_pwm_dirty = true;
+    }
+  }
+  outframe_mark(port, bit, high);
+}
+
+void outframe_pwm(uint8_t pin, uint8_t duty) {
+  PwmSlot* s = pwm_slot(pin);
+  if (!s) {
+    if (digitalPinToTimer(pin) == NOT_ON_TIMER || g_npwm >= N_PWM) { outframe_write(pin, duty >= 128); return; }
+    s = &g_pwm[g_npwm++];
+    s->pin = pin;
+    s->written = outframe_level(pin) ? 255 : 0;
+  }
+  s->duty = duty;
+  if (duty != s->written) g_pwm_dirty = true;
+  pwm_mask(*s);
+  // The port bit follows 0 / 255; under a running timer output it is ignored
+  uint8_t port, bit;
+  if (outframe_locate(pin, port, bit)) outframe_mark(port, bit, duty == 255);
+}
+
+bool outframe_level(uint8_t pin) {
+  uint8_t port, bit;
+  return outframe_locate(pin, port, bit) && (g_out[port] & bit);
+}
+
+void outframe_flush() {
+  if (!g_outframe_dirty && !g_pwm_dirty) return;
+  PROF_BEGIN(PROF_FLUSH);
+
+  // Timer outputs first: connecting one makes its port bit irrelevant, and
+  // disconnecting one (analogWrite 0 / 255) also sets the level
+  if (g_pwm_dirty) {
+    g_pwm_dirty = false;
+    for (uint8_t i = 0; i < g_npwm; i++) {
+      PwmSlot& s = g_pwm[i];
+      if (s.duty == s.written) continue;
+      if (mid(s.duty) || mid(s.written)) { analogWrite(s.pin, s.duty); g_pwm_writes++; }
+      s.written = s.duty;
+      pwm_mask(s);
+    }
+  }
+
+  bool any = false;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    for (uint8_t p = 1; p < OUTFRAME_PORTS; p++) {
+      if (!(g_outframe_dirty & ((uint16_t)1 << p)) || g_outframe_img[p] == g_out[p]) continue;
+      volatile uint8_t* reg = portOutputRegister(p);
+      *reg = (*reg & ~g_own[p]) | (g_outframe_img[p] & g_own[p]);
+      g_out[p] = g_outframe_img[p];
+      g_port_writes++;
+      any = true;
+    }
+    g_outframe_dirty = 0;
+  }
+  if (any) g_flushes++;
+  PROF_END(PROF_FLUSH);
+}
+
+void outframe_print(Stream& s) {
+  s.print(F("  frame flushes ")); s.print(g_flushes);
+  s.print(F("  port writes ")); s.print(g_port_writes);
+  s.print(F("  PWM writes ")); s.println(g_pwm_writes);
+}
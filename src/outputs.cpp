@@ -0,0 +1,313 @@
+// src/outputs.cpp
+#include <Arduino.h>
+#include "outputs.hpp"
+#include "eventlog.hpp"
+#include "hwtimer.hpp"
+#include "outframe.hpp"
+#include "pins.hpp"
+
+static const uint8_t NO_PIN = 255;
+
+enum : uint8_t {
+  F_ACTIVE_HIGH = 1,
+  F_ON          = 2,
+  F_ARM_ON      = 4,   // pending edge turns the channel on (pulse_after), else off
+  F_PULSE       = 8,   // on-phase was logged with its length, the off edge is not logged
+  F_HW          = 16   // windows go to a Timer5 slot when one is free
+};
+
+// A hardware window's software edge trails it by this much and only does
+// the bookkeeping; windows longer than HW_MAX_MS stay in software.
+static const uint8_t  HW_SLACK_MS = 2;
+static const uint32_t HW_MAX_MS   = 3600000UL;
+
+struct Chan {
+  uint32_t due;    // pending edge, valid while slot >= 0
+  uint32_t len;    // on time after a delayed start
+  PGM_P    name;
+  uint8_t  pin;
+  uint8_t  port;   // outframe port and bit, looked up once in outputs_add()
+  uint8_t  mask;
+  uint8_t  flags;
+  int8_t   slot;   // index in g_heap, -1 when nothing is pending
+  int8_t   hw;     // Timer5 slot holding the pin, -1 when the frame drives it
+};
+
+static Chan    g_ch[OUTPUTS_MAX];
+static uint8_t g_n = 0;
+
+// Min-heap of channels with a pending edge, earliest deadline at g_heap[0]
+static uint8_t g_heap[OUTPUTS_MAX];
+static uint8_t g_heap_n = 0;
+
+static uint32_t g_edges    = 0;   // edges fired by outputs_update()
+static uint32_t g_late_max = 0;   // worst ms between a deadline and its edge
+
+// ---------- heap ----------
+static inline bool earlier(uint8_t a, uint8_t b) {
+  return (int32_t)(g_ch[a].due - g_ch[b].due) < 0;
+}
+
+static inline void heap_put(uint8_t i, uint8_t ch) { g_heap[i] = ch; g_ch[ch].slot = i; }
+
+static void sift_up(uint8_t i) {
+  const uint8_t ch = g_heap[i];
+  while (i) {
+    const uint8_t p = (i - 1) / 2;
+    if (!earlier(ch, g_heap[p])) break;
+    heap_put(i, g_heap[p]);
+    i = p;
+  }
+  heap_put(i, ch);
+}
+
+static void sift_down(uint8_t i) {
+  const uint8_t ch = g_heap[i];
+  for (;;) {
+    uint8_t c = 2 * i + 1;
+    if (c >= g_heap_n) break;
+    if (c + 1 < g_heap_n && earlier(g_heap[c + 1], g_heap[c])) c++;
+    if (!earlier(g_heap[c], ch)) break;
+    heap_put(i, g_heap[c]);
+    i = c;
+  }
+  heap_put(i, ch);
+}
+
+static void schedule(uint8_t ch, uint32_t due) {
+  Chan& c = g_ch[ch];
+  c.due = due;
+  if (c.slot < 0) { const uint8_t i = g_heap_n++; heap_put(i, ch); }
+  sift_up(c.slot);
+  sift_down(c.slot);
+}
+
+static void unschedule(uint8_t ch) {
+  const int8_t i = g_ch[ch].slot;
+  if (i < 0) return;
+  g_ch[ch].slot = -1;
+  g_ch[ch].flags &= ~F_ARM_ON;
+  const uint8_t last = g_heap[--g_heap_n];
+  if (i < g_heap_n) {
+    heap_put(i, last);
+    sift_up(i);
+    sift_down(g_ch[last].slot);
+  }
+}
+
+// ---------- pins ----------
+static void drive(uint8_t ch, bool on) {
+  Chan& c = g_ch[ch];
+  if (c.pin != NO_PIN) outframe_mark(c.port, c.mask, on == (bool)(c.flags & F_ACTIVE_HIGH));
+  if (on) c.flags |= F_ON; else c.flags &= ~F_ON;
+}
+
+static inline void log_edge(uint8_t ch, uint32_t arg) {
+  if (g_ch[ch].pin != NO_PIN) evlog_add(EV_OUTPUT, g_ch[ch].pin, arg);
+}
+
+// A pulse that is held or extended becomes a level: log it on now so the off edge pairs up
+static void to_level(uint8_t ch) {
+  Chan& c = g_ch[ch];
+  if (c.flags & F_PULSE) { c.flags &= ~F_PULSE; log_edge(ch, 1); }
+}
+
+// ---------- Timer5 windows ----------
+// Hand the pin to a Timer5 slot for this window; false leaves it to the software edge
+static bool hw_start(uint8_t ch, uint32_t delay_ms, uint32_t ms) {
+  Chan& c = g_ch[ch];
+  if (!(c.flags & F_HW) || c.pin == NO_PIN || c.hw >= 0) return false;
+  if (delay_ms > HW_MAX_MS || ms > HW_MAX_MS) return false;
+  const int8_t s = hwtimer_window(c.pin, c.flags & F_ACTIVE_HIGH, delay_ms * 1000UL, ms * 1000UL);
+  if (s < 0) return false;
+  outframe_release(c.pin);
+  c.hw = s;
+  return true;
+}
+
+// Take the pin back at whatever level the window left it
+static void hw_stop(uint8_t ch) {
+  Chan& c = g_ch[ch];
+  if (c.hw < 0) return;
+  const bool active = hwtimer_cancel(c.hw);
+  c.hw = -1;
+  outframe_claim(c.pin, active == (bool)(c.flags & F_ACTIVE_HIGH));
+}
+
+// Move a running window's end to ms from now; false if the hardware is not holding it
+static bool hw_retime(uint8_t ch, uint32_t ms) {
+  Chan& c = g_ch[ch];
+  return c.hw >= 0 && ms <= HW_MAX_MS && hwtimer_clear_in(c.hw, ms * 1000UL);
+}
+
+static inline uint32_t slack(uint8_t ch) { return g_ch[ch].hw >= 0 ? HW_SLACK_MS : 0; }
+
+// ---------- API ----------
+int8_t outputs_add(uint8_t pin, PGM_P name, bool active_high, bool hw_timed) {
+  if (g_n >= OUTPUTS_MAX) return -1;
+  const uint8_t ch = g_n++;
+  Chan& c = g_ch[ch];
+  c.pin   = (pin != NO_PIN && outframe_locate(pin, c.port, c.mask)) ? pin : NO_PIN;
+  c.name  = name;
+  c.flags = (active_high ? F_ACTIVE_HIGH : 0) | (hw_timed ? F_HW : 0);
+  c.slot  = -1;
+  c.hw    = -1;
+  c.due = c.len = 0;
+  if (c.pin != NO_PIN) outframe_claim(pin, !active_high);   // idle level straight to the port
+  return (int8_t)ch;
+}
+
+void outputs_begin() {
+  outputs_add(PIN_GOPRO_RELAY, PSTR("GOPRO"));
+  outputs_add(PIN_RECORDER_RELAY, PSTR("REC"));
+}
+
+void outputs_on(uint8_t ch) {
+  if (ch >= g_n) return;
+  unschedule(ch);
+  hw_stop(ch);
+  Chan& c = g_ch[ch];
+  if (!(c.flags & F_ON)) { drive(ch, true); log_edge(ch, 1); }
+  else to_level(ch);
+}
+
+void outputs_off(uint8_t ch) {
+  if (ch >= g_n) return;
+  unschedule(ch);
+  hw_stop(ch);
+  Chan& c = g_ch[ch];
+  if (c.flags & F_ON) { drive(ch, false); log_edge(ch, 0); }
+  c.flags &= ~F_PULSE;
+}
+
+void outputs_pulse(uint8_t ch, uint32_t ms) {
+  if (ch >= g_n) return;
+  unschedule(ch);
+  Chan& c = g_ch[ch];
+  if (!((c.flags & F_ON) && hw_retime(ch, ms))) {   // a restart keeps the running window
+    hw_stop(ch);
+    hw_start(ch, 0, ms);
+  }
+  drive(ch, true);
+  c.flags |= F_PULSE;
+  log_edge(ch, ms);
+  schedule(ch, millis() + ms + slack(ch));
+}
+
+void outputs_hold_for(uint8_t ch, uint32_t ms) {
+  if (ch >= g_n) return;
+  Chan& c = g_ch[ch];
+  const uint32_t due = millis() + ms;
+  if (c.flags & F_ON) {
+    if (c.slot < 0) return;                               // already on with no end
+    to_level(ch);
+    if ((int32_t)(due + slack(ch) - c.due) > 0) {
+      if (c.hw >= 0 && !hw_retime(ch, ms)) { hw_stop(ch); drive(ch, true); }
+      schedule(ch, due + slack(ch));
+    }
+    return;
+  }
+  unschedule(ch);                                          // drops a pending delayed start
+  hw_stop(ch);
+  hw_start(ch, 0, ms);
+  drive(ch, true);
+  log_edge(ch, 1);
+  schedule(ch, due + slack(ch));
+}
+
+bool outputs_extend(uint8_t ch, uint32_t ms) {
+  if (ch >= g_n) return false;
+  Chan& c = g_ch[ch];
+  if (!(c.flags & F_ON) || c.slot < 0) return false;
+  to_level(ch);
+  const uint32_t due = c.due + ms;
+  if (c.hw >= 0) {
+    const int32_t left = (int32_t)(due - HW_SLACK_MS - millis());
+    if (!hw_retime(ch, left > 0 ? left : 0)) { hw_stop(ch); drive(ch, true); }
+  }
+  schedule(ch, due);
+  return true;
+}
+
+void outputs_pulse_after(uint8_t ch, uint32_t delay_ms, uint32_t ms) {
+  if (ch >= g_n) return;
+  outputs_off(ch);
+  Chan& c = g_ch[ch];
+  c.len = ms;
+  c.flags |= F_ARM_ON;
+  hw_start(ch, delay_ms, ms);   // exact start and end; the software edges below follow it
+  schedule(ch, millis() + delay_ms);
+}
+
+bool outputs_is_on(uint8_t ch) {
+  return ch < g_n && (g_ch[ch].flags & F_ON);
+}
+
+uint32_t outputs_remaining(uint8_t ch) {
+  if (ch >= g_n || g_ch[ch].slot < 0) return 0;
+  const int32_t d = (int32_t)(g_ch[ch].due - millis());
+  return d > 0 ? (uint32_t)d : 0;
+}
+
+int8_t outputs_find(const char* up) {
+  if (up[0] >= '0' && up[0] <= '9' && !up[1]) {
+    const uint8_t ch = up[0] - '0';
+    return ch < g_n ? (int8_t)ch : -1;
+  }
+  for (uint8_t i = 0; i < g_n; i++) {
+    if (strcmp_P(up, g_ch[i].name) == 0) return (int8_t)i;
+  }
+  return -1;
+}
+
+void outputs_update() {
+  if (!g_heap_n) return;
+  const uint32_t now = millis();
+  if ((int32_t)(now - g_ch[g_heap[0]].due) < 0) return;   // nothing due: one compare
+
+  while (g_heap_n) {
+    const uint8_t ch = g_heap[0];
+    Chan& c = g_ch[ch];
+    const int32_t late = (int32_t)(now - c.due);
+    if (late < 0) break;
+    if ((uint32_t)late > g_late_max) g_late_max = late;
+    g_edges++;
+
+    if (c.flags & F_ARM_ON) {
+      c.flags &= ~F_ARM_ON;
+      drive(ch, true);
+      c.flags |= F_PULSE;
+      log_edge(ch, c.len);
+      schedule(ch, now + c.len + slack(ch));   // full width even when the start ran late
+    } else {
+      unschedule(ch);
+      hw_stop(ch);
+      drive(ch, false);
+      if (!(c.flags & F_PULSE)) log_edge(ch, 0);
+      c.flags &= ~F_PULSE;
+    }
+  }
+}
+
+void outputs_print(Stream& s) {
+  s.println(F("=== Outputs ==="));
+  for (uint8_t i = 0; i < g_n; i++) {
+    const Chan& c = g_ch[i];
+    s.print(F("  ")); s.print(i); s.print(' ');
+    s.print(reinterpret_cast<const __FlashStringHelper*>(c.name));
+    for (uint8_t k = strlen_P(c.name); k < 8; k++) s.print(' ');
+    if (c.pin == NO_PIN) s.print(F("--"));
+    else { s.print('D'); s.print(c.pin); }
+    s.print((c.flags & F_ON) ? F("  ON") : F("  off"));
+    if (c.hw >= 0) s.print(F("  T5"));
+    if (c.slot >= 0) {
+      s.print((c.flags & F_ARM_ON) ? F("  on in ") : F("  off in "));
+      s.print(outputs_remaining(i)); s.print(F(" ms"));
+    }
+    s.println();
+  }
+  s.print(F("  pending ")); s.print(g_heap_n);
+  s.print(F("  edges ")); s.print(g_edges);
+  s.print(F("  worst late ")); s.print(g_late_max); s.println(F(" ms"));
+  hwtimer_print(s);
+}
@@ -0,0 +1,226 @@
+// src/pilink.cpp
+#include <Arduino.h>
+#include "pilink.hpp"
+#include "console.hpp"
+#include "eventlog.hpp"
+
+// ---------------- Tuning ----------------
+static const uint8_t  SOF            = 0x7E;
+static const uint8_t  N_SLOTS        = 4;      // frames in flight
+static const uint32_t ACK_TIMEOUT_US = 20000;  // resend after 20 ms without ack
+static const uint8_t  MAX_TRIES      = 4;      // first send + 3 retries
+
+// ---------------- State ----------------
+struct Slot {
+  bool     used;
+  uint8_t  seq;
+  uint8_t  type;
+  uint8_t  len;
+  uint8_t  payload[PILINK_MAX_PAYLOAD];
+  uint8_t  tries;
+  uint32_t t_first_us;   // first transmission, RTT is measured from here
+  uint32_t t_sent_us;    // last transmission, drives the retry timer
+};
+
+// Per command type round-trip stats (index = type - 1)
+struct RttStat {
+  uint16_t n;
+  uint32_t last_us;
+  uint32_t min_us;
+  uint32_t max_us;
+  uint32_t sum_us;
+};
+static const uint8_t N_TYPES = 4; // PING, CUE, START, STOP
+
+static HardwareSerial* g_port = nullptr;
+static Slot    g_slots[N_SLOTS];
+static uint8_t g_seq = 0;
+
+static uint32_t g_sent = 0, g_acked = 0, g_naked = 0, g_retries = 0, g_failed = 0, g_badcrc = 0;
+static RttStat  g_rtt[N_TYPES];
+
+// Receive parser
+enum RxState : uint8_t { RX_SOF = 0, RX_SEQ, RX_TYPE, RX_LEN, RX_PAYLOAD, RX_CRC };
+static RxState g_rx = RX_SOF;
+static uint8_t g_rx_seq, g_rx_type, g_rx_len, g_rx_idx;
+static uint8_t g_rx_buf[PILINK_MAX_PAYLOAD];
+
+// ---------------- CRC8 (poly 0x07) ----------------
+static uint8_t crc8_step(uint8_t c, uint8_t d) {
+  c ^= d;
+  for (uint8_t b = 0; b < 8; b++) c = (c & 0x80) ? (uint8_t)((c << 1) ^ 0x07) : (uint8_t)(c << 1);
+  return c;
+}
+
+// Indexed by type, 0 = unknown
+static const char TYPE_NAMES[N_TYPES + 1][6] PROGMEM = { "?", "PING", "CUE", "START", "STOP" };
+
+static const __FlashStringHelper* type_name(uint8_t type) {
+  return reinterpret_cast<const __FlashStringHelper*>(TYPE_NAMES[type <= N_TYPES ? type : 0]);
+}
+
+static void log_frame(const __FlashStringHelper* what, uint8_t type, uint8_t seq) {
+  char b[16];
+  strncpy_P(b, reinterpret_cast<PGM_P>(type_name(type)), 6);
+  snprintf_P(b + strlen(b), sizeof(b) - 6, PSTR(" seq %u"), seq);
+  console_log(what, b);
+}
+
+// ---------------- TX ----------------
+static void tx_slot(Slot& s) {
+  uint8_t hdr[4] = { SOF, s.seq, s.type, s.len };
+  uint8_t c = 0;
+  for (uint8_t i = 1; i < 4; i++) c = crc8_step(c, hdr[i]);
+  for (uint8_t i = 0; i < s.len; i++) c = crc8_step(c, s.payload[i]);
+
+  g_port->write(hdr, sizeof(hdr));
+  if (s.len) g_port->write(s.payload, s.len);
+  g_port->write(c);
+
+  s.t_sent_us = micros();
+  s.tries++;
+}
+
+bool pilink_send(uint8_t type, const uint8_t* payload, uint8_t len) {
+  if (!g_port || len > PILINK_MAX_PAYLOAD) return false;
+  for (uint8_t i = 0; i < N_SLOTS; i++) {
+    Slot& s = g_slots[i];
+    if (s.used) continue;
+    s.used  = true;
+    s.seq   = g_seq++;
+    s.type  = type;
+    s.len   = len;
+    if (len) memcpy(s.payload, payload, len);
+    s.tries = 0;
+    s.t_first_us = micros();
+    tx_slot(s);
+    g_sent++;
+    return true;
+  }
+  return false;
+}
+
+bool pilink_ping()             { return pilink_send(PILINK_PING); }
+bool pilink_cue(uint8_t cue)   { return pilink_send(PILINK_CUE, &cue, 1); }
+bool pilink_stop()             { return pilink_send(PILINK_STOP); }
+bool pilink_start(const char* name) {
+  if (!name) return false;
+  size_t n = strlen(name);
+  if (n == 0 || n > PILINK_MAX_PAYLOAD) return false;
+  return pilink_send(PILINK_START, reinterpret_cast<const uint8_t*>(name), (uint8_t)n);
+}
+
+// ---------------- RX ----------------
+static void on_reply(uint8_t seq, uint8_t type, const uint8_t* payload, uint8_t len) {
+  for (uint8_t i = 0; i < N_SLOTS; i++) {
+    Slot& s = g_slots[i];
+    if (!s.used || s.seq != seq) continue;
+
+    const uint32_t rtt = micros() - s.t_first_us;
+    s.used = false;
+
+    if (type == PILINK_NAK || (len > 0 && payload[0] != 0)) {
+      g_naked++;
+      evlog_add(EV_PI_FAIL, s.type, s.tries);
+      log_frame(F("PiLink NAK "), s.type, seq);
+      return;
+    }
+
+    g_acked++;
+    evlog_add(EV_PI_ACK, s.type, rtt);
+    if (s.type >= 1 && s.type <= N_TYPES) {
+      RttStat& r = g_rtt[s.type - 1];
+      r.last_us = rtt;
+      r.sum_us += rtt;
+      if (r.n == 0 || rtt < r.min_us) r.min_us = rtt;
+      if (rtt > r.max_us) r.max_us = rtt;
+      r.n++;
+    }
+    return;
+  }
+  // Late ack for a frame we already gave up on or acked: ignore
+}
+
+static void rx_byte(uint8_t b) {
+  static uint8_t crc = 0;
+  switch (g_rx) {
+    case RX_SOF:
+      if (b == SOF) { g_rx = RX_SEQ; crc = 0; }
+      break;
+    case RX_SEQ:  g_rx_seq  = b; crc = crc8_step(crc, b); g_rx = RX_TYPE; break;
+    case RX_TYPE: g_rx_type = b; crc = crc8_step(crc, b); g_rx = RX_LEN;  break;
+    case RX_LEN:
+      if (b > PILINK_MAX_PAYLOAD) { g_rx = RX_SOF; g_badcrc++; break; }
+      g_rx_len = b; g_rx_idx = 0; crc = crc8_step(crc, b);
+      g_rx = b ? RX_PAYLOAD : RX_CRC;
+      break;
+    case RX_PAYLOAD:
+      g_rx_buf[g_rx_idx++] = b; crc = crc8_step(crc, b);
+      if (g_rx_idx >= g_rx_len) g_rx = RX_CRC;
+      break;
+    case RX_CRC:
+      if (b == crc && (g_rx_type == PILINK_ACK || g_rx_type == PILINK_NAK)) {
+        on_reply(g_rx_seq, g_rx_type, g_rx_buf, g_rx_len);
+      } else if (b != crc) {
+        g_badcrc++;
+      }
+      g_rx = RX_SOF;
+      break;
+  }
+}
+
+// ---------------- Public API ----------------
+void pilink_begin(HardwareSerial& port, unsigned long baud) {
+  g_port = &port;
+  g_port->begin(baud);
+  for (uint8_t i = 0; i < N_SLOTS; i++) g_slots[i].used = false;
+  memset(g_rtt, 0, sizeof(g_rtt));
+  g_sent = g_acked = g_naked = g_retries = g_failed = g_badcrc = 0;
+  g_rx = RX_SOF;
+}
+
+void pilink_update() {
+  if (!g_port) return;
+
+  while (g_port->available()) rx_byte((uint8_t)g_port->read());
+
+  const uint32_t now = micros();
+  for (uint8_t i = 0; i < N_SLOTS; i++) {
+    Slot& s = g_slots[i];
+    if (!s.used || now - s.t_sent_us < ACK_TIMEOUT_US) continue;
+    if (s.tries >= MAX_TRIES) {
+      s.used = false;
+      g_failed++;
+      evlog_add(EV_PI_FAIL, s.type, s.tries);
+      log_frame(F("PiLink FAIL "), s.type, s.seq);
+      continue;
+    }
+    g_retries++;
+    tx_slot(s);
+  }
+}
+
+void pilink_print_stats(Stream& s) {
+  s.println(F("=== Pi Link ==="));
+  s.print(F("  sent "));     s.print(g_sent);
+  s.print(F("  acked "));    s.print(g_acked);
+  s.print(F("  nak "));      s.print(g_naked);
+  s.print(F("  retries "));  s.print(g_retries);
+  s.print(F("  failed "));   s.print(g_failed);
+  s.print(F("  bad "));      s.println(g_badcrc);
+
+  uint8_t inflight = 0;
+  for (uint8_t i = 0; i < N_SLOTS; i++) if (g_slots[i].used) inflight++;
+  s.print(F("  in flight ")); s.println(inflight);
+
+  s.println(F("  cmd    n   last_us  min_us  avg_us  max_us"));
+  for (uint8_t t = 0; t < N_TYPES; t++) {
+    const RttStat& r = g_rtt[t];
+    s.print(F("  ")); s.print(type_name(t + 1));
+    s.print(F("  ")); s.print(r.n);
+    s.print(F("  ")); s.print(r.last_us);
+    s.print(F("  ")); s.print(r.min_us);
+    s.print(F("  ")); s.print(r.n ? r.sum_us / r.n : 0UL);
+    s.print(F("  ")); s.println(r.max_us);
+  }
+}
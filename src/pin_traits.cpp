@@ -0,0 +1,50 @@
+// src/pin_traits.cpp
+#include <Arduino.h>
+#include "pin_traits.hpp"
+#include "pins.hpp"
+
+// Bench pin: the onboard LED, not wired to anything in the hearse
+typedef Pin<13> BenchPin;
+static const uint8_t  BENCH_PIN = 13;
+static const uint16_t N = 2000;
+// Beam B4 (D7, PH4) is an input on PORTH, above the I/O space; reading it is harmless
+typedef BeamPin4 BenchPinH;
+
+// Time N runs of stmt in us; the empty asm keeps the loop from being folded
+#define TIME_LOOP(out, stmt) do {                     \
+    const uint32_t t0 = micros();                       \
+    for (uint16_t i = 0; i < N; i++) { stmt; asm volatile(""); } \
+    out = micros() - t0;                                \
+  } while (0)
+
+static void row(Stream& s, const __FlashStringHelper* name, uint32_t us, uint32_t empty_us) {
+  const uint32_t net = us > empty_us ? us - empty_us : 0;
+  const uint32_t tenths = net * (F_CPU / 100000UL) / N;   // cycles x10 per call
+  s.print(F("  ")); s.print(name);
+  s.print(tenths / 10); s.print('.'); s.print(tenths % 10); s.println(F(" cycles"));
+}
+
+void pin_bench(Stream& s) {
+  volatile uint8_t sink = 0;
+  uint32_t t_empty, t_dr, t_pr, t_ph, t_dw, t_pw, t_pt;
+
+  pinMode(BENCH_PIN, OUTPUT);
+  TIME_LOOP(t_empty, (void)0);
+  TIME_LOOP(t_dr, sink = digitalRead(BENCH_PIN));
+  TIME_LOOP(t_pr, sink = BenchPin::read());
+  TIME_LOOP(t_ph, sink = BenchPinH::read());
+  TIME_LOOP(t_dw, digitalWrite(BENCH_PIN, i & 1));
+  TIME_LOOP(t_pw, BenchPin::write(i & 1));
+  TIME_LOOP(t_pt, BenchPin::toggle());
+  BenchPin::low();
+  BenchPin::input();
+  (void)sink;
+
+  s.print(F("=== Pin I/O, D13 (PB7), ")); s.print(N); s.println(F(" calls each, interrupts on ==="));
+  row(s, F("digitalRead          "), t_dr, t_empty);
+  row(s, F("Pin<>::read          "), t_pr, t_empty);
+  row(s, F("Pin<>::read D7 (PH4) "), t_ph, t_empty);
+  row(s, F("digitalWrite         "), t_dw, t_empty);
+  row(s, F("Pin<>::write         "), t_pw, t_empty);
+  row(s, F("Pin<>::toggle        "), t_pt, t_empty);
+}
@@ -0,0 +1,78 @@
+// src/prng.cpp
+#include <Arduino.h>
+#include "prng.hpp"
+#include "hwtimer.hpp"
+
+uint32_t g_prng[PRNG_STREAMS] = { 1, 2, 3, 4, 5, 6 };
+static uint32_t g_seed = 0;
+
+// murmur3 finalizer: every seed bit reaches every state bit
+static uint32_t mix(uint32_t h) {
+  h ^= h >> 16; h *= 0x85EBCA6BUL;
+  h ^= h >> 13; h *= 0xC2B2AE35UL;
+  h ^= h >> 16;
+  return h;
+}
+
+void prng_seed(uint32_t seed) {
+  g_seed = seed;
+  for (uint8_t s = 0; s < PRNG_STREAMS; s++) {
+    const uint32_t x = mix(seed + 0x9E3779B9UL * (s + 1));
+    g_prng[s] = x ? x : 0x6D2B79F5UL;   // xorshift never leaves 0
+  }
+}
+
+uint32_t prng_seed_value() { return g_seed; }
+
+uint32_t prng_entropy() {
+  uint32_t e = micros();
+  for (uint8_t i = 0; i < 32; i++) {
+    e = (e << 3 | e >> 29) ^ (uint32_t)analogRead(A0) ^ hwtimer_ticks();
+  }
+  return mix(e);
+}
+
+// ---------- Bench ----------
+static const uint16_t N = 1000;
+
+// Time N runs of stmt in us; the empty asm keeps the loop from being folded
+#define TIME_LOOP(out, stmt) do {                     \
+    const uint32_t t0 = micros();                       \
+    for (uint16_t i = 0; i < N; i++) { stmt; asm volatile(""); } \
+    out = micros() - t0;                                \
+  } while (0)
+
+static void row(Stream& s, const __FlashStringHelper* name, uint32_t us, uint32_t empty_us) {
+  const uint32_t net = us > empty_us ? us - empty_us : 0;
+  const uint32_t tenths = net * (F_CPU / 100000UL) / N;   // cycles x10 per call
+  s.print(F("  ")); s.print(name);
+  s.print(tenths / 10); s.print('.'); s.print(tenths % 10); s.println(F(" cycles"));
+}
+
+void prng_bench(Stream& s) {
+  volatile uint32_t sink = 0;
+  uint32_t t_empty, t_r, t_rn, t_rr, t_p, t_pb, t_pr;
+
+  // random() keeps its own state; the streams are put back after the run
+  uint32_t saved[PRNG_STREAMS];
+  memcpy(saved, g_prng, sizeof(saved));
+
+  TIME_LOOP(t_empty, (void)0);
+  TIME_LOOP(t_r,  sink = random());
+  TIME_LOOP(t_rn, sink = random(1000));
+  TIME_LOOP(t_rr, sink = random(600, 3000));
+  TIME_LOOP(t_p,  sink = prng_next(PRNG_EFFECTS));
+  TIME_LOOP(t_pb, sink = prng_below(PRNG_EFFECTS, 1000));
+  TIME_LOOP(t_pr, sink = prng_range(PRNG_EFFECTS, 600, 3000));
+  (void)sink;
+  memcpy(g_prng, saved, sizeof(saved));
+
+  s.print(F("=== PRNG, ")); s.print(N); s.println(F(" calls each, interrupts on ==="));
+  row(s, F("random()              "), t_r,  t_empty);
+  row(s, F("random(1000)          "), t_rn, t_empty);
+  row(s, F("random(600, 3000)     "), t_rr, t_empty);
+  row(s, F("prng_next             "), t_p,  t_empty);
+  row(s, F("prng_below(1000)      "), t_pb, t_empty);
+  row(s, F("prng_range(600, 3000) "), t_pr, t_empty);
+  s.print(F("  seed 0x")); s.println(g_seed, HEX);
+}
@@ -0,0 +1,162 @@
+// src/recovery.cpp
+#include <Arduino.h>
+#include <avr/wdt.h>
+#include <util/crc16.h>
+#include "recovery.hpp"
+#include "console.hpp"
+#include "eventlog.hpp"
+#include "inputs.hpp"
+#include "techlight.hpp"
+#include "scenes/scene_frankenphone.hpp"
+
+static const uint16_t WARM_MAGIC   = 0x5748; // 'WH'
+static const uint16_t SNAPSHOT_MS  = 20;
+static const uint8_t  N_BEAMS      = 6;
+
+// Everything here survives a reset; .noinit is not zeroed by the C runtime
+struct WarmState {
+  uint16_t magic;
+  uint16_t wdt_resets;       // watchdog resets since the last power-on
+  uint16_t warm_resumes;     // resets where the snapshot was restored
+  uint8_t  fp_phase;
+  uint32_t fp_elapsed_ms;
+  uint32_t fire_age_ms[N_BEAMS];
+  int8_t   light_override;
+  uint8_t  light_latch;
+  uint32_t light_block_ms;
+  uint16_t crc;              // _crc16_update over everything above
+};
+static WarmState g_warm __attribute__((section(".noinit")));
+
+// Written from the watchdog ISR, kept outside the CRC'd block so an
+// interrupted snapshot cannot be half-validated. stage_inv = ~stage.
+static volatile uint8_t g_stall_stage     __attribute__((section(".noinit")));
+static volatile uint8_t g_stall_stage_inv __attribute__((section(".noinit")));
+
+// Reset cause, copied from MCUSR before anything else runs
+static uint8_t g_mcusr __attribute__((section(".noinit")));
+
+volatile uint8_t g_recovery_stage = LOOP_NONE;
+
+static uint8_t  g_last_stall = LOOP_NONE;
+static bool     g_resumed    = false;
+static uint32_t g_next_snap  = 0;
+
+// MCUSR must be read and the watchdog stopped before main(): after a
+// watchdog reset it stays armed at 15 ms and would reset us again.
+void recovery_capture_mcusr() __attribute__((naked, used, section(".init3")));
+void recovery_capture_mcusr() {
+  g_mcusr = MCUSR;
+  MCUSR = 0;
+  wdt_disable();
+}
+
+static uint16_t warm_crc() {
+  const uint8_t* p = reinterpret_cast<const uint8_t*>(&g_warm);
+  uint16_t c = 0xFFFF;
+  for (uint8_t i = 0; i < offsetof(WarmState, crc); i++) c = _crc16_update(c, p[i]);
+  return c;
+}
+
+static bool warm_valid() {
+  return g_warm.magic == WARM_MAGIC && g_warm.crc == warm_crc();
+}
+
+static void snapshot() {
+  uint32_t elapsed;
+  g_warm.fp_phase      = frankenphone_phase(elapsed);
+  g_warm.fp_elapsed_ms = elapsed;
+  for (uint8_t i = 0; i < N_BEAMS; i++) g_warm.fire_age_ms[i] = inputs_fire_age(i);
+  bool latch;
+  techlight_warm_get(g_warm.light_override, latch, g_warm.light_block_ms);
+  g_warm.light_latch = latch ? 1 : 0;
+  g_warm.magic = WARM_MAGIC;
+  g_warm.crc   = warm_crc();
+}
+
+// First timeout: note the stalled stage, then reset right away
+ISR(WDT_vect) {
+  g_stall_stage     = g_recovery_stage;
+  g_stall_stage_inv = (uint8_t)~g_recovery_stage;
+  wdt_enable(WDTO_15MS);  // reset-only mode, fires ~15 ms later
+  for (;;) {}
+}
+
+static void wdt_arm() {
+  cli();
+  wdt_reset();
+  // Interrupt + reset mode, 1 s: WDIE gives the ISR a chance to log first
+  WDTCSR = _BV(WDCE) | _BV(WDE);
+  WDTCSR = _BV(WDIE) | _BV(WDE) | _BV(WDP2) | _BV(WDP1);
+  sei();
+}
+
+bool recovery_begin() {
+  const bool power_on = g_mcusr & (_BV(PORF) | _BV(BORF));
+  const bool by_wdt   = g_mcusr & _BV(WDRF);
+
+  if (by_wdt && (uint8_t)~g_stall_stage == g_stall_stage_inv) g_last_stall = g_stall_stage;
+  g_stall_stage = LOOP_NONE; g_stall_stage_inv = 0xFF;
+
+  g_resumed = false;
+  if (!power_on && warm_valid()) {
+    frankenphone_resume(g_warm.fp_phase, g_warm.fp_elapsed_ms);
+    for (uint8_t i = 0; i < N_BEAMS; i++) inputs_resume_fire_age(i, g_warm.fire_age_ms[i]);
+    techlight_warm_resume(g_warm.light_override, g_warm.light_latch != 0, g_warm.light_block_ms);
+    g_warm.warm_resumes++;
+    if (by_wdt) g_warm.wdt_resets++;
+    g_resumed = true;
+  } else {
+    g_warm.wdt_resets   = by_wdt ? 1 : 0;
+    g_warm.warm_resumes = 0;
+  }
+  snapshot();
+  evlog_add(EV_BOOT, g_last_stall, (g_resumed ? 1UL : 0UL) | ((uint32_t)g_mcusr << 8));
+
+  if (g_last_stall) {
+    char name[9];
+    strcpy_P(name, reinterpret_cast<PGM_P>(loop_stage_name(g_last_stall)));
+    console_log(F("WDT reset, loop stalled in stage "), name);
+  }
+  if (g_resumed)    console_log(F("Warm restart: scene state resumed"));
+
+  wdt_arm();
+  g_next_snap = millis() + SNAPSHOT_MS;
+  return g_resumed;
+}
+
+void recovery_kick() { wdt_reset(); }
+
+void recovery_update() {
+  wdt_reset();
+  const uint32_t now = millis();
+  if ((int32_t)(now - g_next_snap) >= 0) {
+    snapshot();
+    g_next_snap = now + SNAPSHOT_MS;
+  }
+}
+
+static const char STAGE_NAMES[LOOP_IDLE + 2][9] PROGMEM = {
+  "-", "CONSOLE", "INPUTS", "PILINK", "SCENE", "SETTINGS", "BOOT", "TEL", "OUT", "IDLE", "?"
+};
+
+const __FlashStringHelper* loop_stage_name(uint8_t s) {
+  return reinterpret_cast<const __FlashStringHelper*>(STAGE_NAMES[s <= LOOP_IDLE ? s : LOOP_IDLE + 1]);
+}
+
+void recovery_print(Stream& s) {
+  s.println(F("=== Watchdog / warm restart ==="));
+  s.print(F("  Reset cause:"));
+  if (g_mcusr & _BV(PORF))  s.print(F(" POWER"));
+  if (g_mcusr & _BV(BORF))  s.print(F(" BROWNOUT"));
+  if (g_mcusr & _BV(EXTRF)) s.print(F(" BUTTON"));
+  if (g_mcusr & _BV(WDRF))  s.print(F(" WATCHDOG"));
+  if (!g_mcusr)             s.print(F(" unknown (cleared by bootloader)"));
+  s.println();
+  s.print(F("  Resumed: "));      s.println(g_resumed ? F("yes") : F("no (cold)"));
+  s.print(F("  WDT resets: "));   s.println(g_warm.wdt_resets);
+  s.print(F("  Warm resumes: ")); s.println(g_warm.warm_resumes);
+  s.print(F("  Last stall: "));
+  s.println(loop_stage_name(g_last_stall));
+  s.println(F("  Window 1000 ms, snapshot every 20 ms"));
+}
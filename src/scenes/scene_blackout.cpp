@@ -5,6 +5,6 @@
 #include "pins.hpp"
 
 void scene_blackout() {
-  console_log("Scene: Blackout");
+  console_log(F("Scene: Blackout"));
   effects_showBlackout();  // Add this effect in effects.cpp if needed
 }
\ No newline at end of file
@@ -1,7 +1,10 @@
 // src/scenes/scene_blood.cpp
 //
 // Blood Room display animation with arbitration:
-// DRIP drips in -> flashes -> fades -> drips out.
+// DRIP drips in -> flashes -> fades -> drips out. The drips are segment
+// frames: a drop falls down each cell before its letter lands, and on the
+// way out each letter drains through the bottom bar.
+// Flash and fade run on the HT16K33: one blink write, then a brightness ramp.
 // Takes ownership "BLOOD" with priority 8 so it can preempt idle OBEY
 // but will not preempt Frankenphone during HOLD.
 //
@@ -11,9 +14,12 @@
 #include "display.hpp"
 #include "triggers.hpp"
 #include "console.hpp"
+#include "eventlog.hpp"
 #include "pins.hpp"
+#include "outframe.hpp"
 
-static const char* OWNER = "BLOOD";
+static const char OWNER[] PROGMEM = "BLOOD";
+static const uint8_t LOG_CODE = 12;  // Scene::BloodRoom, event log id
 static const uint8_t OWNER_PRIO = 8; // below FRANK 10, above idle
 
 #ifndef LED_HOLD
@@ -25,34 +31,35 @@ static Stage s_stage = BD_IDLE;
 static bool  s_active = false;
 static uint32_t s_next = 0;
 static uint8_t s_in_idx = 0;
-static bool  s_in_dot = true;
-static uint8_t s_flash = 0;
-static int8_t s_fade = 12;
 static int8_t s_out_idx = 3;
-static bool  s_out_dot = true;
-
-static const char WORD[5] = "DRIP";
-static const uint16_t T_IN_DOT   = 120;
-static const uint16_t T_IN_LET   = 140;
-static const uint16_t T_FLASH_ON = 120;
-static const uint16_t T_FLASH_OFF= 120;
-static const uint8_t  N_FLASH    = 6;
-static const uint16_t T_FADE     = 120;
-static const int8_t   FADE_MIN   = 3;
-static const uint16_t T_OUT_DOT  = 100;
-static const uint16_t T_OUT_BLK  = 120;
+static uint8_t s_drop = 0;            // drop frame within the current cell
+static uint16_t s_word[4];            // WORD as segment words, built at scene start
+
+static const char WORD[] PROGMEM = "DRIP";
+static const char BLANK[5] = "    ";
+static const uint16_t DROP_IN[]  PROGMEM = { SEG_A, SEG_G, SEG_D };   // falls into the cell
+static const uint16_t DROP_OUT[] PROGMEM = { SEG_G, SEG_D, SEG_DP };  // letter drains out
+static const uint8_t  N_DROP     = 3;
+static const uint16_t T_DROP     = 50;    // per drop frame
+static const uint16_t T_IN_LET   = 120;   // letter shown before the next drop
+static const uint16_t T_FLASH    = 1000;  // two 2 Hz hardware blinks
+static const uint8_t  FADE_FROM  = 12;
+static const uint8_t  FADE_MIN   = 3;
+static const uint16_t T_FADE     = 120;   // per brightness level
+static const uint16_t T_OUT_GAP  = 100;   // empty cell before the next letter drains
 
 static inline void red_blink_soft(uint32_t now_ms) {
   uint16_t p = now_ms % 600;
-  analogWrite(LED_HOLD, p < 120 ? 150 : 0);
+  outframe_pwm(LED_HOLD, p < 120 ? 150 : 0);
 }
 
 static void show4(const char* s4){ display_print4_owned(OWNER, s4); }
-static void showDotAt(uint8_t idx, const char* base) {
-  char b[5] = {' ',' ',' ',' ','\0'};
-  for (uint8_t i=0;i<4;i++) b[i] = base && base[i] ? base[i] : ' ';
-  b[idx] = '.';
-  show4(b);
+// First n letters of WORD, cell 'at' (if >= 0) showing raw segments
+static void show_drip(uint8_t n, int8_t at, uint16_t seg) {
+  uint16_t f[4] = {0, 0, 0, 0};
+  memcpy(f, s_word, n * sizeof(uint16_t));
+  if (at >= 0) f[at] = seg;
+  display_segments_owned(OWNER, f);
 }
 
 void scene_blood() {
@@ -60,23 +67,26 @@ void scene_blood() {
   // Acquire for a few seconds to survive idle writers
   display_acquire(OWNER, OWNER_PRIO, 3000);
   display_set_brightness_owned(OWNER, 10);
-  show4("    ");
+  show4(BLANK);
 
   // initial state
   s_stage = BD_IN;
   s_active= true;
-  s_next  = millis() + T_IN_DOT;
-  s_in_idx= 0; s_in_dot = true;
-  s_flash = 0;
-  s_fade  = 12;
-  s_out_idx = 3; s_out_dot = true;
+  s_next  = millis() + T_DROP;
+  s_in_idx= 0;
+  s_out_idx = 3;
+  s_drop  = 0;
+  display_glyphs_P(s_word, WORD, 4);
 
   // Pulse Pi BLOOD cue
-  triggers_pulse_by_name(String("BLOOD"));
+  triggers_pulse(1);   // BLOOD
 
-  console_log("Blood: DRIP animation start");
+  evlog_add(EV_SCENE, LOG_CODE, EVP_START);
+  console_log(F("Blood: DRIP animation start"));
 }
 
+bool scene_blood_active() { return s_active; }
+
 void scene_blood_tick() {
   if (!s_active) return;
   uint32_t now = millis();
@@ -85,65 +95,55 @@ void scene_blood_tick() {
   switch (s_stage) {
     case BD_IN:
       if (now >= s_next) {
-        char base[5] = {' ',' ',' ',' ','\0'};
-        for (uint8_t i=0;i<s_in_idx;i++) base[i] = WORD[i];
-        if (s_in_dot) {
-          showDotAt(s_in_idx, base);
-          s_in_dot = false; s_next = now + T_IN_LET;
+        if (s_drop < N_DROP) {
+          show_drip(s_in_idx, s_in_idx, pgm_read_word(&DROP_IN[s_drop]));
+          s_drop++; s_next = now + T_DROP;
         } else {
-          base[s_in_idx] = WORD[s_in_idx];
-          show4(base);
-          s_in_dot = true; s_in_idx++;
-          s_next = now + T_IN_DOT;
-          if (s_in_idx >= 4) { s_stage = BD_FLASH; s_next = now + T_FLASH_ON; show4(WORD); }
+          s_in_idx++; s_drop = 0;
+          show_drip(s_in_idx, -1, 0);
+          s_next = now + T_IN_LET;
+          if (s_in_idx >= 4) {
+            s_stage = BD_FLASH; s_next = now + T_FLASH;
+            display_blink_owned(OWNER, DISP_BLINK_2HZ);
+          }
         }
       }
       break;
 
     case BD_FLASH:
       if (now >= s_next) {
-        if ((s_flash & 1) == 0) { show4("    "); s_next = now + T_FLASH_OFF; }
-        else                    { show4(WORD);   s_next = now + T_FLASH_ON;  }
-        s_flash++;
-        if (s_flash >= N_FLASH) { s_stage = BD_FADE; s_next = now + T_FADE; display_set_brightness_owned(OWNER, s_fade); show4(WORD); }
+        display_blink_owned(OWNER, DISP_BLINK_OFF);
+        display_set_brightness_owned(OWNER, FADE_FROM);
+        display_ramp_owned(OWNER, FADE_MIN, (uint32_t)(FADE_FROM - FADE_MIN) * T_FADE);
+        s_stage = BD_FADE;
       }
       break;
 
     case BD_FADE:
-      if (now >= s_next) {
-        if (s_fade > FADE_MIN) {
-          s_fade--;
-          display_set_brightness_owned(OWNER, s_fade);
-          s_next = now + T_FADE;
-        } else {
-          s_stage = BD_OUT; s_next = now + T_OUT_DOT;
-        }
-      }
+      if (!display_ramping()) { s_stage = BD_OUT; s_next = now + T_OUT_GAP; }
       break;
 
     case BD_OUT:
       if (now >= s_next) {
-        char base[5] = {' ',' ',' ',' ','\0'};
-        for (int i=0;i<s_out_idx;i++) base[i] = WORD[i];
-        if (s_out_dot) {
-          showDotAt(s_out_idx, base);
-          s_out_dot = false; s_next = now + T_OUT_BLK;
+        if (s_drop < N_DROP) {
+          show_drip((uint8_t)s_out_idx, s_out_idx, pgm_read_word(&DROP_OUT[s_drop]));
+          s_drop++; s_next = now + T_DROP;
         } else {
-          base[s_out_idx] = ' ';
-          show4(base);
-          s_out_dot = true; s_out_idx--;
-          s_next = now + T_OUT_DOT;
-          if (s_out_idx < 0) { s_stage = BD_DONE; s_next = now + 80; show4("    "); }
+          show_drip((uint8_t)s_out_idx, -1, 0);
+          s_drop = 0; s_out_idx--;
+          s_next = now + T_OUT_GAP;
+          if (s_out_idx < 0) { s_stage = BD_DONE; s_next = now + 80; show4(BLANK); }
         }
       }
       break;
 
     case BD_DONE:
     default:
-      analogWrite(LED_HOLD, 0);
+      outframe_pwm(LED_HOLD, 0);
       s_active = false;
       display_release(OWNER);
-      console_log("Blood: DRIP animation end");
+      evlog_add(EV_SCENE, LOG_CODE, EVP_END);
+      console_log(F("Blood: DRIP animation end"));
       break;
   }
 
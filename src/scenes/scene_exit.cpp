@@ -4,6 +4,6 @@
 #include "scene_common.hpp"
 
 void scene_exit() {
-  console_log("Scene: Exit or Die");
+  console_log(F("Scene: Exit or Die"));
   effects_exitStrobe();
 }
\ No newline at end of file
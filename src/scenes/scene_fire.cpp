@@ -4,6 +4,6 @@
 #include "scene_common.hpp"
 
 void scene_fire() {
-  console_log("Scene: Fire Room");
+  console_log(F("Scene: Fire Room"));
   effects_fireFlicker();
 }
\ No newline at end of file
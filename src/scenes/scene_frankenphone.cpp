@@ -3,7 +3,7 @@
 // Frankenphones Lab scene with exact text flow requested:
 //
 // HOLD 8 s total (magnet ON first 5 s):
-//   - Flash "----" two times
+//   - Flash "----" two times (HT16K33 hardware blink)
 //   - Scroll "SYSTEM OVERRIDE"
 //   - Scroll 16 random digits
 //   - Flash MMYY
@@ -11,7 +11,7 @@
 //   - Scroll 5-digit ZIP once
 // COOLDOWN 20 s:
 //   - Yellow LED flicker
-//   - Flash cycle: ACES, GRTD, DONE, OPEN, OHIO
+//   - Flash cycle: ACES, GRTD, DONE, OPEN, OHIO (idle hardware blink, a word per blink)
 //   - A couple of PIN flashes with 3 digits
 //
 // Uses display arbitration so HOLD text cannot be stomped.
@@ -21,15 +21,22 @@
 #include "pins.hpp"
 #include "display.hpp"
 #include "console.hpp"
+#include "eventlog.hpp"
+#include "outframe.hpp"
+#include "outputs.hpp"
+#include "prng.hpp"
 #include "scenes/scene_frankenphone.hpp"
 
 // ---------- Constants ----------
-static const char*  OWNER            = "FRANK";
+static const char   OWNER[] PROGMEM  = "FRANK";
 static const uint8_t OWNER_PRIO      = 10;
+static const uint8_t LOG_CODE        = 1;     // Scene::FrankenLab, event log id
 
-static const unsigned long HOLD_MS     = 8000UL;   // 8 s total hold
 static const unsigned long MAG_ON_MS   = 5000UL;   // magnet ON first 5 s
-static const unsigned long COOLDOWN_MS = 20000UL;  // 20 s cooldown
+
+// Live-tuned via settings HOLD / COOL
+static unsigned long g_hold_ms     = 8000UL;   // 8 s total hold
+static unsigned long g_cooldown_ms = 20000UL;  // 20 s cooldown
 
 // ---------- State ----------
 enum PhaseState { IDLE = 0, HOLD, COOLDOWN };
@@ -40,8 +47,8 @@ static unsigned long g_tPhaseStart = 0;
 static bool g_muted = false;
 
 // ---------- LED helpers ----------
-inline void magnetOn()  { digitalWrite(PIN_MAGNET_CTRL, HIGH); }
-inline void magnetOff() { digitalWrite(PIN_MAGNET_CTRL, LOW);  }
+static int8_t g_magCh = -1;   // timed output channel, switched off by outputs_update()
+inline void magnetOff() { if (g_magCh >= 0) outputs_off(g_magCh); }
 inline void buzzerOff() { noTone(PIN_BUZZER); }
 
 static void animateGreenIdle() {
@@ -50,108 +57,122 @@ static void animateGreenIdle() {
   unsigned long t = ms % period;
   int val = (t < period/2) ? map(t, 0, period/2, 30, 255)
                            : map(t, period/2, period, 255, 30);
-  analogWrite(LED_ARMED, val);
-  analogWrite(LED_HOLD, 0);
-  analogWrite(LED_COOLDOWN, 0);
+  outframe_pwm(LED_ARMED, val);
+  outframe_pwm(LED_HOLD, 0);
+  outframe_pwm(LED_COOLDOWN, 0);
 }
 static void animateRedHold(unsigned long holdElapsed) {
   const unsigned int PERIOD_SLOW_MS = 300;
   const unsigned int PERIOD_FAST_MS = 40;
-  unsigned long clamped = (holdElapsed > HOLD_MS) ? HOLD_MS : holdElapsed;
+  unsigned long clamped = (holdElapsed > g_hold_ms) ? g_hold_ms : holdElapsed;
   unsigned int period = PERIOD_SLOW_MS
-                      - ( (long)(PERIOD_SLOW_MS - PERIOD_FAST_MS) * (long)clamped ) / (long)HOLD_MS;
-  int brightness = 60 + (int)((195L * (long)clamped) / (long)HOLD_MS);
+                      - ( (long)(PERIOD_SLOW_MS - PERIOD_FAST_MS) * (long)clamped ) / (long)g_hold_ms;
+  int brightness = 60 + (int)((195L * (long)clamped) / (long)g_hold_ms);
   brightness = constrain(brightness, 0, 255);
   unsigned long phase = millis() % period;
   bool on = (phase < (period * 45UL) / 100UL);
-  analogWrite(LED_HOLD, on ? brightness : 0);
-  analogWrite(LED_ARMED, 0);
-  analogWrite(LED_COOLDOWN, 0);
+  outframe_pwm(LED_HOLD, on ? brightness : 0);
+  outframe_pwm(LED_ARMED, 0);
+  outframe_pwm(LED_COOLDOWN, 0);
 }
 static void animateYellowCooldown() {
   static unsigned long ledRandDeadline = 0;
   static int ledYellowPWM = 0;
   unsigned long now = millis();
   if (now >= ledRandDeadline) {
-    ledYellowPWM = random(40, 255);
-    unsigned long dwell = (unsigned long)random(20, 120);
+    ledYellowPWM = prng_range(PRNG_FRANK_LED, 40, 255);
+    unsigned long dwell = (unsigned long)prng_range(PRNG_FRANK_LED, 20, 120);
     ledRandDeadline = now + dwell;
-    analogWrite(LED_COOLDOWN, ledYellowPWM);
+    outframe_pwm(LED_COOLDOWN, ledYellowPWM);
   }
-  analogWrite(LED_ARMED, 0);
-  analogWrite(LED_HOLD, 0);
+  outframe_pwm(LED_ARMED, 0);
+  outframe_pwm(LED_HOLD, 0);
 }
 
 // ---------- Modem sound (~8 s, moderate volume) ----------
+static const unsigned long MODEM_MS = 8000UL;
 static void modemSound(unsigned long t){
   if (g_muted) { buzzerOff(); return; }
   if      (t <  300) tone(PIN_BUZZER, 1700);
   else if (t <  700) tone(PIN_BUZZER, ((millis()/20)&1)?1200:2000);
   else if (t < 1400) tone(PIN_BUZZER, 500 + (int)((t-700)*(1600.0/700.0)));
-  else if (t < 2200) { if ((millis()&0x03)==0) tone(PIN_BUZZER, random(600,3000)); }
+  else if (t < 2200) { if ((millis()&0x03)==0) tone(PIN_BUZZER, prng_range(PRNG_FRANK_TONE, 600, 3000)); }
   else if (t < 3000) tone(PIN_BUZZER, ((millis()/35)&1)?1300:1800);
-  else if (t < 8000) tone(PIN_BUZZER, 1000);
+  else if (t < MODEM_MS) tone(PIN_BUZZER, 1000);
   else buzzerOff();
 }
 
 // ---------- Random helpers ----------
-static String randomDigits(uint8_t n){
-  String s; s.reserve(n);
-  for(uint8_t i=0;i<n;i++) s += char('0'+random(10));
-  return s;
+// Writes n digits and a NUL, out must hold n+1
+static void randomDigits(char* out, uint8_t n){
+  for(uint8_t i=0;i<n;i++) out[i] = char('0' + prng_below(PRNG_FRANK_TEXT, 10));
+  out[n] = '\0';
 }
-static String nearFutureMMYY(){
-  uint8_t addMonths= random(1,18);
+static void nearFutureMMYY(char* out, size_t len){
+  uint8_t addMonths= prng_range(PRNG_FRANK_TEXT, 1, 18);
   uint8_t nowMonth = 7;
   uint16_t nowYear = 2025;
   uint16_t y = nowYear + (nowMonth+addMonths-1)/12;
   uint8_t  m = ((nowMonth-1+addMonths)%12)+1;
-  char buf[5]; // 4 chars + NUL
-  snprintf(buf,sizeof(buf),"%02u%02u", m, (uint8_t)(y%100));
-  return String(buf); // "MMYY" 4 chars
+  snprintf_P(out, len, PSTR("%02u%02u"), m, (uint8_t)(y%100)); // "MMYY" 4 chars
 }
 
 // ---------- HOLD display sequence ----------
 enum FPDispStage { FP_IDLE=0, FP_FLASH2, FP_SCROLL_SYS, FP_SCROLL_16, FP_FLASH_MMYY, FP_SCROLL_PIN3, FP_SCROLL_ZIP5, FP_DONE };
 static FPDispStage fp_disp = FP_IDLE;
 
-static String fp_scroll;
-static uint16_t fp_idx = 0;
+// Fixed buffers: no String heap churn while the scene runs.
+// A scroll is converted to segment words once; each step is a 4-word copy.
+static const uint8_t SCROLL_PAD = 4;                 // blanks before and after
+static const uint8_t SCROLL_MAX = 16;
+static uint16_t fp_scroll[SCROLL_PAD + SCROLL_MAX + SCROLL_PAD];
+static uint8_t fp_scrollLen = 0;
+static uint8_t fp_idx = 0;
 static unsigned long fp_next = 0;
 static uint8_t fp_flashCount = 0;
-static String fp_digits16;
-static String fp_mmyy;
-static String fp_pin3;
-static String fp_zip5;
+static char fp_digits16[17];
+static char fp_mmyy[5];
+static char fp_pin3[8];     // "PIN ddd"
+static char fp_zip5[6];
 
 static void show4_owned(const char* s4) {
   display_print4_owned(OWNER, s4);
 }
-static void showStr4_owned(const String& s) {
-  char b[5] = {' ',' ',' ',' ','\0'};
-  for (uint8_t i=0;i<4 && i<s.length(); ++i) b[i]=s[i];
+static void show4_owned_P(PGM_P s4) {
+  char b[5];
+  strncpy_P(b, s4, 4);
+  b[4] = '\0';
   display_print4_owned(OWNER, b);
 }
-static void scroll_init(const String& msg, uint16_t leadSpaces = 4, uint16_t tailSpaces = 4) {
-  String lead(leadSpaces, ' ');
-  String tail(tailSpaces, ' ');
-  fp_scroll = lead + msg + tail;
+static void scroll_init(const char* msg) {
+  const uint8_t n = strnlen(msg, SCROLL_MAX);
+  fp_scrollLen = SCROLL_PAD + n + SCROLL_PAD;
+  display_glyphs(fp_scroll, nullptr, SCROLL_PAD);                    // blanks
+  display_glyphs(fp_scroll + SCROLL_PAD, msg, n);
+  display_glyphs(fp_scroll + SCROLL_PAD + n, nullptr, SCROLL_PAD);
   fp_idx = 0;
   fp_next = millis(); // first tick ASAP
 }
+static void scroll_init_P(PGM_P msg) {
+  char b[SCROLL_MAX + 1];
+  strncpy_P(b, msg, SCROLL_MAX);
+  b[SCROLL_MAX] = '\0';
+  scroll_init(b);
+}
 static bool scroll_step(uint16_t step_ms = 160) {
   if (millis() < fp_next) return false;
-  if (fp_idx + 4 > fp_scroll.length()) return true;
-  showStr4_owned(fp_scroll.substring(fp_idx, fp_idx + 4));
+  if (fp_idx + 4 > fp_scrollLen) return true;
+  display_segments_owned(OWNER, fp_scroll + fp_idx);
   fp_idx++;
   fp_next = millis() + step_ms;
   return false;
 }
 static void hold_sequence_begin() {
-  fp_digits16 = randomDigits(16);
-  fp_mmyy     = nearFutureMMYY();
-  fp_pin3     = String("PIN ") + randomDigits(3);  // will be scrolled
-  fp_zip5     = randomDigits(5);
+  randomDigits(fp_digits16, 16);
+  nearFutureMMYY(fp_mmyy, sizeof(fp_mmyy));
+  strcpy_P(fp_pin3, PSTR("PIN "));
+  randomDigits(fp_pin3 + 4, 3);                // will be scrolled
+  randomDigits(fp_zip5, 5);
 
   fp_disp = FP_FLASH2;
   fp_flashCount = 0;
@@ -159,8 +180,9 @@ static void hold_sequence_begin() {
 }
 
 // ---------- COOLDOWN helpers ----------
-static const char* CD_FRAMES[] = {"ACES","GRTD","DONE","OPEN","OHIO"};
+static const char CD_FRAMES[][5] PROGMEM = {"ACES","GRTD","DONE","OPEN","OHIO"};
 static const uint8_t CD_NFR = 5;
+static const uint16_t CD_FRAME_MS = 1000;   // one 1 Hz blink per word
 static uint8_t cd_frame = 0;
 static unsigned long cd_nextFrame = 0;
 static unsigned long cd_nextPin = 0;
@@ -168,7 +190,7 @@ static uint8_t cd_pinBudget = 2; // "a couple"
 
 // Simple cooldown PIN flash mini-state
 static bool cd_pinPhase = false; // false = show "PIN ", true = show " ddd"
-static String cd_pinDigits;
+static char cd_pinDigits[5];      // " ddd"
 
 // ---------- Public API ----------
 void frankenphone_set_mute(bool muted) {
@@ -176,33 +198,85 @@ void frankenphone_set_mute(bool muted) {
   if (g_muted) buzzerOff();
 }
 
-void frankenphone_init() {
-  pinMode(PIN_MAGNET_CTRL, OUTPUT); magnetOff();
-  pinMode(PIN_BUZZER, OUTPUT);      buzzerOff();
-  pinMode(LED_ARMED, OUTPUT);
-  pinMode(LED_HOLD, OUTPUT);
-  pinMode(LED_COOLDOWN, OUTPUT);
-  randomSeed(analogRead(A0));
-
-  display_idle("OBEY");
+void frankenphone_set_hold(uint32_t ms)     { g_hold_ms = ms ? ms : 1; } // never 0, used as a divisor
+void frankenphone_set_cooldown(uint32_t ms) { g_cooldown_ms = ms; }
 
+void frankenphone_init() {
+  if (g_magCh < 0) g_magCh = outputs_add(PIN_MAGNET_CTRL, PSTR("MAGNET"), true, true);
+  magnetOff();
+  BuzzerPin::output();              buzzerOff();
+  outframe_claim(LED_ARMED, outframe_level(LED_ARMED));   // keep what effects_begin() lit
+  outframe_claim(LED_HOLD);
+  outframe_claim(LED_COOLDOWN);
+
+  // Idle "OBEY" is drawn by frankenphone_update() once the display is up;
+  // random is seeded by the deferred boot steps.
   g_state = IDLE;
   fp_disp = FP_IDLE;
 }
 
+static void cooldown_begin(unsigned long now, unsigned long elapsed) {
+  g_state = COOLDOWN;
+  g_tPhaseStart = now - elapsed;
+  magnetOff();   // hold may be tuned shorter than the magnet window
+  buzzerOff();
+  // release or let the lease expire shortly
+  display_release(OWNER);
+  display_set_blink(DISP_BLINK_1HZ);   // cooldown words blink while the display is free
+
+  // Prep cooldown text
+  cd_frame = 0;
+  cd_nextFrame = now;   // draw immediately
+  cd_nextPin   = now + 1500;
+  cd_pinBudget = 2;
+  cd_pinPhase  = false;
+}
+
+bool frankenphone_magnet_on() { return g_magCh >= 0 && outputs_is_on(g_magCh); }
+bool frankenphone_buzzer_on() {
+  return g_state == HOLD && !g_muted && millis() - g_tPhaseStart < MODEM_MS;
+}
+
+uint8_t frankenphone_phase(uint32_t& elapsed_ms) {
+  elapsed_ms = (g_state == IDLE) ? 0 : millis() - g_tPhaseStart;
+  return (uint8_t)g_state;
+}
+
+void frankenphone_resume(uint8_t phase, uint32_t elapsed_ms) {
+  const unsigned long now = millis();
+  if (phase == HOLD && elapsed_ms < g_hold_ms) {
+    scene_frankenphone();
+    g_tPhaseStart = now - elapsed_ms;
+    magnetOff();
+    if (elapsed_ms < MAG_ON_MS && g_magCh >= 0) outputs_hold_for(g_magCh, MAG_ON_MS - elapsed_ms);
+    console_log(F("Frankenphone: HOLD resumed after reset"));
+    return;
+  }
+  if (phase != HOLD && phase != COOLDOWN) return;
+
+  // Hold may have run out during the reset: continue cooldown where it would be
+  const uint32_t cd = (phase == COOLDOWN) ? elapsed_ms : elapsed_ms - g_hold_ms;
+  if (cd < g_cooldown_ms) {
+    cooldown_begin(now, cd);
+    console_log(F("Frankenphone: COOLDOWN resumed after reset"));
+  }
+}
+
 void scene_frankenphone() {
   g_tPhaseStart = millis();
   g_state = HOLD;
+  display_set_blink(DISP_BLINK_OFF);   // a retrigger ends the cooldown blink
 
   // Actuators
-  magnetOn(); // will auto-off at 5 s in update
+  if (g_magCh >= 0) outputs_hold_for(g_magCh, MAG_ON_MS);   // off at 5 s, or at cooldown
 
   // Display: take ownership for hold + a little slack
-  display_acquire(OWNER, OWNER_PRIO, HOLD_MS + 1500);
+  display_acquire(OWNER, OWNER_PRIO, g_hold_ms + 1500);
   display_set_brightness_owned(OWNER, 10);
   hold_sequence_begin();
 
-  console_log("Frankenphone: HOLD start");
+  evlog_add(EV_SCENE, LOG_CODE, EVP_START);
+  console_log(F("Frankenphone: HOLD start"));
 }
 
 void frankenphone_update() {
@@ -211,9 +285,6 @@ void frankenphone_update() {
   if (g_state == HOLD) {
     unsigned long elapsed = now - g_tPhaseStart;
 
-    // Magnet window
-    if (elapsed >= MAG_ON_MS) magnetOff();
-
     // Sound and lights
     modemSound(elapsed);
     animateRedHold(elapsed);
@@ -225,12 +296,15 @@ void frankenphone_update() {
     switch (fp_disp) {
       case FP_FLASH2:
         if (now >= fp_next) {
-          // Alternate "----" and blanks, total of 2 visible flashes
-          if ((fp_flashCount % 2) == 0) show4_owned("----"); else show4_owned("    ");
-          fp_flashCount++;
-          fp_next = now + ((fp_flashCount % 2) ? 160 : 200); // on 200 ms, off 160 ms
-          if (fp_flashCount >= 4) { // on, off, on, off
-            scroll_init("SYSTEM OVERRIDE");
+          // "----" written once, the display blinks it: 2 flashes at 2 Hz
+          if (fp_flashCount == 0) {
+            show4_owned_P(PSTR("----"));
+            display_blink_owned(OWNER, DISP_BLINK_2HZ);
+            fp_flashCount = 1;
+            fp_next = now + 1000;
+          } else {
+            display_blink_owned(OWNER, DISP_BLINK_OFF);
+            scroll_init_P(PSTR("SYSTEM OVERRIDE"));
             fp_disp = FP_SCROLL_SYS;
           }
         }
@@ -250,8 +324,8 @@ void frankenphone_update() {
       case FP_FLASH_MMYY: {
         static uint8_t flashes = 0;
         if (now >= fp_next) {
-          if ((flashes % 2) == 0) show4_owned("DATE");
-          else                    showStr4_owned(fp_mmyy);
+          if ((flashes % 2) == 0) show4_owned_P(PSTR("DATE"));
+          else                    show4_owned(fp_mmyy);
           flashes++;
           fp_next = now + 500;
           if (flashes >= 4) { // DATE, MMYY, DATE, MMYY
@@ -279,65 +353,49 @@ void frankenphone_update() {
     }
 
     // End of HOLD -> COOLDOWN
-    if (elapsed >= HOLD_MS) {
-      g_state = COOLDOWN;
-      g_tPhaseStart = now;
-      buzzerOff();
-      // release or let the lease expire shortly
-      display_release(OWNER);
-
-      // Prep cooldown text
-      cd_frame = 0;
-      cd_nextFrame = now;   // draw immediately
-      cd_nextPin   = now + 1500;
-      cd_pinBudget = 2;
-      cd_pinPhase  = false;
-
-      console_log("Frankenphone: COOLDOWN start");
+    if (elapsed >= g_hold_ms) {
+      cooldown_begin(now, 0);
+      evlog_add(EV_SCENE, LOG_CODE, EVP_COOLDOWN);
+      console_log(F("Frankenphone: COOLDOWN start"));
     }
 
   } else if (g_state == COOLDOWN) {
     animateYellowCooldown();
 
-    // Base frame flashing cycle via display_idle
+    // Base frame cycle via display_idle, the idle blink flashes each word
     if (now >= cd_nextFrame) {
-      // Flash: word then blank short, so it "flashes"
-      static bool showWord = true;
-      if (showWord) {
-        display_idle(CD_FRAMES[cd_frame]);
-        cd_nextFrame = now + 420;
-      } else {
-        display_idle("    ");
-        cd_frame = (cd_frame + 1) % CD_NFR;
-        cd_nextFrame = now + 180;
-      }
-      showWord = !showWord;
+      display_idle_P(CD_FRAMES[cd_frame]);
+      cd_frame = (cd_frame + 1) % CD_NFR;
+      cd_nextFrame = now + CD_FRAME_MS;
     }
 
     // Occasional PIN flashes during cooldown, only a couple
     if (cd_pinBudget > 0 && now >= cd_nextPin) {
       if (!cd_pinPhase) {
-        display_idle("PIN ");
-        cd_pinDigits = String(" ") + randomDigits(3); // e.g. " 123"
+        display_idle_P(PSTR("PIN "));
+        cd_pinDigits[0] = ' ';
+        randomDigits(cd_pinDigits + 1, 3); // e.g. " 123"
         cd_pinPhase = true;
-        cd_nextPin = now + 450;
+        cd_nextPin = now + CD_FRAME_MS;
       } else {
-        display_idle(cd_pinDigits.c_str());
+        display_idle(cd_pinDigits);
         cd_pinPhase = false;
         cd_pinBudget--;
-        cd_nextPin = now + 3000 + random(0, 1500); // next window later
+        cd_nextPin = now + 3000 + prng_below(PRNG_FRANK_TEXT, 1500); // next window later
       }
     }
 
     // Done with cooldown
-    if (now - g_tPhaseStart >= COOLDOWN_MS) {
+    if (now - g_tPhaseStart >= g_cooldown_ms) {
+      display_set_blink(DISP_BLINK_OFF);
       g_state = IDLE;
       fp_disp = FP_IDLE;
-      console_log("Frankenphone: rearmed");
+      evlog_add(EV_SCENE, LOG_CODE, EVP_IDLE);
+      console_log(F("Frankenphone: rearmed"));
     }
 
   } else { // IDLE
     animateGreenIdle();
-    display_idle("OBEY");
+    display_idle_P(PSTR("OBEY"));
   }
 }
\ No newline at end of file
@@ -1,8 +1,10 @@
 #pragma once
+#include <stdint.h>
 
 // Frankenphones Lab public API
 
-// Call once at boot to init pins and idle display
+// Call once at boot to put magnet, buzzer and LEDs in a safe state.
+// No serial or I2C traffic, safe to call before the display is up.
 void frankenphone_init();
 
 // One-shot: start the Frankenphone scene (HOLD -> COOLDOWN)
@@ -11,6 +13,20 @@ void scene_frankenphone();
 // Tick this from loop() to advance the scene state machine
 void frankenphone_update();
 
+// Live timing (settings apply callbacks). Magnet window stays 5 s, capped by hold.
+void frankenphone_set_hold(uint32_t ms);
+void frankenphone_set_cooldown(uint32_t ms);
+
+// Warm restart: phase (0 idle, 1 hold, 2 cooldown) and ms spent in it,
+// and the inverse to pick the scene back up after a watchdog or button reset.
+uint8_t frankenphone_phase(uint32_t& elapsed_ms);
+void frankenphone_resume(uint8_t phase, uint32_t elapsed_ms);
+
+// Actuator state for telemetry. The buzzer counts as on while the modem
+// sound is playing (HOLD, unmuted, first 8 s).
+bool frankenphone_magnet_on();
+bool frankenphone_buzzer_on();
+
 // New: globally mute or unmute the Frankenphone modem sound
 // true  = mute immediately and keep muted
 // false = allow sound per current scene phase
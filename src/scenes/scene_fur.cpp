@@ -4,6 +4,6 @@
 #include "scene_common.hpp"
 
 void scene_fur() {
-  console_log("Scene: Fur Room");
+  console_log(F("Scene: Fur Room"));
   effects_furPulse();
 }
\ No newline at end of file
@@ -4,6 +4,6 @@
 #include "scene_common.hpp"
 
 void scene_graveyard() {
-  console_log("Scene: Graveyard");
+  console_log(F("Scene: Graveyard"));
   effects_mistyGraveyard();
 }
\ No newline at end of file
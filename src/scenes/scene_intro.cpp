@@ -4,6 +4,6 @@
 #include "scene_common.hpp"
 
 void scene_intro() {
-  console_log("Scene: Intro");
+  console_log(F("Scene: Intro"));
   effects_introFade();
 }
\ No newline at end of file
@@ -4,6 +4,6 @@
 #include "scene_common.hpp"
 
 void scene_mirror() {
-  console_log("Scene: Mirror Room");
+  console_log(F("Scene: Mirror Room"));
   effects_mirrorFlash();
 }
\ No newline at end of file
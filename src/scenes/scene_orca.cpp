@@ -4,6 +4,6 @@
 #include "scene_common.hpp"
 
 void scene_orca() {
-  console_log("Scene: Orca Whale");
+  console_log(F("Scene: Orca Whale"));
   effects_orcaSplash();
 }
\ No newline at end of file
@@ -4,6 +4,6 @@
 #include "scene_common.hpp"
 
 void scene_secret() {
-  console_log("Scene: Secret Room");
+  console_log(F("Scene: Secret Room"));
   effects_secretReveal();
 }
\ No newline at end of file
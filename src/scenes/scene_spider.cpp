@@ -4,6 +4,6 @@
 #include "scene_common.hpp"
 
 void scene_spider() {
-  console_log("Scene: Spider Lair");
+  console_log(F("Scene: Spider Lair"));
   effects_spiderWebFlash();
 }
\ No newline at end of file
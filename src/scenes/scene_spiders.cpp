@@ -4,6 +4,6 @@
 #include "scene_common.hpp"
 
 void scene_spiders() {
-  console_log("Scene: Spiders Lair");
+  console_log(F("Scene: Spiders Lair"));
   effects_spiderWebFlash();
 }
\ No newline at end of file
@@ -4,6 +4,6 @@
 #include "scene_common.hpp"
 
 void scene_standby() {
-  console_log("Scene: Standby");
+  console_log(F("Scene: Standby"));
   effects_showStandby();
 }
\ No newline at end of file
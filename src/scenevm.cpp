@@ -0,0 +1,489 @@
+// src/scenevm.cpp
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <avr/eeprom.h> // eeprom_is_ready
+#include "scenevm.hpp"
+#include "eeprom_map.hpp"
+#include "console.hpp"
+#include "display.hpp"
+#include "effects.hpp"
+#include "eventlog.hpp"
+#include "inputs.hpp"
+#include "outputs.hpp"
+#include "pilink.hpp"
+#include "prof.hpp"
+#include "triggers.hpp"
+
+#ifdef HH_SVM_FLASH
+#include "svm_image.h"   // const uint8_t SVM_IMAGE[] PROGMEM, from hh_scenec.py --header
+static const uint8_t* const g_flash = SVM_IMAGE;
+#else
+static const uint8_t* const g_flash = nullptr;
+#endif
+
+static const char    OWNER[] PROGMEM = "SVM";
+static const uint8_t OWNER_PRIO = 9;      // above BLOOD 8, below FRANK 10
+static const uint8_t LOG_CODE   = 0x80;   // EV_SCENE id = 0x80 + program
+
+static const uint8_t  IMG_VER  = 2;
+static const uint8_t  HDR      = 8;
+static const uint8_t  DIR_ENT  = 8;
+static const uint8_t  CH_NAME  = 8;       // output channel name in the image, space padded
+static const uint8_t  NO_BEAM  = 0xFF;
+static const uint8_t  CHUNK    = 32;      // bytes per SVM W
+
+// Instruction length by opcode, 0 = PISTART (length byte follows)
+static const uint8_t OP_LEN[SVM_NOPS] PROGMEM = {
+  1, 3, 3, 4, 4, 4, 6, 5, 2, 0, 4, 4, 3, 3, 3, 2, 3, 2
+};
+
+enum : uint8_t { SRC_NONE = 0, SRC_EE, SRC_FLASH };
+enum : uint8_t { W_NONE = 0, W_TIME, W_BEAM };
+
+// Image in use
+static uint8_t  g_src   = SRC_NONE;
+static uint8_t  g_nprog = 0;
+static uint16_t g_code  = 0;   // image offset of the code
+static uint16_t g_len   = 0;   // code bytes
+static uint8_t  g_nchan = 0;   // image channel table -> outputs channel
+static int8_t   g_chmap[OUTPUTS_MAX];
+static char     g_badch[CH_NAME + 1];   // name that rejected the last image, "" if none
+
+// Running program
+static int8_t   g_prog  = -1;
+static uint16_t g_pc    = 0;
+static uint32_t g_wake  = 0;   // time cursor, WAIT adds to it
+static uint8_t  g_wait  = W_NONE;
+static uint8_t  g_bmask = 0, g_bprev = 0;
+static bool     g_bforever = false;
+static bool     g_flag  = false;
+static uint8_t  g_count = 0;
+static bool     g_fault = false;
+
+// Background RGB fade
+static bool     g_fading = false;
+static uint8_t  g_from[3], g_to[3];
+static uint32_t g_fade_t0 = 0;
+static uint16_t g_fade_ms = 0;
+
+// Loader: one staged chunk, written one byte per pass while the EEPROM is idle
+static bool     g_loading = false;
+static uint16_t g_ld_len  = 0;
+static uint8_t  g_magic[2];
+static uint8_t  g_wbuf[CHUNK];
+static uint16_t g_waddr = 0;
+static uint8_t  g_wn = 0, g_widx = 0;
+
+static uint32_t g_runs = 0, g_steps = 0, g_yields = 0, g_faults = 0;
+static uint16_t g_fault_pc = 0;
+
+// ---------- Image access ----------
+static uint8_t rd(uint16_t a) {
+  return g_src == SRC_EE ? EEPROM.read(EE_SVM_BASE + a) : pgm_read_byte(g_flash + a);
+}
+static uint16_t rd16(uint16_t a) { return (uint16_t)rd(a) | ((uint16_t)rd(a + 1) << 8); }
+
+static uint16_t dir(uint8_t p) { return HDR + (uint16_t)p * DIR_ENT; }
+
+// The channel table follows the directory, the code follows the table
+static uint16_t code_at(uint8_t nprog) { return dir(nprog) + 1 + (uint16_t)rd(dir(nprog)) * CH_NAME; }
+
+static uint8_t op_len(uint16_t pc) {
+  const uint8_t op = rd(g_code + pc);
+  if (op >= SVM_NOPS) return 0;
+  const uint8_t n = pgm_read_byte(&OP_LEN[op]);
+  if (n) return n;
+  const uint8_t k = pc + 1 < g_len ? rd(g_code + pc + 1) : 0;
+  return (k >= 1 && k <= PILINK_MAX_PAYLOAD) ? 2 + k : 0;
+}
+
+static inline bool is_jump(uint8_t op) { return op == SVM_JMP || op == SVM_JT || op == SVM_JF || op == SVM_DJNZ; }
+static inline bool is_chan(uint8_t op) { return op == SVM_OUT || op == SVM_PULSE || op == SVM_HOLD; }
+
+// Every instruction decodes, every jump and entry lands on an instruction
+// start, every channel operand is in the table, and the last one does not
+// fall through. Two passes, so the
+// instruction-start bitmap is the only buffer.
+static bool verify() {
+  uint8_t starts[EE_SVM_BYTES / 8];
+  memset(starts, 0, sizeof(starts));
+  uint16_t pc = 0;
+  uint8_t last = SVM_END;
+  while (pc < g_len) {
+    const uint8_t n = op_len(pc);
+    if (!n || pc + n > g_len) return false;
+    starts[pc >> 3] |= 1 << (pc & 7);
+    last = rd(g_code + pc);
+    pc += n;
+  }
+  if (g_len == 0 || (last != SVM_END && last != SVM_JMP)) return false;
+
+  auto ok = [&](uint16_t t) { return t < g_len && (starts[t >> 3] & (1 << (t & 7))); };
+  for (pc = 0; pc < g_len; pc += op_len(pc)) {
+    const uint8_t op = rd(g_code + pc);
+    if (is_jump(op) && !ok(rd16(g_code + pc + 1))) return false;
+    if (is_chan(op) && rd(g_code + pc + 1) >= g_nchan) return false;
+  }
+  for (uint8_t p = 0; p < g_nprog; p++) if (!ok(rd16(dir(p) + 6))) return false;
+  return true;
+}
+
+static uint16_t image_crc(uint16_t from, uint16_t to) {
+  uint16_t c = 0xFFFF;
+  for (uint16_t a = from; a < to; a++) {
+    c ^= rd(a);
+    for (uint8_t b = 0; b < 8; b++) c = (c & 1) ? (c >> 1) ^ 0xA001 : (c >> 1);
+  }
+  return c;
+}
+
+// Channel names in the image -> live outputs channels, so an image does not
+// depend on the order outputs_add() ran in. An unknown name rejects it.
+static bool resolve_channels(uint16_t table) {
+  g_nchan = rd(table);
+  if (g_nchan > OUTPUTS_MAX) return false;
+  for (uint8_t c = 0; c < g_nchan; c++) {
+    char name[CH_NAME + 1];
+    uint8_t len = 0;
+    for (uint8_t i = 0; i < CH_NAME; i++) {
+      name[i] = (char)rd(table + 1 + c * CH_NAME + i);
+      if (name[i] != ' ') len = i + 1;           // names are space padded on the right
+    }
+    name[len] = '\0';
+    g_chmap[c] = outputs_find(name);
+    if (g_chmap[c] < 0) { strcpy(g_badch, name); return false; }
+  }
+  return true;
+}
+
+static bool open_image(uint8_t src) {
+  g_src = src;
+  g_nprog = 0;
+  g_nchan = 0;
+  g_badch[0] = '\0';
+  if (src == SRC_NONE || (src == SRC_FLASH && !g_flash)) { g_src = SRC_NONE; return false; }
+  const uint8_t n = rd(3);
+  if (rd(0) != 'S' || rd(1) != 'V' || rd(2) != IMG_VER || n == 0 || n > SVM_MAX_PROGS) { g_src = SRC_NONE; return false; }
+  g_code = code_at(n);
+  g_len  = rd16(4);
+  if ((uint32_t)g_code + g_len > EE_SVM_BYTES || image_crc(HDR, g_code + g_len) != rd16(6)) { g_src = SRC_NONE; return false; }
+  g_nprog = n;
+  if (!resolve_channels(dir(n)) || !verify()) { g_nprog = g_nchan = 0; g_src = SRC_NONE; return false; }
+  return true;
+}
+
+// ---------- Execution ----------
+static void name_of(uint8_t p, char out[5]) {
+  for (uint8_t i = 0; i < 4; i++) out[i] = (char)rd(dir(p) + i);
+  out[4] = '\0';
+}
+
+static void finish(bool fault) {
+  if (g_prog < 0) return;
+  char name[5];
+  name_of(g_prog, name);
+  if (fault) {
+    g_faults++;
+    g_fault_pc = g_pc;
+    console_log(F("SVM fault in "), name);
+  } else {
+    console_log(F("SVM end "), name);
+  }
+  evlog_add(EV_SCENE, LOG_CODE + g_prog, EVP_END);
+  display_release(OWNER);
+  g_prog = -1;
+  g_wait = W_NONE;
+}
+
+static uint8_t fetch() {
+  if (g_pc < g_len) return rd(g_code + g_pc++);
+  g_fault = true;   // ran off the code: END, reported as a fault
+  return SVM_END;
+}
+static uint16_t fetch16() { const uint8_t lo = fetch(); return lo | ((uint16_t)fetch() << 8); }
+
+static void fade_step(uint32_t now) {
+  const uint32_t t = now - g_fade_t0;
+  uint8_t c[3];
+  for (uint8_t i = 0; i < 3; i++) {
+    c[i] = t >= g_fade_ms ? g_to[i]
+         : (uint8_t)(g_from[i] + ((int32_t)g_to[i] - g_from[i]) * (int32_t)t / g_fade_ms);
+  }
+  effects_setRGB(c[0], c[1], c[2]);
+  if (t >= g_fade_ms) g_fading = false;
+}
+
+// One instruction. False when the program waits, ends or faults.
+static bool step(uint32_t now) {
+  g_steps++;
+  const uint8_t op = fetch();
+  switch (op) {
+    case SVM_END:
+      finish(g_fault);
+      return false;
+
+    case SVM_WAIT:
+      g_wake += fetch16();
+      if ((int32_t)(now - g_wake) >= 0) return true;
+      g_wait = W_TIME;
+      return false;
+
+    case SVM_OUT: {
+      const uint8_t ch = fetch();
+      if (fetch()) outputs_on(g_chmap[ch]); else outputs_off(g_chmap[ch]);
+      return true;
+    }
+    case SVM_PULSE: { const uint8_t ch = fetch(); outputs_pulse(g_chmap[ch], fetch16());   return true; }
+    case SVM_HOLD:  { const uint8_t ch = fetch(); outputs_hold_for(g_chmap[ch], fetch16()); return true; }
+
+    case SVM_RGB: {
+      const uint8_t r = fetch(), g = fetch(), b = fetch();
+      g_fading = false;
+      effects_setRGB(r, g, b);
+      return true;
+    }
+    case SVM_FADE:
+      effects_getRGB(g_from[0], g_from[1], g_from[2]);
+      for (uint8_t i = 0; i < 3; i++) g_to[i] = fetch();
+      g_fade_ms = fetch16();
+      g_fade_t0 = now;
+      g_fading  = g_fade_ms != 0;
+      if (!g_fading) effects_setRGB(g_to[0], g_to[1], g_to[2]);
+      return true;
+
+    case SVM_DISP: {
+      char s[5];
+      for (uint8_t i = 0; i < 4; i++) s[i] = (char)fetch();
+      s[4] = '\0';
+      if (display_acquire(OWNER, OWNER_PRIO)) display_print4_owned(OWNER, s);
+      return true;
+    }
+    case SVM_PICUE: pilink_cue(fetch()); return true;
+    case SVM_PISTART: {
+      char s[PILINK_MAX_PAYLOAD + 1];
+      const uint8_t n = fetch();
+      for (uint8_t i = 0; i < n; i++) s[i] = (char)fetch();
+      s[n] = '\0';
+      pilink_start(s);
+      return true;
+    }
+    case SVM_TRIG: { const uint8_t i = fetch(); triggers_pulse(i, fetch16()); return true; }
+
+    case SVM_WAITBEAM: {
+      g_bmask = fetch();
+      const uint16_t ms = fetch16();
+      g_bforever = ms == 0;
+      g_wake  = now + ms;
+      g_bprev = inputs_beam_mask();
+      g_wait  = W_BEAM;
+      return false;
+    }
+
+    case SVM_JMP:  g_pc = fetch16(); return true;
+    case SVM_JT:   { const uint16_t a = fetch16(); if (g_flag)  g_pc = a; return true; }
+    case SVM_JF:   { const uint16_t a = fetch16(); if (!g_flag) g_pc = a; return true; }
+    case SVM_REPEAT: g_count = fetch(); return true;
+    case SVM_DJNZ: { const uint16_t a = fetch16(); if (g_count && --g_count) g_pc = a; return true; }
+    case SVM_LOG:  evlog_add(EV_MARK, fetch()); return true;
+
+    default:
+      g_fault = true;
+      finish(true);
+      return false;
+  }
+}
+
+static void store_step() {
+  if (g_widx >= g_wn || !eeprom_is_ready()) return;
+  EEPROM.update(g_waddr + g_widx, g_wbuf[g_widx]);   // starts the write, returns at once
+  g_widx++;
+}
+
+void svm_update() {
+  store_step();
+  const uint32_t now = millis();
+  if (g_fading) fade_step(now);
+  if (g_prog < 0) return;
+
+  if (g_wait == W_TIME) {
+    if ((int32_t)(now - g_wake) < 0) return;
+  } else if (g_wait == W_BEAM) {
+    const uint8_t m = inputs_beam_mask();
+    const bool hit = m & ~g_bprev & g_bmask;   // a new break, not one already standing
+    g_bprev = m;
+    if (!hit && (g_bforever || (int32_t)(now - g_wake) < 0)) return;
+    g_flag = hit;
+    g_wake = now;                               // later WAITs count from here
+  }
+  g_wait = W_NONE;
+
+  PROF_BEGIN(PROF_SVM);
+  uint8_t n = 0;
+  while (n < HH_SVM_BUDGET && step(now) && !g_fault) n++;
+  if (g_fault) finish(true);
+  if (n == HH_SVM_BUDGET) g_yields++;   // budget spent, carry on next pass
+  PROF_END(PROF_SVM);
+}
+
+// ---------- API ----------
+void svm_begin() {
+  if (open_image(SRC_EE)) return;
+  char bad[CH_NAME + 1];
+  strcpy(bad, g_badch);
+  if (bad[0]) console_log(F("SVM EEPROM image names unknown channel "), bad);
+  if (open_image(SRC_FLASH)) return;
+  if (g_badch[0]) console_log(F("SVM flash image names unknown channel "), g_badch);
+  else            strcpy(g_badch, bad);   // SVM shows why the EEPROM image is not running
+}
+
+const char* svm_bad_channel() { return g_badch; }
+
+bool svm_run(uint8_t prog) {
+  if (prog >= g_nprog) return false;
+  svm_stop();
+  g_prog  = prog;
+  g_pc    = rd16(dir(prog) + 6);
+  g_wake  = millis();
+  g_wait  = W_NONE;
+  g_flag  = false;
+  g_count = 0;
+  g_fault = false;
+  g_runs++;
+  char name[5];
+  name_of(prog, name);
+  console_log(F("SVM run "), name);
+  evlog_add(EV_SCENE, LOG_CODE + prog, EVP_START);
+  return true;
+}
+
+int8_t svm_find(const char* upname) {
+  if (isDigit(upname[0]) && !upname[1]) return upname[0] - '0' < g_nprog ? upname[0] - '0' : -1;
+  for (uint8_t p = 0; p < g_nprog; p++) {
+    char name[5];
+    name_of(p, name);
+    uint8_t len = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+      name[i] = toupper(name[i]);
+      if (name[i] != ' ') len = i + 1;
+    }
+    name[len] = '\0';
+    if (strcmp(name, upname) == 0) return p;
+  }
+  return -1;
+}
+
+void svm_stop() {
+  g_fading = false;
+  finish(false);
+}
+
+bool svm_running() { return g_prog >= 0; }
+
+bool svm_beam(uint8_t beam) {
+  for (uint8_t p = 0; p < g_nprog; p++) {
+    if (rd(dir(p) + 4) == beam) return svm_run(p);
+  }
+  return false;
+}
+
+// ---------- Loader ----------
+static void flush_store() {
+  while (g_widx < g_wn) store_step();
+}
+
+static void invalidate() {
+  flush_store();
+  g_wbuf[0] = 0xFF;   // no magic, no image
+  g_waddr = EE_SVM_BASE;
+  g_wn = 1;
+  g_widx = 0;
+}
+
+bool svm_load_begin(uint16_t len) {
+  if (len < HDR + DIR_ENT + 2 || len > EE_SVM_BYTES) return false;
+  svm_stop();
+  invalidate();
+  open_image(SRC_FLASH);   // the baked-in scenes keep running while the EEPROM is rewritten
+  g_loading = true;
+  g_ld_len  = len;
+  g_magic[0] = g_magic[1] = 0xFF;
+  return true;
+}
+
+bool svm_load_busy() { return g_widx < g_wn; }
+
+bool svm_load_write(uint16_t offset, const uint8_t* data, uint8_t n) {
+  if (!g_loading || svm_load_busy() || n == 0 || n > CHUNK || (uint32_t)offset + n > g_ld_len) return false;
+  while (n && offset < 2) { g_magic[offset++] = *data++; n--; }   // the magic goes in last, at COMMIT
+  memcpy(g_wbuf, data, n);
+  g_waddr = EE_SVM_BASE + offset;
+  g_wn = n;
+  g_widx = 0;
+  return true;
+}
+
+bool svm_load_commit() {
+  if (!g_loading) return false;
+  svm_stop();              // a flash scene may be running; its pc means nothing in the new image
+  flush_store();
+  g_loading = false;
+  if (g_magic[0] != 'S' || g_magic[1] != 'V') return false;
+
+  // Magic last: a load cut short never leaves a valid-looking image
+  EEPROM.update(EE_SVM_BASE + 1, g_magic[1]);
+  EEPROM.update(EE_SVM_BASE, g_magic[0]);
+  g_src = SRC_EE;
+  if (rd(3) <= SVM_MAX_PROGS && code_at(rd(3)) + rd16(4) == g_ld_len && open_image(SRC_EE)) return true;
+  char bad[CH_NAME + 1];
+  strcpy(bad, g_badch);
+  EEPROM.update(EE_SVM_BASE, 0xFF);
+  open_image(SRC_FLASH);
+  strcpy(g_badch, bad);     // COMMIT reports why the upload failed, not the fallback
+  return false;
+}
+
+void svm_erase() {
+  svm_stop();
+  g_loading = false;
+  invalidate();
+  open_image(SRC_FLASH);
+}
+
+void svm_print(Stream& s) {
+  s.print(F("  image "));
+  s.print(g_src == SRC_EE ? F("EEPROM") : g_src == SRC_FLASH ? F("flash") : F("none"));
+  s.print(F("  programs ")); s.print(g_nprog);
+  s.print(F("  code ")); s.print(g_nprog ? g_len : 0); s.println(F(" bytes"));
+  for (uint8_t p = 0; p < g_nprog; p++) {
+    char name[5];
+    name_of(p, name);
+    const uint8_t beam = rd(dir(p) + 4);
+    s.print(F("  ")); s.print(p); s.print(' '); s.print(name);
+    if (beam != NO_BEAM) { s.print(F("  B")); s.print(beam); } else s.print(F("  --"));
+    s.print(F("  @")); s.println(rd16(dir(p) + 6));
+  }
+  if (g_nchan) {
+    s.print(F("  channels"));
+    for (uint8_t c = 0; c < g_nchan; c++) { s.print(' '); s.print(c); s.print('='); s.print(g_chmap[c]); }
+    s.println(F("  (image -> OUT)"));
+  }
+  if (g_badch[0]) { s.print(F("  last image rejected: unknown channel ")); s.println(g_badch); }
+  if (g_prog >= 0) {
+    char name[5];
+    name_of(g_prog, name);
+    s.print(F("  running ")); s.print(name);
+    s.print(F("  pc ")); s.print(g_pc);
+    if (g_wait == W_TIME) { s.print(F("  wait ")); s.print((int32_t)(g_wake - millis())); s.print(F(" ms")); }
+    if (g_wait == W_BEAM) { s.print(F("  beam wait mask 0x")); s.print(g_bmask, HEX); }
+    s.println();
+  } else {
+    s.println(F("  idle"));
+  }
+  s.print(F("  runs ")); s.print(g_runs);
+  s.print(F("  steps ")); s.print(g_steps);
+  s.print(F("  budget yields ")); s.print(g_yields);
+  s.print(F("  faults ")); s.print(g_faults);
+  if (g_faults) { s.print(F(" (pc ")); s.print(g_fault_pc); s.print(')'); }
+  s.println();
+  if (g_loading) { s.print(F("  loading ")); s.print(g_ld_len); s.println(F(" bytes")); }
+}
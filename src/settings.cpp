@@ -1,23 +1,114 @@
 #include "settings.hpp"
+#include "eeprom_map.hpp"
 #include <EEPROM.h>
+#include <avr/eeprom.h> // eeprom_is_ready
+#include <stddef.h> // offsetof
 #include <string.h> // memcpy
 
 // -------------------------------------------------------------------
-// EEPROM layout: [MAGIC(2)][EEP_VER(1)][HHSettings struct][CRC16(2)]
+// EEPROM layout: append-only journal of fixed-size slots rotated across
+// the settings area (eeprom_map.hpp). Each SAVE appends one record to the
+// next slot, so every cell sees 1/N_SLOTS of the writes. The newest valid record wins.
+//
+// Slot: [MARK(1)][SEQ(2)][LEN(1)][TLV x LEN bytes][CRC16(2)]
+//   TLV entry: [TAG(1)][SIZE(1)][value, little endian]
+//   CRC16 covers SEQ..TLV. A torn write fails CRC and the previous slot
+//   stays authoritative.
+//
+// Fields still at their default are left out of the record, and
+// missing tags load as the default, so a slot only holds what was tuned.
+// Fields are matched by tag, never by position. Unknown tags are skipped,
+// missing tags keep their default, and integers are widened or clamped
+// when a field changes size, so a firmware update keeps tuned values.
+//
+// Slots are 96 bytes so a record with every field tuned (64 bytes of TLV
+// today) fits with room for new tags; a SAVE that still does not fit is
+// refused rather than written short.
+//
+// Older layouts are imported once if no TLV record is found:
+//   64-byte TLV slots:   [0xA6][SEQ(2)][LEN][TLV][CRC16(2)], at most 58 B of TLV
+//   v0.4.2 journal slot: [0xA5][SEQ(2)][VER=2][LEN=27][struct][CRC16(2)]
+//   v0.4.1 blob at 0:    [MAGIC(2)][VER=2][struct][CRC16(2)]
 // -------------------------------------------------------------------
 static const uint16_t MAGIC       = 0x4848; // 'HH'
-static const uint8_t  EEP_VERSION = 2;      // bump when HHSettings changes
+static const uint8_t  EEP_VERSION = 4;      // record format; new fields only need a new tag
 static const uint8_t  FW_VERSION  = 1;      // bump when firmware changes meaningfully
 
+static const uint8_t  REC_MARK    = 0xA7;
+static const uint16_t SLOT_SIZE   = 96;
+static const uint16_t JOURNAL_BASE  = EE_SETTINGS_BASE;
+static const uint16_t JOURNAL_BYTES = EE_SETTINGS_BYTES;
+static const uint8_t  N_SLOTS     = JOURNAL_BYTES / SLOT_SIZE;
+static const uint8_t  REC_HDR     = 4;      // MARK, SEQ(2), LEN
+static const uint8_t  TLV_MAX     = SLOT_SIZE - REC_HDR - 2;
+
+// Field table: tag -> place in HHSettings
+enum FieldKind : uint8_t { FK_UINT = 0, FK_BYTES };
+struct Field { uint8_t tag; uint8_t kind; uint8_t offset; uint8_t size; };
+static const Field FIELDS[] = {
+  { SET_TAG_HOLD_MS,     FK_UINT,  offsetof(HHSettings, hold_ms),     sizeof(uint32_t) },
+  { SET_TAG_COOLDOWN_MS, FK_UINT,  offsetof(HHSettings, cooldown_ms), sizeof(uint32_t) },
+  { SET_TAG_DEBOUNCE_MS, FK_UINT,  offsetof(HHSettings, debounce_ms), sizeof(uint16_t) },
+  { SET_TAG_REARM_MS,    FK_UINT,  offsetof(HHSettings, rearm_ms),    sizeof(uint32_t) },
+  { SET_TAG_BRIGHTNESS,  FK_UINT,  offsetof(HHSettings, brightness),  sizeof(uint8_t)  },
+  { SET_TAG_BEAM_PINS,   FK_BYTES, offsetof(HHSettings, beam_pins),   6 },
+  { SET_TAG_BEAM_SCENE,  FK_BYTES, offsetof(HHSettings, beam_scene),  6 },
+  { SET_TAG_DEBOUNCE_MIN_MS, FK_UINT, offsetof(HHSettings, debounce_min_ms), sizeof(uint16_t) },
+  { SET_TAG_BEAM_INSTANT,    FK_UINT, offsetof(HHSettings, beam_instant),    sizeof(uint8_t)  },
+  { SET_TAG_MIN_PULSE_US,    FK_UINT, offsetof(HHSettings, min_pulse_us),    sizeof(uint16_t) },
+  { SET_TAG_BEAM_REARM,      FK_BYTES, offsetof(HHSettings, beam_rearm),     6 },
+  { SET_TAG_REARM_CLEAR_MS,  FK_UINT, offsetof(HHSettings, rearm_clear_ms),  sizeof(uint16_t) },
+};
+static const uint8_t N_FIELDS = sizeof(FIELDS) / sizeof(FIELDS[0]);
+
+// Frozen pre-TLV struct, only for the one-time import
+struct LegacyV2 {
+  uint32_t hold_ms;
+  uint32_t cooldown_ms;
+  uint16_t debounce_ms;
+  uint32_t rearm_ms;
+  uint8_t  brightness;
+  uint8_t  beam_pins[6];
+  uint8_t  beam_scene[6];
+} __attribute__((packed));
+static const uint8_t LEGACY_VER = 2;
+static const uint8_t OLD_SLOT   = 64;                  // slot size of the older journals
+static const uint8_t LEGACY_SLOTS = 4096 / OLD_SLOT;   // v0.4.2 journal spanned the whole EEPROM
+static const uint8_t OLD_MARK   = 0xA6;                // 64-byte TLV slots
+static const uint8_t OLD_SLOTS  = JOURNAL_BYTES / OLD_SLOT;
+
 // In-RAM copy
 static HHSettings G;
 
+// Last persisted copy, so SAVE with no change costs nothing
+static HHSettings G_saved;
+
+// Journal position
+static uint8_t  g_head = 0;     // next slot to write
+static uint16_t g_seq  = 0;     // seq of the newest record
+static int16_t  g_live = -1;    // slot holding the newest valid record
+
+static bool     g_scanned = false;
+static bool     g_refused = false;  // last SAVE did not fit a slot and was not written
+
+// Background writer: one byte per settings_update() while the EEPROM is idle
+static uint8_t  g_wbuf[SLOT_SIZE];
+static uint8_t  g_wlen  = 0;
+static uint16_t g_waddr = 0;
+static uint8_t  g_widx  = 0;
+static bool     g_writing = false;
+
 // "Apply" callbacks provided by main.cpp
 static ApplyU32 cbHold   = nullptr;
 static ApplyU32 cbCool   = nullptr;
 static ApplyU16 cbDeb    = nullptr;
 static ApplyU32 cbRearm  = nullptr;
 static ApplyU8  cbBright = nullptr;
+static ApplyU16 cbDebMin = nullptr;
+static ApplyU8  cbInstant = nullptr;
+static ApplyU16 cbPulse  = nullptr;
+static ApplyBeams cbRearmPol = nullptr;
+static ApplyU16 cbRearmClr = nullptr;
 
 // ---------------- CRC16 (Modbus-ish) ----------------
 static uint16_t crc16(const uint8_t* d, size_t n){
@@ -38,13 +129,23 @@ static void applyAll(){
   if (cbDeb)    cbDeb(G.debounce_ms);
   if (cbRearm)  cbRearm(G.rearm_ms);
   if (cbBright) cbBright(G.brightness);
+  if (cbDebMin) cbDebMin(G.debounce_min_ms);
+  if (cbInstant) cbInstant(G.beam_instant);
+  if (cbPulse)  cbPulse(G.min_pulse_us);
+  if (cbRearmPol) cbRearmPol(G.beam_rearm);
+  if (cbRearmClr) cbRearmClr(G.rearm_clear_ms);
 }
 
 // Defaults (single source of truth)
 static void loadDefaults(HHSettings& S){
-  S.hold_ms     = 5000;
+  S.hold_ms     = 8000;
   S.cooldown_ms = 20000;
   S.debounce_ms = 30;
+  S.debounce_min_ms = 3;
+  S.beam_instant    = 0;      // all beams debounce before firing
+  S.min_pulse_us    = 1000;
+  memset(S.beam_rearm, 0xF1, sizeof(S.beam_rearm));   // REARM_DEFAULT: time only, no downstream beam
+  S.rearm_clear_ms  = 3000;
   S.rearm_ms    = 20000;
   S.brightness  = 8;
 
@@ -66,13 +167,23 @@ void settings_begin(ApplyU32 applyHold,
                     ApplyU32 applyCooldown,
                     ApplyU16 applyDebounce,
                     ApplyU32 applyRearm,
-                    ApplyU8  applyBrightness)
+                    ApplyU8  applyBrightness,
+                    ApplyU16 applyDebounceMin,
+                    ApplyU8  applyInstant,
+                    ApplyU16 applyMinPulse,
+                    ApplyBeams applyRearmPolicy,
+                    ApplyU16 applyRearmClear)
 {
   cbHold   = applyHold;
   cbCool   = applyCooldown;
   cbDeb    = applyDebounce;
   cbRearm  = applyRearm;
   cbBright = applyBrightness;
+  cbDebMin = applyDebounceMin;
+  cbInstant = applyInstant;
+  cbPulse  = applyMinPulse;
+  cbRearmPol = applyRearmPolicy;
+  cbRearmClr = applyRearmClear;
 
   // Defaults first
   loadDefaults(G);
@@ -83,38 +194,283 @@ void settings_begin(ApplyU32 applyHold,
   }
 }
 
-void settings_save(){
-  const int base = 0;
-  int addr = base;
+// ---------------- Journal ----------------
+static uint16_t slot_addr(uint8_t slot){ return JOURNAL_BASE + (uint16_t)slot * SLOT_SIZE; }
 
-  EEPROM.put(addr, MAGIC);       addr += sizeof(MAGIC);
-  EEPROM.put(addr, EEP_VERSION); addr += sizeof(EEP_VERSION);
-  EEPROM.put(addr, G);           addr += sizeof(G);
+static uint16_t ee_u16(uint16_t addr){
+  return (uint16_t)EEPROM.read(addr) | ((uint16_t)EEPROM.read(addr + 1) << 8);
+}
 
-  const uint16_t c = crc16(reinterpret_cast<const uint8_t*>(&G), sizeof(G));
-  EEPROM.put(addr, c);
+// CRC straight from EEPROM, no slot-sized buffer on the stack
+static uint16_t ee_crc16(uint16_t addr, uint8_t n){
+  uint16_t c = 0xFFFF;
+  for (uint8_t i = 0; i < n; i++){
+    c ^= EEPROM.read(addr + i);
+    for (uint8_t b = 0; b < 8; b++) c = (c & 1) ? (c >> 1) ^ 0xA001 : (c >> 1);
+  }
+  return c;
 }
 
-bool settings_load(){
-  const int base = 0;
-  int addr = base;
+static bool slot_valid(uint8_t slot){
+  const uint16_t base = slot_addr(slot);
+  const uint8_t len = EEPROM.read(base + 3);
+  if (len > TLV_MAX) return false;
+  return ee_crc16(base + 1, 3 + len) == ee_u16(base + REC_HDR + len);
+}
+
+// Find the newest record by header only (3 bytes per slot), then CRC just
+// that one; fall back to the next newest if it is torn.
+static void journal_scan(){
+  uint64_t rejected = 0;
+  g_live = -1;
+  for (;;){
+    int16_t  cand = -1;
+    uint16_t best = 0;
+    for (uint8_t i = 0; i < N_SLOTS; i++){
+      if ((rejected >> i) & 1) continue;
+      if (EEPROM.read(slot_addr(i)) != REC_MARK) continue;
+      const uint16_t seq = ee_u16(slot_addr(i) + 1);
+      if (cand < 0 || (int16_t)(seq - best) > 0){ best = seq; cand = i; }
+    }
+    if (cand < 0) break;
+    if (slot_valid((uint8_t)cand)){ g_live = cand; g_seq = best; break; }
+    rejected |= (uint64_t)1 << cand;
+  }
+  if (g_live < 0) g_seq = 0;
+  g_head = (g_live < 0) ? 0 : (uint8_t)((g_live + 1) % N_SLOTS);
+  g_scanned = true;
+}
+
+static const Field* field_for(uint8_t tag){
+  for (uint8_t i = 0; i < N_FIELDS; i++) if (FIELDS[i].tag == tag) return &FIELDS[i];
+  return nullptr;
+}
+
+// Store a TLV value into its field, tolerating a size change
+static void field_put(HHSettings& S, const Field& f, const uint8_t* v, uint8_t len){
+  uint8_t* dst = reinterpret_cast<uint8_t*>(&S) + f.offset;
+  if (f.kind == FK_BYTES){
+    memcpy(dst, v, len < f.size ? len : f.size);  // shorter: the tail keeps its default
+    return;
+  }
+  bool over = false;
+  memset(dst, 0, f.size);
+  for (uint8_t i = 0; i < len; i++){
+    if (i < f.size) dst[i] = v[i];
+    else if (v[i])  over = true;                  // narrowed field: clamp to max
+  }
+  if (over) memset(dst, 0xFF, f.size);
+}
+
+// Walk the TLV list of the record at base. cb returns true to stop early.
+template <typename CB>
+static void tlv_walk(uint16_t base, CB cb){
+  const uint8_t len = EEPROM.read(base + 3);
+  uint16_t a = base + REC_HDR;
+  const uint16_t end = a + len;
+  while (a + 2 <= end){
+    const uint8_t tag = EEPROM.read(a);
+    const uint8_t sz  = EEPROM.read(a + 1);
+    if (a + 2 + sz > end) break;
+    if (cb(tag, sz, (uint16_t)(a + 2))) return;
+    a += 2 + sz;
+  }
+}
+
+// Fields of the TLV record at base into S; unknown tags (newer firmware) are skipped
+static void load_tlv(uint16_t base, HHSettings& S){
+  tlv_walk(base, [&](uint8_t tag, uint8_t sz, uint16_t addr){
+    const Field* f = field_for(tag);
+    if (!f) return false;
+    uint8_t v[SLOT_SIZE];
+    for (uint8_t i = 0; i < sz; i++) v[i] = EEPROM.read(addr + i);
+    field_put(S, *f, v, sz);
+    return false;
+  });
+}
+
+// Newest valid record of the 64-byte TLV journal, its address or -1
+static int16_t find_old_tlv(){
+  int16_t  cand = -1;
+  uint16_t best = 0;
+  for (uint8_t i = 0; i < OLD_SLOTS; i++){
+    const uint16_t base = JOURNAL_BASE + (uint16_t)i * OLD_SLOT;
+    if (EEPROM.read(base) != OLD_MARK) continue;
+    const uint8_t len = EEPROM.read(base + 3);
+    if (len > OLD_SLOT - REC_HDR - 2 || ee_crc16(base + 1, 3 + len) != ee_u16(base + REC_HDR + len)) continue;
+    const uint16_t seq = ee_u16(base + 1);
+    if (cand < 0 || (int16_t)(seq - best) > 0){ best = seq; cand = (int16_t)base; }
+  }
+  return cand;
+}
+
+static bool import_legacy(HHSettings& S, const LegacyV2& L){
+  S.hold_ms     = L.hold_ms;
+  S.cooldown_ms = L.cooldown_ms;
+  S.debounce_ms = L.debounce_ms;
+  S.rearm_ms    = L.rearm_ms;
+  S.brightness  = L.brightness;
+  memcpy(S.beam_pins,  L.beam_pins,  sizeof(S.beam_pins));
+  memcpy(S.beam_scene, L.beam_scene, sizeof(S.beam_scene));
+  return true;
+}
 
-  uint16_t mg=0; uint8_t ver=0; HHSettings tmp; uint16_t c=0;
+static bool load_legacy(HHSettings& S){
+  LegacyV2 L;
+
+  // v0.4.2 journal: newest valid 0xA5 slot
+  int16_t  cand = -1;
+  uint16_t best = 0;
+  const uint8_t rec_len = 5 + sizeof(LegacyV2) + 2;
+  for (uint8_t i = 0; i < LEGACY_SLOTS; i++){
+    const uint16_t base = (uint16_t)i * OLD_SLOT;
+    if (EEPROM.read(base) != 0xA5 || EEPROM.read(base + 3) != LEGACY_VER) continue;
+    if (EEPROM.read(base + 4) != sizeof(LegacyV2)) continue;
+    if (ee_crc16(base + 1, rec_len - 3) != ee_u16(base + rec_len - 2)) continue;
+    const uint16_t seq = ee_u16(base + 1);
+    if (cand < 0 || (int16_t)(seq - best) > 0){ best = seq; cand = i; }
+  }
+  if (cand >= 0){
+    EEPROM.get((uint16_t)cand * OLD_SLOT + 5, L);
+    return import_legacy(S, L);
+  }
+
+  // v0.4.1 single blob at address 0
+  int addr = 0;
+  uint16_t mg=0; uint8_t ver=0; uint16_t c=0;
   EEPROM.get(addr, mg);   addr += sizeof(mg);
   EEPROM.get(addr, ver);  addr += sizeof(ver);
-  EEPROM.get(addr, tmp);  addr += sizeof(tmp);
+  EEPROM.get(addr, L);    addr += sizeof(L);
   EEPROM.get(addr, c);
+  if (mg != MAGIC || ver != LEGACY_VER) return false;
+  if (crc16(reinterpret_cast<const uint8_t*>(&L), sizeof(L)) != c) return false;
+  return import_legacy(S, L);
+}
 
-  if (mg != MAGIC || ver != EEP_VERSION) return false;
+static void writer_flush(){
+  while (g_writing) settings_update();
+}
 
-  const uint16_t expect = crc16(reinterpret_cast<const uint8_t*>(&tmp), sizeof(tmp));
-  if (expect != c) return false;
+void settings_update(){
+  if (!g_writing || !eeprom_is_ready()) return;
+  EEPROM.update(g_waddr + g_widx, g_wbuf[g_widx]); // starts the write, returns at once
+  if (++g_widx >= g_wlen){
+    g_writing = false;
+    g_live = (int16_t)((g_waddr - JOURNAL_BASE) / SLOT_SIZE);
+  }
+}
 
-  G = tmp;
-  applyAll();
+bool settings_save(){
+  if (g_writing) writer_flush();                 // back-to-back SAVE: finish the first
+  if (!g_scanned) journal_scan();
+  if (g_live >= 0 && memcmp(&G, &G_saved, sizeof(G)) == 0) return true;
+
+  HHSettings def;
+  loadDefaults(def);
+  uint8_t n = REC_HDR;
+  const uint8_t* src = reinterpret_cast<const uint8_t*>(&G);
+  const uint8_t* dflt = reinterpret_cast<const uint8_t*>(&def);
+  g_refused = false;
+  for (uint8_t i = 0; i < N_FIELDS; i++){
+    const Field& f = FIELDS[i];
+    if (memcmp(src + f.offset, dflt + f.offset, f.size) == 0) continue;  // loads as default
+    if (n + 2 + f.size > REC_HDR + TLV_MAX){                              // slot full: write nothing
+      g_refused = true;
+      return false;
+    }
+    g_wbuf[n++] = f.tag;
+    g_wbuf[n++] = f.size;
+    memcpy(g_wbuf + n, src + f.offset, f.size);
+    n += f.size;
+  }
+
+  g_seq++;
+  g_wbuf[0] = REC_MARK;
+  g_wbuf[1] = (uint8_t)(g_seq & 0xFF);
+  g_wbuf[2] = (uint8_t)(g_seq >> 8);
+  g_wbuf[3] = (uint8_t)(n - REC_HDR);
+  const uint16_t c = crc16(g_wbuf + 1, n - 1);
+  g_wbuf[n++] = (uint8_t)(c & 0xFF);
+  g_wbuf[n++] = (uint8_t)(c >> 8);
+
+  g_wlen    = n;
+  g_waddr   = slot_addr(g_head);
+  g_widx    = 0;
+  g_writing = true;
+  g_head    = (uint8_t)((g_head + 1) % N_SLOTS);
+  G_saved   = G;
   return true;
 }
 
+bool settings_save_pending(){ return g_writing; }
+
+uint8_t settings_peek(uint8_t tag, void* out, uint8_t size){
+  if (g_writing) writer_flush();
+  if (!g_scanned) journal_scan();
+
+  const Field* f = field_for(tag);
+  uint8_t got = 0;
+  if (g_live >= 0) tlv_walk(slot_addr((uint8_t)g_live), [&](uint8_t t, uint8_t sz, uint16_t addr){
+    if (t != tag) return false;
+    uint8_t v[SLOT_SIZE];
+    for (uint8_t i = 0; i < sz; i++) v[i] = EEPROM.read(addr + i);
+    if (f && f->size == size){
+      // Same widening/clamping rules as a full load
+      HHSettings tmp;
+      field_put(tmp, *f, v, sz);
+      memcpy(out, reinterpret_cast<uint8_t*>(&tmp) + f->offset, size);
+    } else {
+      memcpy(out, v, sz < size ? sz : size);
+    }
+    got = sz < size ? sz : size;
+    return true;
+  });
+  if (!got && f && f->size == size){             // not stored: it was at its default
+    HHSettings def;
+    loadDefaults(def);
+    memcpy(out, reinterpret_cast<uint8_t*>(&def) + f->offset, size);
+    got = size;
+  }
+  return got;
+}
+
+bool settings_load(){
+  writer_flush();
+  journal_scan();
+
+  HHSettings tmp;
+  loadDefaults(tmp);                             // missing tags keep defaults
+  if (g_live >= 0){
+    load_tlv(slot_addr((uint8_t)g_live), tmp);
+    G = tmp;
+    G_saved = tmp;
+    applyAll();
+    return true;
+  }
+
+  // First boot after a layout change: import, then journal it in the current
+  // format, in a slot clear of the record it came from until the new one lands.
+  const int16_t old = find_old_tlv();
+  if (old >= 0){
+    load_tlv((uint16_t)old, tmp);
+    G = tmp;
+    applyAll();
+    g_head = (uint8_t)(((uint16_t)old - JOURNAL_BASE) / SLOT_SIZE + 2) % N_SLOTS;
+    settings_save();
+    return true;
+  }
+
+  // Start at slot 1 so an address-0 blob survives until the new record lands.
+  if (load_legacy(tmp)){
+    G = tmp;
+    applyAll();
+    g_head = 1;
+    settings_save();
+    return true;
+  }
+  return false;
+}
+
 void settings_reset_defaults(bool save){
   loadDefaults(G);
   applyAll();
@@ -131,6 +487,15 @@ HHSettings& settings_ref(){ return G; }
 void settings_set_hold(uint32_t v){        G.hold_ms = v;        if (cbHold)   cbHold(v); }
 void settings_set_cool(uint32_t v){        G.cooldown_ms = v;    if (cbCool)   cbCool(v); }
 void settings_set_debounce(uint16_t v){    G.debounce_ms = v;    if (cbDeb)    cbDeb(v); }
+void settings_set_debounce_min(uint16_t v){ G.debounce_min_ms = v; if (cbDebMin) cbDebMin(v); }
+void settings_set_beam_instant(uint8_t m){ G.beam_instant = m & 0x3F; if (cbInstant) cbInstant(G.beam_instant); }
+void settings_set_min_pulse(uint16_t v){   G.min_pulse_us = v;   if (cbPulse)  cbPulse(v); }
+void settings_set_rearm_policy(uint8_t idx, uint8_t p){
+  if (idx >= 6) return;
+  G.beam_rearm[idx] = p;
+  if (cbRearmPol) cbRearmPol(G.beam_rearm);
+}
+void settings_set_rearm_clear(uint16_t v){ G.rearm_clear_ms = v; if (cbRearmClr) cbRearmClr(v); }
 void settings_set_rearm(uint32_t v){       G.rearm_ms = v;       if (cbRearm)  cbRearm(v); }
 void settings_set_brightness(uint8_t v){   if (v>15) v=15; G.brightness = v; if (cbBright) cbBright(v); }
 
@@ -148,8 +513,15 @@ void settings_print(Stream& s){
   s.print(F("HOLD_MS="));     s.println(G.hold_ms);
   s.print(F("COOLDOWN_MS=")); s.println(G.cooldown_ms);
   s.print(F("DEBOUNCE_MS=")); s.println(G.debounce_ms);
+  s.print(F("DEBOUNCE_MIN_MS=")); s.println(G.debounce_min_ms);
+  s.print(F("BEAM_INSTANT=0x")); s.println(G.beam_instant, HEX);
+  s.print(F("MIN_PULSE_US="));  s.println(G.min_pulse_us);
+  s.print(F("REARM_CLEAR_MS=")); s.println(G.rearm_clear_ms);
   s.print(F("REARM_MS="));    s.println(G.rearm_ms);
   s.print(F("BRIGHTNESS="));  s.println(G.brightness);
+  s.print(F("Journal: slot ")); s.print(g_live); s.print(F(" seq ")); s.print(g_seq);
+  s.print(F(" of ")); s.print(N_SLOTS); s.println(g_writing ? F(" slots (writing)") : F(" slots"));
+  if (g_refused) s.println(F("Journal: last SAVE refused, record larger than a slot"));
 
   s.println(F("Beam map: idx : pin -> sceneCode"));
   for (uint8_t i=0;i<6;i++){
@@ -158,7 +530,3 @@ void settings_print(Stream& s){
     s.println(G.beam_scene[i]);
   }
 }
-// Stub init if no callbacks needed yet
-void settings_init() {
-  settings_begin(nullptr, nullptr, nullptr, nullptr, nullptr);
-}
\ No newline at end of file
@@ -0,0 +1,191 @@
+// src/telemetry.cpp
+#include <Arduino.h>
+#include "telemetry.hpp"
+#include "effects.hpp"
+#include "inputs.hpp"
+#include "loopstats.hpp"
+#include "memstats.hpp"
+#include "scenes.hpp"
+#include "techlight.hpp"
+#include "scenes/scene_frankenphone.hpp"
+
+// Channels the GUI can subscribe to, each sampled at its own rate
+enum TelChan : uint8_t { TEL_SCENE = 0, TEL_BEAMS, TEL_OUT, TEL_RGB, TEL_LIGHT, TEL_LOOP, TEL_STUDIO, TEL_N };
+static const uint8_t TEL_FIELDS = 3;
+
+static const char    CH_NAMES[TEL_N][7]  PROGMEM = {"scene", "beams", "out", "rgb", "light", "loop", "studio"};
+static const uint8_t CH_NFIELD[TEL_N]    PROGMEM = {2, 1, 2, 3, 3, 3, 0};
+static const char    PHASES[3][9]        PROGMEM = {"IDLE", "HOLD", "COOLDOWN"};
+
+static const uint16_t MAX_HZ     = 100;
+static const uint16_t KEY_MS     = 5000;   // a change after this long sends every field again
+static const uint8_t  SCENE_NAME_MAX = 12; // "PhoneLoading", longest scene_name()
+
+static uint16_t g_period[TEL_N];           // ms between samples, 0 = not subscribed
+static uint32_t g_next[TEL_N];
+static uint32_t g_last_key[TEL_N];
+static bool     g_key[TEL_N];              // next frame sends every field
+static int32_t  g_last[TEL_N][TEL_FIELDS];
+static uint8_t  g_studio_last[8];
+static uint32_t g_frames[TEL_N];
+static uint32_t g_bytes   = 0;
+static uint32_t g_skipped = 0;             // frames deferred because the TX buffer was full
+
+static const __FlashStringHelper* ch_name(uint8_t c) {
+  return reinterpret_cast<const __FlashStringHelper*>(CH_NAMES[c]);
+}
+
+// Longest frame a channel can send: 10-digit millis, 11-char fields, and for
+// studio the longest scene and phase with 3-digit bytes. A frame is only
+// started with this much TX room, so it is never cut short or blocked on.
+static uint8_t frame_max(uint8_t c) {
+  if (c == TEL_STUDIO) return 2 + 10 + (1 + SCENE_NAME_MAX) + (1 + 8) + 6 * (1 + 3) + 2 + 2;
+  return 1 + 6 + 1 + 10 + 1 + 12 * pgm_read_byte(&CH_NFIELD[c]) - 1 + 2;
+}
+
+static void sample_scene(int32_t* v) {
+  uint32_t elapsed;
+  const uint8_t ph = frankenphone_phase(elapsed);   // 0 idle, 1 hold, 2 cooldown
+  if (ph)                        { v[0] = (int32_t)Scene::FrankenLab; v[1] = ph; }
+  else if (scene_blood_active()) { v[0] = (int32_t)Scene::BloodRoom;  v[1] = 1; }
+  else                           { v[0] = (int32_t)Scene::Standby;    v[1] = 0; }
+}
+
+static void sample(uint8_t c, int32_t* v) {
+  switch (c) {
+    case TEL_SCENE: sample_scene(v); break;
+    case TEL_BEAMS: v[0] = inputs_beam_mask(); break;
+    case TEL_OUT:   v[0] = frankenphone_magnet_on(); v[1] = frankenphone_buzzer_on(); break;
+    case TEL_RGB: {
+      uint8_t r, g, b;
+      effects_getRGB(r, g, b);
+      v[0] = r; v[1] = g; v[2] = b;
+    } break;
+    case TEL_LIGHT: {
+      int8_t mode; bool latch; uint32_t left;
+      techlight_warm_get(mode, latch, left);
+      v[0] = techlight_is_on(); v[1] = mode; v[2] = latch;
+    } break;
+    case TEL_LOOP: {
+      uint32_t max_us; uint16_t passes;
+      loopstats_window(max_us, passes);
+      v[0] = (int32_t)max_us; v[1] = passes; v[2] = mem_free_now();
+    } break;
+  }
+}
+
+// "~<chan> <ms> f0,f1,f2", a field equal to the last one sent is left empty
+static bool send_channel(uint8_t c, uint32_t now) {
+  int32_t v[TEL_FIELDS] = {0, 0, 0};
+  sample(c, v);
+  const uint8_t nf = pgm_read_byte(&CH_NFIELD[c]);
+
+  bool changed = false;
+  for (uint8_t i = 0; i < nf; i++) if (v[i] != g_last[c][i]) changed = true;
+  if (!changed && !g_key[c]) return false;
+  if (changed && now - g_last_key[c] >= KEY_MS) g_key[c] = true;
+
+  size_t n = Console.print('~');
+  n += Console.print(ch_name(c));
+  n += Console.print(' ');
+  n += Console.print(now);
+  n += Console.print(' ');
+  for (uint8_t i = 0; i < nf; i++) {
+    if (i) n += Console.print(',');
+    if (g_key[c] || v[i] != g_last[c][i]) n += Console.print(v[i]);
+    g_last[c][i] = v[i];
+  }
+  n += Console.println();
+
+  if (g_key[c]) { g_key[c] = false; g_last_key[c] = now; }
+  g_frames[c]++;
+  g_bytes += n;
+  return true;
+}
+
+// Serial Studio frame (HH::tel_emit) whenever scene, beams, outputs or RGB change
+static bool send_studio() {
+  int32_t sc[TEL_FIELDS], out[TEL_FIELDS];
+  sample_scene(sc);
+  sample(TEL_OUT, out);
+  uint8_t s[8];
+  s[0] = (uint8_t)sc[0]; s[1] = (uint8_t)sc[1];
+  s[2] = inputs_beam_mask();
+  s[3] = (uint8_t)out[0]; s[4] = (uint8_t)out[1];
+  effects_getRGB(s[5], s[6], s[7]);
+  if (!g_key[TEL_STUDIO] && memcmp(s, g_studio_last, sizeof(s)) == 0) return false;
+
+  const __FlashStringHelper* phase = reinterpret_cast<const __FlashStringHelper*>(PHASES[s[1] < 3 ? s[1] : 0]);
+  const size_t n = HH::tel_emit(scene_name((Scene)s[0]), phase, s[2], s[3], s[4], s[5], s[6], s[7]);
+  memcpy(g_studio_last, s, sizeof(s));
+  g_key[TEL_STUDIO] = false;
+  g_frames[TEL_STUDIO]++;
+  g_bytes += n;
+  return true;
+}
+
+void telemetry_update() {
+  const uint32_t now = millis();
+  for (uint8_t c = 0; c < TEL_N; c++) {
+    if (!g_period[c] || (int32_t)(now - g_next[c]) < 0) continue;
+    // Never block loop() on a full TX buffer; the channel is retried next pass
+    if (Console.availableForWrite() < frame_max(c)) { g_skipped++; return; }
+    g_next[c] = now + g_period[c];
+    if (c == TEL_STUDIO) send_studio();
+    else                 send_channel(c, now);
+  }
+}
+
+static bool set_rate(const char* name, uint16_t hz) {
+  for (uint8_t c = 0; c < TEL_N; c++) {
+    if (strcasecmp_P(name, CH_NAMES[c]) != 0) continue;
+    g_period[c] = hz ? 1000 / (hz > MAX_HZ ? MAX_HZ : hz) : 0;
+    g_next[c]   = millis();
+    g_key[c]    = true;          // first frame after (re)subscribing carries every field
+    return true;
+  }
+  return false;
+}
+
+bool telemetry_subscribe(const String& spec) {
+  // Validate everything first so a typo does not leave a half-applied set
+  for (uint8_t pass = 0; pass < 2; pass++) {
+    int at = 0;
+    while (at < (int)spec.length()) {
+      int end = spec.indexOf(' ', at);
+      if (end < 0) end = spec.length();
+      const String tok = spec.substring(at, end);
+      at = end + 1;
+      if (tok.length() == 0) continue;
+
+      const int colon = tok.indexOf(':');
+      if (colon <= 0 || colon + 1 >= (int)tok.length() || !isDigit(tok[colon + 1])) return false;
+      const String name = tok.substring(0, colon);
+      const uint16_t hz = (uint16_t)tok.substring(colon + 1).toInt();
+      if (pass == 0) {
+        bool known = false;
+        for (uint8_t c = 0; c < TEL_N; c++) if (strcasecmp_P(name.c_str(), CH_NAMES[c]) == 0) known = true;
+        if (!known) return false;
+      } else {
+        set_rate(name.c_str(), hz);
+      }
+    }
+  }
+  return true;
+}
+
+void telemetry_off() {
+  memset(g_period, 0, sizeof(g_period));
+}
+
+void telemetry_print(Stream& s) {
+  s.println(F("=== Telemetry ==="));
+  for (uint8_t c = 0; c < TEL_N; c++) {
+    s.print(F("  ")); s.print(ch_name(c)); s.print(F("\t"));
+    if (g_period[c]) { s.print(1000 / g_period[c]); s.print(F(" Hz")); }
+    else             s.print(F("off"));
+    s.print(F("\tframes ")); s.println(g_frames[c]);
+  }
+  s.print(F("  bytes ")); s.print(g_bytes);
+  s.print(F("  deferred (TX full) ")); s.println(g_skipped);
+}
@@ -1,12 +1,21 @@
 // src/triggers.cpp
 #include <Arduino.h>
 #include "triggers.hpp"
+#include "pilink.hpp"
+#include "pins.hpp"
+#include "outputs.hpp"
+#include "uart.hpp"
 
 // Five trigger outputs (active HIGH to optos)
 // Wire these to Pi GPIOs with internal pullups enabled on the Pi.
-static const uint8_t PIN_TRIG[]  = {27, 22, 23, 24, 25};  // D27, D22, D23, D24, D25
-static const char*   NAME_TRIG[] = {"SHOW","BLOOD","GRAVE","FUR","FRANKEN"};
+static const uint8_t PIN_TRIG[]     PROGMEM = {PIN_TRIG_SHOW, PIN_TRIG_BLOOD, PIN_TRIG_GRAVE, PIN_TRIG_FUR, PIN_TRIG_FRANKEN};
+static const char    NAME_TRIG[][8] PROGMEM = {"SHOW","BLOOD","GRAVE","FUR","FRANKEN"};
 static const uint8_t N_TRIG = sizeof(PIN_TRIG) / sizeof(PIN_TRIG[0]);
+static_assert(N_TRIG == TRIGGERS_N, "trigger table size");
+
+static inline uint8_t trig_pin(uint8_t i) { return pgm_read_byte(&PIN_TRIG[i]); }
+
+static int8_t g_ch0 = -1;   // output channel of trigger 0, the rest follow in order
 
 // Simple lockout to avoid double-pulses
 static unsigned long last_fire_ms[5] = {0,0,0,0,0};
@@ -14,44 +23,49 @@ static const unsigned long MIN_LOCKOUT_MS = 300;
 
 void triggers_begin() {
   for (uint8_t i = 0; i < N_TRIG; ++i) {
-    pinMode(PIN_TRIG[i], OUTPUT);
-    digitalWrite(PIN_TRIG[i], LOW); // idle OFF
+    const int8_t ch = outputs_add(trig_pin(i), NAME_TRIG[i], true, true); // idle OFF, Timer5 edges
+    if (i == 0) g_ch0 = ch;
     last_fire_ms[i] = 0;
   }
 }
 
 bool triggers_pulse(uint8_t idx, uint16_t ms) {
-  if (idx >= N_TRIG) return false;
+  if (idx >= N_TRIG || g_ch0 < 0) return false;
   const unsigned long now = millis();
-  if (now - last_fire_ms[idx] < MIN_LOCKOUT_MS) return false;
+  if ((long)(now - last_fire_ms[idx]) < (long)MIN_LOCKOUT_MS) return false;  // negative while pulsing
 
-  digitalWrite(PIN_TRIG[idx], HIGH);
-  delay(ms);
-  digitalWrite(PIN_TRIG[idx], LOW);
+  // Framed cue first: acked by the Pi well before the opto pulse ends
+  pilink_cue(idx);
+  outputs_pulse(g_ch0 + idx, ms);   // ends in outputs_update(), loop() keeps running
 
-  last_fire_ms[idx] = millis();
+  last_fire_ms[idx] = now + ms;     // lockout counts from the end of the pulse
   return true;
 }
 
-static int name_to_index(const String& up) {
+const __FlashStringHelper* triggers_name(uint8_t idx) {
+  return reinterpret_cast<const __FlashStringHelper*>(NAME_TRIG[idx < N_TRIG ? idx : 0]);
+}
+
+int triggers_index(const String& up) {
   for (uint8_t i = 0; i < N_TRIG; ++i) {
-    if (up == NAME_TRIG[i]) return i;
+    if (strcmp_P(up.c_str(), NAME_TRIG[i]) == 0) return i;
   }
   return -1;
 }
 
 bool triggers_pulse_by_name(const String& upname) {
-  int idx = name_to_index(upname);
+  int idx = triggers_index(upname);
   if (idx < 0) return false;
   return triggers_pulse((uint8_t)idx, 100);
 }
 
 void triggers_print_map() {
-  Serial.println(F("=== GPIO Trigger Map (Mega -> Pi) ==="));
-  Serial.println(F("  D27 -> GPIO5  : Start_MainShow  (SHOW)"));
-  Serial.println(F("  D22 -> GPIO17 : Start_BloodRoom (BLOOD)"));
-  Serial.println(F("  D23 -> GPIO27 : Start_Graveyard (GRAVE)"));
-  Serial.println(F("  D24 -> GPIO22 : Start_FurRoom   (FUR)"));
-  Serial.println(F("  D25 -> GPIO23 : Start_Franken   (FRANKEN)"));
-  Serial.println(F("Pulse: 100 ms active, ~300 ms lockout. Pi should detect FALLING edge."));
+  Console.println(F("=== GPIO Trigger Map (Mega -> Pi) ==="));
+  Console.println(F("  D27 -> GPIO5  : Start_MainShow  (SHOW)"));
+  Console.println(F("  D22 -> GPIO17 : Start_BloodRoom (BLOOD)"));
+  Console.println(F("  D23 -> GPIO27 : Start_Graveyard (GRAVE)"));
+  Console.println(F("  D24 -> GPIO22 : Start_FurRoom   (FUR)"));
+  Console.println(F("  D25 -> GPIO23 : Start_Franken   (FRANKEN)"));
+  Console.println(F("Pulse: 100 ms active, ~300 ms lockout. Pi should detect FALLING edge."));
+  Console.println(F("Each pulse also sends PiLink CUE <idx> on Serial1 (SHOW=0 .. FRANKEN=4)."));
 }
\ No newline at end of file
@@ -0,0 +1,164 @@
+// src/uart.cpp
+#include <Arduino.h>
+#include "uart.hpp"
+#include "recovery.hpp"
+
+size_t uart_write_nb(HardwareSerial& port, const uint8_t* buf, size_t n) {
+  const int room = port.availableForWrite();
+  if (room <= 0) return 0;
+  if (n > (size_t)room) n = room;
+  return port.write(buf, n);
+}
+
+size_t uart_print_nb(HardwareSerial& port, const char* s) {
+  return uart_write_nb(port, (const uint8_t*)s, strlen(s));
+}
+
+// ---------------- Console rings ----------------
+// Filled and drained from loop() only, so no interrupt locking
+static uint8_t  g_tx[HH_CONSOLE_TX_RING];
+static uint16_t g_tx_head, g_tx_len;
+static uint8_t  g_rx[HH_CONSOLE_RX_RING];
+static uint16_t g_rx_head, g_rx_len;
+
+ConsolePort Console;
+
+static inline uint16_t wrap(uint16_t i, uint16_t size) { return i >= size ? i - size : i; }
+
+// Oldest queued byte into the core ring; waits for the ISR if that is full
+static void tx_pop() {
+  Serial.write(g_tx[g_tx_head]);
+  g_tx_head = wrap(g_tx_head + 1, HH_CONSOLE_TX_RING);
+  g_tx_len--;
+}
+
+void ConsolePort::pump() {
+  while (g_rx_len < HH_CONSOLE_RX_RING && Serial.available()) {
+    g_rx[wrap(g_rx_head + g_rx_len, HH_CONSOLE_RX_RING)] = (uint8_t)Serial.read();
+    g_rx_len++;
+  }
+  while (g_tx_len && Serial.availableForWrite() > 0) tx_pop();
+}
+
+int ConsolePort::available() { pump(); return g_rx_len; }
+
+int ConsolePort::peek() { pump(); return g_rx_len ? g_rx[g_rx_head] : -1; }
+
+int ConsolePort::read() {
+  pump();
+  if (!g_rx_len) return -1;
+  const uint8_t c = g_rx[g_rx_head];
+  g_rx_head = wrap(g_rx_head + 1, HH_CONSOLE_RX_RING);
+  g_rx_len--;
+  return c;
+}
+
+size_t ConsolePort::write(uint8_t b) {
+  pump();
+  if (!g_tx_len && Serial.availableForWrite() > 0) return Serial.write(b);
+  if (g_tx_len == HH_CONSOLE_TX_RING) tx_pop();   // both rings full: block like the core
+  g_tx[wrap(g_tx_head + g_tx_len, HH_CONSOLE_TX_RING)] = b;
+  g_tx_len++;
+  return 1;
+}
+
+int ConsolePort::availableForWrite() {
+  pump();
+  return (HH_CONSOLE_TX_RING - g_tx_len) + (g_tx_len ? 0 : Serial.availableForWrite());
+}
+
+void ConsolePort::flush() {
+  while (g_tx_len) { pump(); if (g_tx_len) tx_pop(); }
+  Serial.flush();
+}
+
+static uint32_t g_log_dropped;        // log lines dropped for want of TX room
+static uint32_t g_log_dropped_bytes;
+
+bool uart_log_nb(Print& port, const __FlashStringHelper* msg, const char* detail) {
+  PGM_P p = reinterpret_cast<PGM_P>(msg);
+  const size_t n_msg = p ? strlen_P(p) : 0;
+  const size_t n_det = detail ? strlen(detail) : 0;
+  const size_t n = n_msg + n_det + 2;
+  // Whole line or nothing: a torn line would run into the next one
+  if ((int)n > port.availableForWrite()) {
+    g_log_dropped++;
+    g_log_dropped_bytes += n;
+    return false;
+  }
+  uint8_t chunk[16];
+  for (size_t at = 0; at < n_msg; ) {
+    const size_t k = n_msg - at < sizeof chunk ? n_msg - at : sizeof chunk;
+    memcpy_P(chunk, p + at, k);
+    port.write(chunk, k);
+    at += k;
+  }
+  if (n_det) port.write((const uint8_t*)detail, n_det);
+  port.write((const uint8_t*)"\r\n", 2);
+  return true;
+}
+
+void uart_print(Stream& s) {
+  s.println(F("=== UART ==="));
+  s.print(F("  console baud ")); s.println(HH_CONSOLE_BAUD);
+  s.print(F("  core rings TX ")); s.print(SERIAL_TX_BUFFER_SIZE);
+  s.print(F("  RX ")); s.println(SERIAL_RX_BUFFER_SIZE);
+  s.print(F("  console rings TX ")); s.print(HH_CONSOLE_TX_RING);
+  s.print(F("  RX ")); s.println(HH_CONSOLE_RX_RING);
+  s.print(F("  console TX free ")); s.print(Console.availableForWrite());
+  s.print(F("  RX queued ")); s.println(Console.available());
+  s.print(F("  log lines dropped ")); s.print(g_log_dropped);
+  s.print(F(" (")); s.print(g_log_dropped_bytes); s.println(F(" B)"));
+  s.print(F("  Pi link TX free ")); s.print(Serial1.availableForWrite());
+  s.print(F("  RX queued ")); s.println(Serial1.available());
+}
+
+// Spin for us microseconds, topping up the console TX ring when fill is set.
+// Returns spin iterations; written gets the bytes handed to the ring.
+static uint32_t spin(uint32_t us, bool fill, uint32_t& written) {
+  static const char LINE[] = "................................................................\n";
+  static uint8_t at = 0;
+  uint32_t n = 0;
+  written = 0;
+  const uint32_t t0 = micros();
+  while (micros() - t0 < us) {
+    if (fill) {
+      const size_t k = uart_write_nb(Serial, (const uint8_t*)LINE + at, sizeof(LINE) - 1 - at);
+      at = (at + k) % (sizeof(LINE) - 1);
+      written += k;
+    } else {
+      uart_write_nb(Serial, (const uint8_t*)LINE, 0);   // same call, nothing queued
+    }
+    n++;
+  }
+  return n;
+}
+
+void uart_bench(uint16_t ms) {
+  if (ms > 500) ms = 500;                   // stays well inside the 1 s watchdog window
+  const uint32_t us = (uint32_t)ms * 1000UL;
+  uint32_t written;
+
+  Console.flush();
+  recovery_kick();
+  const uint32_t idle = spin(us, false, written);
+  recovery_kick();
+  const uint32_t busy = spin(us, true, written);
+  const uint32_t queued = (SERIAL_TX_BUFFER_SIZE - 1) - Serial.availableForWrite();
+  Serial.flush();
+  recovery_kick();
+
+  const uint32_t sent = written > queued ? written - queued : 0;
+  Console.println();
+  Console.println(F("=== UART bench ==="));
+  Console.print(F("  baud ")); Console.print(HH_CONSOLE_BAUD);
+  Console.print(F("  TX ring ")); Console.println(SERIAL_TX_BUFFER_SIZE);
+  Console.print(F("  sent ")); Console.print(sent);
+  Console.print(F(" B in ")); Console.print(ms);
+  Console.print(F(" ms = ")); Console.print(sent * 1000UL / ms);
+  Console.print(F(" B/s (line max ")); Console.print(HH_CONSOLE_BAUD / 10); Console.println(F(")"));
+  Console.print(F("  CPU in TX ISR + copies "));
+  Console.print(idle && busy < idle ? (idle - busy) * 100UL / idle : 0UL);
+  Console.print(F("%  (spin ")); Console.print(busy); Console.print(F(" vs idle ")); Console.print(idle);
+  Console.println(F(")"));
+}